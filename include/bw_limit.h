@@ -42,8 +42,8 @@ private:
 
 	// bool Bw_goal(double, double, dc_context_t *);
 #endif
-	double Get(std::string mode, std::string info);
-	void Set(std::string mode, std::string info, double value);
+	double Get(std::string mode, collect_field info);
+	void Set(std::string mode, collect_field info, double value);
 
 public:
 	Bw_limit();
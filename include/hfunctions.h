@@ -5,8 +5,12 @@
 #include <fstream>
 #include <limits>
 #include <math.h> 
+#include <stdint.h>
+#include <type_traits>
 #include "ioflags.h"
+#include "iogather.h"
 #include "iometrics.h"
+#include "iokernels.h"
 #ifdef OPENMP
 #include <omp.h>
 #endif
@@ -25,6 +29,7 @@
 namespace iohf{
 
 double Median(double [],int);
+void Percentiles(const double *, int, const double *, double *, int);
 double Arithmetic_Mean(double [],int);
 double Harmonic_Mean(double [],int);
 double Harmonic_Mean_Non_Zero(double [] ,int);
@@ -61,9 +66,12 @@ void Compute_Statistics(std::vector <double>,int );
 // function  for finding phases for the entire job
 // find overlap in phases between different ranks
 void Overlap(std::vector<std::vector<int>>&, std::vector<double> &, double*, double*, int*, int, int);
-// sorts array and returns sorted index array
+// sorts array and returns sorted index array (stable radix sort of the keys, parallel with OPENMP)
+uint64_t Sort_Key(double);
+void Radix_Sort(uint64_t *, int *, int);
 int* Sort_With_Index(double * , int ); 
-int *Sort_With_Index(collect*, int, std::string mode = "t_start");
+int *Sort_With_Index(collect*, int, collect_field mode = FIELD_T_START);
+int *Sort_With_Index(collect*, int, std::string);
 
 // add bandwidth where phases of different ranks (see Overlap) overlap
 double* Phase_Bandwidth(std::vector<std::vector<int>>&, double*);
@@ -71,12 +79,14 @@ double* Phase_Bandwidth(std::vector<std::vector<int>>&, double*);
 int Non_Empty(std::vector<std::vector<int>>&);
 
 int* N_Phase(std::vector<std::vector<int>>&);
+int* N_Phase(const std::vector<int>&);
 
 // find minimum distance between elements in vector
 double Sample_Time(double *, int );
 
 // debud functions
 void Overlap_Graph(std::vector<std::vector<int>>&, int);
+void Overlap_Graph(const std::vector<int>&, int);
 
 void Function_Debug(std::string);
 }
@@ -17,7 +17,7 @@ struct n_struct
 namespace ioanalysis
 {
 
-	collect *Gather_Collect(IOdata *, int *, int, int, MPI_Comm, bool finilize);
+	collect *Gather_Collect(IOdata *, int *, int, int, MPI_Comm);
 	n_struct *Gather_N_OP(n_struct, int, int, MPI_Comm);
 	void Sum_N(n_struct *, n_struct &, int, int);
 	int *Get_N_From_ALL_N(IOdata *, n_struct *, int, int);
@@ -32,9 +32,77 @@ class AsyncRequest{
 public:
 	AsyncRequest(MPI_Request* orig);
 	bool check_request(MPI_Request *request);
+	uint64_t Ptr_Key(void) const;
+	uint64_t Handle_Key(void) const;
+	static uint64_t Ptr_Key(MPI_Request *request);
+	static uint64_t Handle_Key(MPI_Request request);
 
 private:
     MPI_Request handle;     
     MPI_Request* ptr;  
 
+};
+
+/**
+ * @brief a single in-flight async request together with its start time, size and the
+ * required/actual query counters (1 = not yet queried, 0 = queried)
+ */
+struct async_entry
+{
+	double time;
+	long long size;
+	int queue_req;
+	int queue_act;
+	uint64_t key[2];  // 0: pointer key, 1: handle key (see AsyncRequest)
+	int next[2]; // next entry with the same key (0: pointer, 1: handle)
+	int prev[2]; // previous entry with the same key (0: pointer, 1: handle)
+
+	async_entry(uint64_t ptr_key, uint64_t handle_key, double t, long long b) : time(t), size(b), queue_req(1), queue_act(1), key{ptr_key, handle_key} {}
+};
+
+/**
+ * @brief bucket of the open-addressing index. \e head and \e tail point to the oldest and newest
+ * entry with the same key. An empty bucket has head = -1
+ */
+struct async_bucket
+{
+	uint64_t key;
+	int head;
+	int tail;
+};
+
+/**
+ * @class AsyncQueue
+ * @brief slot map of the in-flight async requests of one direction (write or read).
+ * @details entries are stored in a vector and reused through a free list, so \e Push and \e Retire are O(1).
+ * Two open-addressing tables (linear probing) index the entries by request pointer and by request handle.
+ * \e Find matches the pointer first and falls back to the handle, as \e AsyncRequest::check_request does.
+ * Entries with the same key are chained in insertion order, so the oldest match is always returned.
+ * The key overloads of \e Push and \e Find are used when replaying records of other threads (see IOthread).
+ */
+class AsyncQueue
+{
+public:
+	AsyncQueue(void);
+	void Push(MPI_Request *, double, long long);
+	void Push(uint64_t, uint64_t, double, long long);
+	async_entry *Find(MPI_Request *);
+	async_entry *Find(uint64_t, uint64_t);
+	void Retire(async_entry *);
+	bool Empty(void) const;
+	int Size(void) const;
+
+private:
+	std::vector<async_entry> slots;
+	std::vector<int> free_slots;
+	std::vector<async_bucket> index[2]; // 0: pointer, 1: handle
+	int used[2];
+	int live;
+
+	static uint64_t Hash(uint64_t);
+	size_t Probe(int, uint64_t) const;
+	void Link(int, uint64_t, int);
+	void Unlink(int, uint64_t, int);
+	void Erase_Bucket(int, size_t);
+	void Grow(int);
 };
\ No newline at end of file
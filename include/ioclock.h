@@ -0,0 +1,95 @@
+#include <atomic>
+#include <string>
+#include <limits>
+#include <stdint.h>
+#include <time.h>
+#include <mpi.h>
+#include "ioflags.h"
+
+#if CLOCK_SOURCE == 2 && !(defined(__x86_64__) || defined(__i386__))
+#undef CLOCK_SOURCE
+#define CLOCK_SOURCE 1
+#endif
+
+#if CLOCK_SOURCE == 2
+#include <x86intrin.h>
+#endif
+
+/**
+ *  clock used for tracing
+ * @file   ioclock.h
+ */
+
+/**
+ * @class IOclock
+ * @brief time source of the traced calls. Returns seconds on the scale of \e MPI_Wtime.
+ *
+ * @details
+ * Depending on \e CLOCK_SOURCE (see ioflags.h), a raw counter (CLOCK_MONOTONIC_RAW through the vDSO or the TSC)
+ * is read and converted linearly: t = t_ref + (raw - raw_ref) * scale.
+ * \e Calibrate maps the raw counter to \e MPI_Wtime. It is called at \e IOtrace::Init and at each
+ * \e IOtrace::Summary, where the mapping is continued and only the scale changes: it follows the rate of
+ * \e MPI_Wtime over the elapsed interval and slews the deviation (e.g., from NTP adjustments, which the raw counter
+ * does not follow) away over the next interval, by at most CLOCK_SLEW. \e Now therefore never jumps back, and
+ * timestamps relative to t_0 stay comparable across ranks as with \e MPI_Wtime.
+ * The reference is double buffered, so threads calling \e Now during a calibration read a consistent set.
+ *       \e Now        current time in seconds
+ *       \e Calibrate  (re)maps the raw counter to MPI_Wtime
+ *       \e Drift      deviation from MPI_Wtime found at the last calibration (slewed away afterwards)
+ *       \e Info       name of the used source
+ *       \e Offset     estimates the offset of the rank relative to rank 0 (ping-pong over the node leaders)
+ */
+class IOclock
+{
+public:
+	IOclock(void);
+	void Calibrate(void);
+	double Drift(void) const;
+	std::string Info(void) const;
+	double Offset(double, int, int, MPI_Comm, double &) const;
+
+	/**
+	 * @brief returns the current time in seconds (MPI_Wtime scale)
+	 */
+	inline double Now(void) const
+	{
+#if CLOCK_SOURCE == 0
+		return MPI_Wtime();
+#else
+		const clock_ref &r = ref[active.load(std::memory_order_acquire)];
+		return r.t + (double)(int64_t)(Raw() - r.raw) * r.scale;
+#endif
+	}
+
+private:
+	struct clock_ref
+	{
+		uint64_t raw; // raw counter at calibration
+		double t;	  // MPI_Wtime at calibration
+		double scale; // seconds per tick
+	};
+
+	clock_ref ref[2];
+	std::atomic<int> active;
+	bool calibrated;
+	double drift;
+	uint64_t raw_sync; // raw counter at the last calibration
+	double t_sync;	   // MPI_Wtime at the last calibration
+
+	/**
+	 * @brief reads the raw counter
+	 */
+	static inline uint64_t Raw(void)
+	{
+#if CLOCK_SOURCE == 2
+		return __rdtsc();
+#else
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+		return (uint64_t)ts.tv_sec * 1'000'000'000ULL + (uint64_t)ts.tv_nsec;
+#endif
+	}
+
+	static void Sample(uint64_t &, double &);
+	double Ping_Pong(double, MPI_Comm, double &) const;
+};
@@ -12,6 +12,22 @@
  */
 
 
+/**
+ * @brief fields of \e collect that can be selected. A field is mapped once to a pointer-to-member
+ * (\e collect::Member), so loops over many phases access it directly instead of comparing strings
+ */
+enum collect_field
+{
+    FIELD_T_START,
+    FIELD_T_END_ACT,
+    FIELD_T_END_REQ,
+    FIELD_T_SUM,
+    FIELD_T_AVR,
+    FIELD_B_SUM,
+    FIELD_B_AVR,
+    FIELD_NONE // unknown field
+};
+
 /**
  * @brief structured used to call all phase information of a rank
  * 
@@ -39,10 +55,38 @@ class collect{
     
 	
     collect(void);
+    double get(collect_field field) const { return (field == FIELD_NONE) ? 0 : this->*Member(field); }
+    void set(collect_field field, double value);
+
+    //? string API (compatibility): the name is mapped to the field with \e Field
     double get(std::string) const;
     void set(std::string mode, double value);
 
+    static double collect::*Member(collect_field);
+    static const char *Name(collect_field);
+    static collect_field Field(std::string);
+
 	#if FILE_FORMAT > 1
 		MSGPACK_DEFINE(data, t_start, t_end_act, t_end_req, T_sum, T_avr, B_sum, B_avr, n_op);
 	#endif
-};
\ No newline at end of file
+};
+
+/**
+ * @brief pointer-to-member of a field. Hoisted out of loops: data[i].*member
+ * @return NULL for FIELD_NONE (unknown name, see \e Field). Callers must check it, as \e get returns 0 then
+ */
+inline double collect::*collect::Member(collect_field field)
+{
+    static double collect::*const member[FIELD_NONE + 1] = {&collect::t_start, &collect::t_end_act, &collect::t_end_req,
+                                                            &collect::T_sum, &collect::T_avr, &collect::B_sum, &collect::B_avr, NULL};
+    return member[field];
+}
+
+/**
+ * @brief name of a field (inverse of \e Field)
+ */
+inline const char *collect::Name(collect_field field)
+{
+    static const char *const name[FIELD_NONE + 1] = {"t_start", "t_end_act", "t_end_req", "T_sum", "T_avr", "B_sum", "B_avr", "none"};
+    return name[field];
+}
@@ -0,0 +1,60 @@
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include "iocolumns_reader.h"
+
+/**
+ *  columnar binary trace format (writer)
+ * @file   iocolumns.h
+ * @brief  Contains the definition of the \e IOcolumns class, which writes the columnar binary files of FILE_FORMAT 1
+ * (see iocolumns_reader.h for the layout and the reader).
+ * @details Columns are collected first. Arrays are referenced, not copied, so they have to outlive \e Write. Columns
+ * that do not exist as an array (scalars, fields of the collect objects) are stored in buffers owned by the
+ * instance. \e Write then writes the header, the directory and all columns with a few writev calls.
+ * With \e Write_All, every rank contributes the values of the rank columns (\e Rank_Column) to one shared file
+ * with MPI-IO (see PARALLEL_OUTPUT in ioflags.h). The values of the ranks follow each other in rank order, and for
+ * every rank column an index column "<name>_per_rank" holds the number of values of each rank.
+ */
+
+#define IOCOLUMNS_CHUNK (1 << 30) // values per chunk of the datatype Write_All uses for columns above INT_MAX values
+
+/**
+ * @class IOcolumns
+ * @brief collects columns and writes them to a file
+ * @details
+ *       \e Add         adds an array or a scalar as a column
+ *       \e Column      allocates a column that is filled by the caller
+ *       \e Rank_Column allocates a column that is filled by every rank (only written by \e Write_All)
+ *       \e Write       writes the file
+ *       \e Write_All   writes the file collectively (rank 0 writes the header and the columns, all ranks the rank columns)
+ */
+class IOcolumns
+{
+public:
+	IOcolumns(void) {}
+	IOcolumns(const IOcolumns &) = delete;
+	IOcolumns &operator=(const IOcolumns &) = delete;
+	~IOcolumns();
+
+	template <class T>
+	void Add(const std::string &, const T *, uint64_t);
+	void Add(const std::string &name, double value) { *Column<double>(name, 1) = value; }
+	void Add(const std::string &name, long long value) { *Column<long long>(name, 1) = value; }
+	void Add(const std::string &name, int value) { *Column<int>(name, 1) = value; }
+
+	template <class T>
+	T *Column(const std::string &, uint64_t);
+	template <class T>
+	T *Rank_Column(const std::string &, uint64_t);
+
+	bool Write(const std::string &) const;
+	bool Write_All(const std::string &, MPI_Comm) const;
+	size_t Size(void) const { return entries.size(); }
+
+private:
+	std::vector<io_column_entry> entries;
+	std::vector<const void *> data;
+	std::vector<io_column_entry> rank_entries; // columns of \e Write_All with the values of this rank
+	std::vector<const void *> rank_data;
+	std::vector<void *> owned;
+};
@@ -0,0 +1,155 @@
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ *  columnar binary trace format (reader)
+ * @file   iocolumns_reader.h
+ * @brief  Contains the layout of the columnar binary files (FILE_FORMAT 1) and \e IOcolumns_reader, a header-only
+ * reader that maps a file into memory. The header has no dependency on MPI or the rest of TMIO, so analysis tools
+ * can include it on its own.
+ * @details A file consists of
+ *       1. io_columns_header  (32 bytes)
+ *       2. io_column_entry    (88 bytes) for each column: name, type, offset and number of values
+ *       3. the raw little-endian arrays of the columns, each starting at an offset aligned to 8 bytes
+ * Column names are "<mode>/<name>", e.g. "write_async_t/bandwidth/b_ind" or "io_time/delta_t_agg", and match the keys of the
+ * json output. Scalars are columns with a single value. A column is read in place with \e Column, without parsing.
+ */
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "the columnar format is little-endian");
+
+#define IO_COLUMNS_MAGIC "TMIOCOL" // 8 bytes including '\0'
+#define IO_COLUMNS_VERSION 1
+#define IO_COLUMNS_NAME 64 // maximal length of a column name including '\0'
+
+enum io_column_type : uint32_t
+{
+	IO_COLUMN_DOUBLE = 0,
+	IO_COLUMN_INT32 = 1,
+	IO_COLUMN_INT64 = 2
+};
+
+struct io_columns_header
+{
+	char magic[8];		// IO_COLUMNS_MAGIC
+	uint32_t version;	// IO_COLUMNS_VERSION
+	uint32_t n_columns; // number of entries in the column directory
+	uint64_t size;		// size of the file in bytes
+	uint64_t reserved;
+};
+
+struct io_column_entry
+{
+	char name[IO_COLUMNS_NAME];
+	uint32_t type;	 // io_column_type
+	uint32_t width;	 // bytes per value
+	uint64_t offset; // offset of the first value from the start of the file
+	uint64_t count;	 // number of values
+};
+
+static_assert(sizeof(io_columns_header) == 32 && sizeof(io_column_entry) == 88, "unexpected padding");
+
+/**
+ * @brief column type of a C++ type
+ */
+template <class T>
+constexpr uint32_t io_column_type_of(void)
+{
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8, "unsupported column type");
+	if constexpr (std::is_floating_point<T>::value)
+		return IO_COLUMN_DOUBLE;
+	else if constexpr (sizeof(T) == 4)
+		return IO_COLUMN_INT32;
+	else
+		return IO_COLUMN_INT64;
+}
+
+/**
+ * @class IOcolumns_reader
+ * @brief maps a columnar file read-only into memory
+ * @details
+ *       \e Is_Open     the file was mapped and its header and directory are valid
+ *       \e Find        entry of a column by name (NULL if missing)
+ *       \e Column      pointer to the values of a column (NULL if missing, of another type or of another width)
+ */
+class IOcolumns_reader
+{
+public:
+	IOcolumns_reader(const char *name) : base(NULL), length(0)
+	{
+		int fd = open(name, O_RDONLY);
+		if (fd < 0)
+			return;
+		struct stat st;
+		if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(io_columns_header))
+		{
+			length = st.st_size;
+			void *p = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+			base = (p == MAP_FAILED) ? NULL : (const char *)p;
+		}
+		close(fd);
+		if (base && !Valid())
+		{
+			munmap((void *)base, length);
+			base = NULL;
+		}
+	}
+
+	~IOcolumns_reader()
+	{
+		if (base)
+			munmap((void *)base, length);
+	}
+
+	IOcolumns_reader(const IOcolumns_reader &) = delete;
+	IOcolumns_reader &operator=(const IOcolumns_reader &) = delete;
+
+	bool Is_Open(void) const { return base != NULL; }
+	uint32_t Size(void) const { return base ? Header().n_columns : 0; }
+	const io_columns_header &Header(void) const { return *(const io_columns_header *)base; }
+	const io_column_entry &Entry(uint32_t i) const { return ((const io_column_entry *)(base + sizeof(io_columns_header)))[i]; }
+
+	const io_column_entry *Find(const char *name) const
+	{
+		for (uint32_t i = 0; i < Size(); i++)
+			if (strncmp(Entry(i).name, name, IO_COLUMNS_NAME) == 0)
+				return &Entry(i);
+		return NULL;
+	}
+
+	template <class T>
+	const T *Column(const char *name, uint64_t *count = NULL) const
+	{
+		const io_column_entry *e = Find(name);
+		if (e == NULL || e->type != io_column_type_of<T>() || e->width != sizeof(T))
+			return NULL;
+		if (count)
+			*count = e->count;
+		return (const T *)(base + e->offset);
+	}
+
+private:
+	// checks the header and that every column lies within the file
+	bool Valid(void) const
+	{
+		const io_columns_header &h = Header();
+		if (memcmp(h.magic, IO_COLUMNS_MAGIC, 8) != 0 || h.version != IO_COLUMNS_VERSION || h.size != length)
+			return false;
+		if (sizeof(io_columns_header) + (uint64_t)h.n_columns * sizeof(io_column_entry) > length)
+			return false;
+		for (uint32_t i = 0; i < h.n_columns; i++)
+		{
+			const io_column_entry &e = Entry(i);
+			if (e.name[IO_COLUMNS_NAME - 1] != '\0' || e.offset % 8 != 0 || e.width == 0 || e.offset > length || e.count > (length - e.offset) / e.width)
+				return false;
+		}
+		return true;
+	}
+
+	const char *base;
+	size_t length;
+};
@@ -0,0 +1,41 @@
+#include <mpi.h>
+#include <string>
+#include "ioflags.h"
+
+/**
+ *  runtime configuration
+ * @file   ioconfig.h
+ * @brief  Contains the settings that are read from TMIO_* environment variables at \e IOtrace::Init, so one build of
+ * libtmio.so serves jobs with different sample levels, output formats and recorders.
+ * @details The flags of ioflags.h are the defaults. A variable overrides its flag, e.g. TMIO_ALL_SAMPLES=2 or
+ * TMIO_SKETCH=0. The settings of rank 0 are broadcast, as the gathers of the summary depend on them. Recording
+ * features (samples, sketches, histograms, telemetry, online phase bandwidth, sync phases) are not checked per
+ * operation: \e IOdata picks a recorder and phase ends specialized for the enabled features once (see
+ * \e IOdata::Recorder), and \e IOtrace picks the overhead tracing of the traced calls at Init. The flags of the
+ * analysis and the output layout (DO_CALC, SHOW_AVR, SHOW_SUM, TEST, DFT, MEMORY_CAP) stay compile-time.
+ */
+
+struct io_config
+{
+	int all_samples;	 // TMIO_ALL_SAMPLES (ALL_SAMPLES): 0..5
+	int sketch;			 // TMIO_SKETCH (SKETCH): 0 or 1
+	int histogram;		 // TMIO_HISTOGRAM (HISTOGRAM): 0 or 1
+	int same_t_end;		 // TMIO_SAME_T_END (SAME_T_END): 0 or 1
+	int online;			 // TMIO_ONLINE (ONLINE): 0 or 1 (1 with MEMORY_CAP)
+	int sync_mode;		 // TMIO_SYNC_MODE (SYNC_MODE): 0 or 1
+	int overhead;		 // TMIO_OVERHEAD (OVERHEAD): 0 or 1
+	int file_format;	 // TMIO_FILE_FORMAT (FILE_FORMAT): 0, 1 or the compiled msgpack/ZMQ format
+	int parallel_output; // TMIO_PARALLEL_OUTPUT (PARALLEL_OUTPUT): 0 or 1
+	int delta_output;	 // TMIO_DELTA_OUTPUT (DELTA_OUTPUT): 0 or 1 (jsonl only)
+	int telemetry;		 // TMIO_TELEMETRY (TELEMETRY): 0 or 1
+	std::string telemetry_name;		// TMIO_TELEMETRY_NAME (TELEMETRY_NAME)
+	std::string publisher_endpoint; // TMIO_PUBLISHER_ENDPOINT (PUBLISHER_ENDPOINT)
+};
+
+namespace ioconfig
+{
+	void Load(MPI_Comm);
+	const io_config &Get(void);
+	bool Samples(void);
+	std::string Info(void);
+}
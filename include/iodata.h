@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "ioprint.h"
+#include "iotelemetry.h"
 
 /**
  *  IO trace class
@@ -31,36 +32,46 @@ public:
     //*******************************
     //* I/O information during phase
     //*******************************
-    std:: vector<double>    bandwidth_act;  // bandwidth of individual I/O operations  
-    std:: vector<double>    bandwidth_req;  // bandwidth of individual I/O operations  
-    std:: vector<double>    t_act_s;  // actual start time 
-    std:: vector<double>    t_act_e;  // actaul end time
-    std:: vector<double>    t_req_s;  // required start time (usually same as t_act_s)
-    std:: vector<double>    t_req_e;  // required end time
-    std:: vector<int>       phases;   // phase the current I/O operation belongs to
+    IOsamples samples_act;  // actual start/end time, bandwidth and phase of individual I/O operations
+    IOsamples samples_req;  // required start/end time, bandwidth and phase (required end usually same as actual end)
+    IOsketch  sketch_b;     // distribution of the required bandwidth (see SKETCH in ioflags.h)
+    IOsketch  sketch_t;     // distribution of the actual bandwidth (throughput)
+    IOsketch  sketch_l;     // distribution of the latency (actual duration)
+    IOhistogram hist;       // request size and latency histograms (see HISTOGRAM in ioflags.h)
     
     //*******************************
     //* Phase information 
     //*******************************   
     std:: vector<collect>   phase_data;
     collect tmp;
+    IOtelemetry *telemetry = NULL; // slot of the rank in the telemetry segment (TELEMETRY)
+
+    // records an I/O operation and returns its bandwidth (see Recorder)
+    typedef double (*io_recorder)(IOdata &, long long, double, double);
+    // computes the bandwidth of a phase when it ends (see Recorder)
+    typedef void (*io_phase_end)(collect &);
+    // records a sync I/O operation and starts or ends its phase (see Recorder)
+    typedef void (*io_sync_recorder)(IOdata &, long long, double, double, long long);
     
     //* Methods:
     //************
     IOdata();
     void Mode(int,bool,bool=true); // set if read or write and if actual or required
+    void Recorder(const io_config &); // select the recorders of the enabled features
     //? phase start
     void Phase_Start(bool, double,long long,long long );
     
     //? add I/O tracr or claer all I/O traces
-    void Add_Io(bool,long long,double,double);
+    double Add_Io(bool,long long,double,double);
     void Clear_IO(void);
+    void Swap_IO(IOdata &);
     
     //? for Async tracing 
     void Phase_End_Req(long long,double,double);
     void Phase_End_Act(long long,double,double,bool);
     
     //? for Sync tracing 
+    void Add_Sync(long long,double,double,long long);
     void Phase_End_Sync(double);
 
     //? statistics
@@ -83,4 +94,26 @@ private:
     long long count_opertaions(long long); //counts operation in a phase
     long long count_opertaions_agg(long long);  //counts all operations bellow input
     long long online_counter;
+    int telemetry_mode; // index in io_telemetry_modes
+    io_telemetry_phase Telemetry_Phase(void) const;
+
+    //? one recorder per combination of the runtime settings (no checks per operation). Selected by Mode
+    io_recorder record_act;
+    io_recorder record_req;
+    io_sync_recorder record_sync;
+    io_phase_end end_req;
+    io_phase_end end_act;
+    io_phase_end end_sync;
+    template <bool keep, bool sketch, bool histogram, bool live, bool online>
+    static double Record_Act(IOdata &, long long, double, double);
+    template <bool keep, bool sketch, bool same_end, bool live, bool online>
+    static double Record_Req(IOdata &, long long, double, double);
+    template <bool per_file>
+    static void Record_Sync(IOdata &, long long, double, double, long long);
+    template <bool online>
+    static void End_Req(collect &);
+    template <bool online>
+    static void End_Act(collect &);
+    template <bool online>
+    static void End_Sync(collect &);
 };
@@ -1,6 +1,9 @@
 #ifndef IOFLAGS 
 #define IOFLAGS
 
+// Flags marked with [TMIO_<flag>] are only the defaults of the library: they are overwritten at MPI_Init by the
+// environment variable of the same name, e.g. TMIO_ALL_SAMPLES=2 or TMIO_SKETCH=0 (see ioconfig.h). The other flags
+// require recompiling.
 
 
 //* DEBUG Flags
@@ -44,7 +47,7 @@
 #endif
 
 #ifndef ALL_SAMPLES 
-#define ALL_SAMPLES 5 // print samples (Phase bandwidth) to json file in ioprint.cxx
+#define ALL_SAMPLES 5 // [TMIO_ALL_SAMPLES] print samples (Phase bandwidth) to json file in ioprint.cxx
 // 0: skips printing
 // 1: prints all overlapping phase bandwidth/throughput across ranks (b_overlap_sum and b_overlap_avr)
 // 2: 1 + prints act/req time when overlapping phases change (added or remove from stack) (t_overlap)
@@ -58,13 +61,13 @@
 //* Calculation Flags
 //*******************************
 #ifndef ONLINE
-#define ONLINE 1 // in iodata.cxx and iotrace.cxx
+#define ONLINE 1 // [TMIO_ONLINE] in iodata.cxx and iotrace.cxx
 // 0: offline -> calculate phase bandwidth at end
 // 1: online  -> calculate phase bandwidth during runtime
 #endif
 
-#ifndef SAME_T_END // same end time for phase in iodata.cxx
-#define SAME_T_END 1
+#ifndef SAME_T_END
+#define SAME_T_END 1 // [TMIO_SAME_T_END] same end time for phase in iodata.cxx
 #endif
 
 #ifndef SKIP_LAST_WRITE
@@ -91,8 +94,12 @@
 #define SHOW_SUM 0 // shows sum calculated when grouping the throughput over all ranks: overlaping bandwidths of ranks
 #endif
 
+#ifndef PERCENTILES
+#define PERCENTILES 1 // rank metrics: 0: median only | 1: also the 90th and 99th percentile (same selection)
+#endif
+
 #ifndef SYNC_MODE // sets when the sync phase starts and ends for each rank
-#define SYNC_MODE 0
+#define SYNC_MODE 0 // [TMIO_SYNC_MODE]
 // 0: sync phase starts and ends for each sync IO opertation
 // 1: sync phase starts at first sync IO operation after the file is opened and ends when the file is closed
 #endif
@@ -102,7 +109,7 @@
 #endif
 
 #ifndef OVERHEAD
-#define OVERHEAD 1 // if set, overhead during the runtime of the application is additionally calculated to the overhead at the end of the application
+#define OVERHEAD 1 // [TMIO_OVERHEAD] if set, overhead during the runtime of the application is additionally calculated to the overhead at the end of the application
 #endif
 
 #if !defined(TEST) && !defined(BW_LIMIT) && !defined(CUSTOM_MPI)
@@ -113,6 +120,95 @@
 #define TEST 0
 #endif
 
+#ifndef MEMORY_CAP
+#define MEMORY_CAP 0 // per rank cap in bytes for the samples of individual I/O operations in iodata.cxx
+// 0: unlimited
+// >0: the samples of each mode (async/sync write/read) are limited to MEMORY_CAP/4 bytes. Once full, the oldest block of samples is
+//     recycled and counted as dropped (reported as dropped_samples). Phase data (collect) is always kept exactly
+#endif
+
+// MEMORY_CAP requires ONLINE 1, as the offline phase bandwidth needs all samples. ONLINE is only the default of
+// TMIO_ONLINE, so ioconfig::Load keeps it at 1 with MEMORY_CAP
+
+#ifndef SKETCH
+#define SKETCH 1 // [TMIO_SKETCH] quantile sketch (DDSketch) of the individual I/O operations in iosketch.cxx
+// 0: off
+// 1: every rank keeps a fixed size sketch of the bandwidth, throughput and latency of its I/O operations. The sketches
+//    are merged with MPI_Reduce and percentile tables are printed (b_ind_percentiles, latency_ind_percentiles)
+#endif
+
+#ifndef HISTOGRAM
+#define HISTOGRAM 1 // [TMIO_HISTOGRAM] log2 histograms of the request size and latency of the individual I/O operations in iohistogram.h
+// 0: off
+// 1: every mode (async/sync write/read) counts its actual I/O operations. The histograms are summed with MPI_Reduce
+//    and printed (size_histogram, latency_histogram)
+#endif
+
+#ifndef SKETCH_ALPHA
+#define SKETCH_ALPHA 0.01 // relative accuracy of the sketch percentiles
+#endif
+
+#ifndef SKETCH_MIN_LATENCY
+#define SKETCH_MIN_LATENCY 1e-9 // lower end of the latency sketch in s (bandwidth sketches start at 1 B/s)
+#endif
+
+#ifndef SKETCH_BINS
+#define SKETCH_BINS 2048 // buckets per sketch. With SKETCH_ALPHA 0.01, covers 17 orders of magnitude above the minimum
+#endif
+
+#ifndef CLOCK_SOURCE
+#define CLOCK_SOURCE 1 // time source of the traced calls in iotrace.cxx (see ioclock.h)
+// 0: MPI_Wtime
+// 1: clock_gettime(CLOCK_MONOTONIC_RAW) calibrated against MPI_Wtime
+// 2: TSC (rdtsc) calibrated against MPI_Wtime. Falls back to 1 on non x86 architectures
+#endif
+
+#ifndef CLOCK_SLEW
+#define CLOCK_SLEW 5e-4 // maximal relative rate change of the trace clock when it corrects its deviation from MPI_Wtime (see ioclock.h)
+#endif
+
+#ifndef CLOCK_SYNC
+#define CLOCK_SYNC 1 // aligns the timestamps of all ranks to rank 0 with a ping-pong offset estimation over IO_WORLD (see ioclock.cxx)
+// 0: no alignment (timestamps relative to the t_0 of each rank)
+// 1: offsets are estimated at MPI_Init
+// 2: 1 + offsets are re-estimated at each summary. The residual offset is added to the reported error
+#endif
+
+#ifndef GATHER_MODE
+#define GATHER_MODE 1 // how the Summary gathers the data of all ranks on rank 0 (see iogather.h)
+// 0: flat MPI_Gatherv over IO_WORLD
+// 1: the ranks of a node gather on their node leader first, the leaders then gather on rank 0
+#endif
+
+#ifndef THREAD_DRAIN
+#define THREAD_DRAIN 1024 // records a thread buffers with MPI_THREAD_MULTIPLE before it replays the buffers of all threads (see IOtrace::Record)
+#endif
+
+#ifndef ASYNC_FLUSH
+#define ASYNC_FLUSH 0 // how iotrace_summary() flushes the online data (see ioworker.h)
+// 0: the calling thread gathers, computes and writes the summary
+// 1: the calling thread only swaps the data into a second buffer. A background thread flushes it over a duplicated
+//    communicator (needs MPI_THREAD_MULTIPLE, which TMIO requests at MPI_Init). MPI_Finalize still flushes synchronously
+//    Note: MPI_Init_thread then requests MPI_THREAD_MULTIPLE and returns it in *provided, even if the application
+//    asked for less. With Open MPI 4.1, the ompio component can crash when the application waits on I/O requests
+//    while the flush thread tests its gather; use ROMIO instead (mpirun --mca io romio321)
+#endif
+
+#ifndef ASYNC_FLUSH_POLL
+#define ASYNC_FLUSH_POLL 50 // in us. Sleep between the tests of a non-blocking gather of the flush thread (ASYNC_FLUSH 1)
+#endif
+
+#ifndef TELEMETRY
+#define TELEMETRY 0 // [TMIO_TELEMETRY] live state of the ranks in a shared memory segment per node (see iotelemetry_reader.h)
+// 0: off
+// 1: every rank publishes its current phase, bytes, operations and last bandwidth/throughput in its slot of
+//    /dev/shm/<TELEMETRY_NAME> (seqlock, no MPI calls). Node-local monitors read it with IOtelemetry_reader
+#endif
+
+#ifndef TELEMETRY_NAME
+#define TELEMETRY_NAME "/tmio_telemetry.%u.%j" // [TMIO_TELEMETRY_NAME] name of the segment (shm_open). %u: user id, %j: job id of the batch system (see io_telemetry_name)
+#endif
+
 #ifndef DO_CALC
 #define DO_CALC 0 // if set the 0 overlapping calculation is performed, only the data is collected
 // DO_CALC is not supported in jsonl mode
@@ -186,13 +282,44 @@
 //* Output File     
 //*******************************
 #ifndef FILE_FORMAT
-#define FILE_FORMAT 0
+#define FILE_FORMAT 0 // [TMIO_FILE_FORMAT] 0 and 1 are always available, 2 and 3 only if compiled with them
 // 0 FILE_FORMAT "jsonl"
 // 1 FILE_FORMAT "binary" 
 // 2 FILE_FORMAT "msgpack" 
 // 3 FILE_FORMAT "zmq" 
 #endif
 
+// online output over ZMQ (FILE_FORMAT 3, see iopublisher.h):
+#ifndef PUBLISHER_ENDPOINT
+#define PUBLISHER_ENDPOINT "tcp://127.0.0.1:5555" // [TMIO_PUBLISHER_ENDPOINT] endpoint the summaries are pushed to (tcp://, ipc:// or inproc://)
+#endif
+
+#ifndef PUBLISHER_HWM
+#define PUBLISHER_HWM 100 // max. queued summaries. Further summaries are dropped instead of blocking the application
+#endif
+
+#ifndef PUBLISHER_LINGER
+#define PUBLISHER_LINGER 1000 // in ms. Time queued summaries are kept once the socket is closed
+#endif
+
+// output of the individual I/O operations (b_ind, t_ind_s, t_ind_e with ALL_SAMPLES > 4):
+#ifndef PARALLEL_OUTPUT
+#define PARALLEL_OUTPUT 0 // [TMIO_PARALLEL_OUTPUT] 0: gathered on rank 0 and written to the json/binary output | 1: every rank writes its own samples with MPI-IO into <procs>.samples_chunk_N (see IOcolumns::Write_All)
+#endif
+
+// online output (iotrace_summary) with FILE_FORMAT 0 (see iorunning.h):
+#ifndef DELTA_OUTPUT
+#define DELTA_OUTPUT 0 // [TMIO_DELTA_OUTPUT] 0: every flush writes the statistics of the interval to <procs>.jsonl | 1: every flush appends only the new phases and samples together with running metrics over all flushes to <procs>.delta.jsonl
+#endif
+
+// DELTA_OUTPUT requires FILE_FORMAT 0 (jsonl). Both are only the defaults of TMIO_DELTA_OUTPUT and TMIO_FILE_FORMAT,
+// so ioconfig::Load disables the delta output for other formats
+
+// size of the output buffer of the json/jsonl/binary writer (see iowriter.h):
+#ifndef WRITER_BUFFER
+#define WRITER_BUFFER 1048576 // in bytes. The buffer is flushed to the file once full
+#endif
+
 
 
 
@@ -201,6 +328,11 @@
 // openMP: 
 //#define OPENMP
 
+// vectorized statistics kernels (see iokernels.h):
+#ifndef SIMD
+#define SIMD 1 // 0: scalar kernels only | 1: AVX2 or AVX-512 kernels if supported by the CPU (selected at runtime)
+#endif
+
 //colors output: 
 #define COLOR_OUTPUT 
 
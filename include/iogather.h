@@ -0,0 +1,57 @@
+#include <mpi.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <mutex>
+#include "ioflags.h"
+
+/**
+ *  two-level gather
+ * @file   iogather.h
+ * @brief  Contains the definition of the \e IOgather class used by the Summary to gather data on rank 0.
+ * @details With GATHER_MODE 1 (see ioflags.h), the ranks of a node first gather their data on the node
+ * leader (MPI_Comm_split_type with MPI_COMM_TYPE_SHARED). The leaders then gather the node blocks on rank 0.
+ * Rank 0 thus receives one message per node instead of one per rank, and intermediate buffers only exist
+ * on the leaders. Data arrives at rank 0 in rank order, as with a flat MPI_Gatherv.
+ */
+
+/**
+ * @class IOgather
+ * @brief node-leader gather over a communicator
+ * @details
+ *       \e Get      returns the instance for a communicator (created collectively on first use)
+ *       \e Free     frees all instances and their communicators (at MPI_Finalize)
+ *       \e Gatherv  gathers \e n elements of every rank into the rank ordered array of rank 0
+ */
+class IOgather
+{
+public:
+	static IOgather &Get(MPI_Comm);
+	static void Free(void);
+
+	int Gatherv(const void *, int, MPI_Datatype, void *, const int *);
+	int Gatherv(const void *, int, MPI_Datatype, int, void *, const int *, MPI_Datatype);
+
+	int Nodes(void) const { return nodes; }
+
+private:
+	IOgather(MPI_Comm);
+	~IOgather(void);
+
+	static std::map<MPI_Comm, IOgather *> instances; // one instance per communicator (IO_WORLD, FLUSH_WORLD)
+	static std::mutex instances_lock;
+
+	MPI_Comm comm;		  // communicator the instance was built for
+	MPI_Comm node_comm;	  // ranks sharing a node
+	MPI_Comm leader_comm; // node leaders (MPI_COMM_NULL on other ranks)
+	int rank;
+	int processes;
+	int node_rank;
+	int node_procs;
+	int nodes; // number of nodes (only rank 0)
+
+	//? rank 0 only: ranks of each node in the order of the leader gather
+	int *node_size;	 // ranks per node
+	int *node_ranks; // rank in comm of each received block
+	bool in_order;	 // node blocks arrive in rank order (no reordering needed)
+};
@@ -0,0 +1,59 @@
+#include <mpi.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ioflags.h"
+
+/**
+ *  request size and latency histograms
+ * @file   iohistogram.h
+ * @brief  Contains the definition of the \e IOhistogram class, HDR-style log2 histograms of the request sizes
+ * and latencies of the individual I/O operations of a rank.
+ * @details Each power of two is split into 4 linear sub-buckets, so a bucket spans at most 25% of its lower
+ * bound. The bucket is found with a count of leading zeros and a shift, recording an operation costs two
+ * increments. Sizes are counted in bytes and latencies in ns. As the buckets are fixed, the histograms of
+ * all ranks are added with MPI_Reduce (MPI_SUM).
+ */
+
+#define IOHISTOGRAM_SUB_BITS 2 // 2^2 sub-buckets per power of two
+#define IOHISTOGRAM_BINS 256   // covers all 64 bit values
+
+/**
+ * @class IOhistogram
+ * @brief log2 histograms of the request size and latency
+ * @details
+ *       \e Add         counts an operation (hot path, inline)
+ *       \e Bucket      returns the bucket of a value. \e Lower: lower bound of a bucket
+ *       \e Reduce      adds the histograms of all ranks on rank 0
+ */
+class IOhistogram
+{
+public:
+	IOhistogram(void) { Clear(); }
+
+	inline void Add(long long bytes, double latency)
+	{
+		size[Bucket(bytes > 0 ? bytes : 0)]++;
+		this->latency[Bucket(latency > 0 ? (uint64_t)(latency * 1e9) : 0)]++;
+	}
+
+	void Clear(void)
+	{
+		memset(size, 0, sizeof(size));
+		memset(latency, 0, sizeof(latency));
+	}
+
+	static inline int Bucket(uint64_t v)
+	{
+		if (v < (1 << IOHISTOGRAM_SUB_BITS))
+			return (int)v;
+		int msb = 63 - __builtin_clzll(v);
+		return ((msb - IOHISTOGRAM_SUB_BITS + 1) << IOHISTOGRAM_SUB_BITS) + (int)((v >> (msb - IOHISTOGRAM_SUB_BITS)) & ((1 << IOHISTOGRAM_SUB_BITS) - 1));
+	}
+
+	static uint64_t Lower(int);
+	static void Reduce(const IOhistogram *const *, IOhistogram *const *, int, MPI_Comm);
+
+	long long size[IOHISTOGRAM_BINS];	 // request size in bytes
+	long long latency[IOHISTOGRAM_BINS]; // latency in ns
+};
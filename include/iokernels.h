@@ -0,0 +1,57 @@
+#include <math.h>
+#include <limits>
+#include "ioflags.h"
+
+/**
+ *  statistics kernels
+ * @file   iokernels.h
+ * @brief  Contains the fused reduction kernels used by the statistics functions in hfunctions.cxx and statistics.cxx.
+ * @details A single pass over a buffer computes all moments needed for the arithmetic, harmonic and weighted
+ * harmonic mean, the variance, the minimum and the maximum (\e io_moments). NaN values are masked instead of
+ * branched on. The kernel is selected once at runtime from the instruction sets of the CPU: AVX-512, AVX2 or
+ * a scalar fallback (see SIMD in ioflags.h). Vector kernels sum in several lanes, so results can differ from
+ * the scalar kernel in the last bits.
+ */
+
+/**
+ * @brief moments of a buffer (NaN values are skipped)
+ */
+struct io_moments
+{
+	long long n;	  // values that are not NaN
+	long long n_zero; // values equal to zero
+	double sum;		  // sum of x
+	double dev;		  // sum of (x - shift)
+	double dev2;	  // sum of (x - shift)^2
+	double inv;		  // sum of 1/x over x != 0
+	double w;		  // sum of the weights
+	double w_inv;	  // sum of w/x over x != 0
+	double min;		  // +inf without values
+	double max;		  // -inf without values
+};
+
+/**
+ * @brief kernels of an instruction set
+ */
+struct io_kernels
+{
+	const char *name;
+	void (*moments)(const double *, const double *, int, double, io_moments &);
+	double (*sum)(const double *, int);
+};
+
+namespace iokernels
+{
+	enum level
+	{
+		SCALAR,
+		AVX2,
+		AVX512
+	};
+
+	const io_kernels &Get(void);
+	const io_kernels *Get(level);
+
+	void Moments(const double *, const double *, int, double, io_moments &);
+	double Sum(const double *, int);
+}
@@ -13,6 +13,8 @@ struct core_rank_metrics
     double hmean = 0;
     double whmean = 0;
     double median = 0;
+    double p90 = 0; // 90th percentile (see PERCENTILES in ioflags.h)
+    double p99 = 0; // 99th percentile
     double max = 0;
     double min = 0;
 };
@@ -39,7 +41,7 @@ struct app_metrics
 /**
  * @brief all metrics releated to throughput|bandwidth are stored in this structure.
  * app_metric: contains the metrics at application level (max, heamn and agg_max). @see app_metrics
- * rank_metric: contains the metrics at rank level (amean, hmean, wmean, median, max and min). @see app_metrics
+ * rank_metric: contains the metrics at rank level (amean, hmean, wmean, median, p90, p99, max and min). @see app_metrics
  */
 struct iometrics{
     app_metrics app_metric;
@@ -1,5 +1,7 @@
 //#include "statistics.h"
-#include "iotime.h"
+#include "iorunning.h"
+#include "iowriter.h"
+#include "iopublisher.h"
 
 /**
  *  IO print functions
@@ -11,15 +13,21 @@
 namespace ioprint
 {
 
-    void Summary(int, statistics, statistics, statistics, statistics, iotime);
-    void Json(int,    statistics, statistics, statistics, statistics, iotime);
-    void Jsonl(int,    statistics, statistics, statistics, statistics, iotime);
-    void Binary(int,    statistics, statistics, statistics, statistics, iotime);
-    std::string Format_Json(statistics, std::string, bool req = false, bool jsonl = false);
+    void Summary(int, const statistics &, const statistics &, const statistics &, const statistics &, const iotime &);
+    void Json(int,    const statistics &, const statistics &, const statistics &, const statistics &, const iotime &);
+    void Jsonl(int,    const statistics &, const statistics &, const statistics &, const statistics &, const iotime &);
+    void Binary(int,    const statistics &, const statistics &, const statistics &, const statistics &, const iotime &, IOpublisher *publisher = NULL);
+    void Format_Json(IOwriter &, const statistics &, std::string, bool req = false, bool jsonl = false);
+    void Format_Columns(IOcolumns &, const statistics &, std::string, bool req = false);
+    void Format_Samples(IOcolumns &, const IOsamples &, std::string);
+    void Delta(int,    const statistics &, const statistics &, const statistics &, const statistics &, const iotime &, const IOrunning &);
+    void Format_Delta(IOwriter &, const statistics &, const IOrunning &, int);
     
     template <class T>
-    std::string Print_Series(T, int, double, int, std::string, std::string, bool);
+    void Print_Series(IOwriter &, T, int, double, int, const char *, const char *, bool);
 
-    std::string Print_Series(collect*, std::string, int, double, int, std::string, std::string, bool);
+    void Print_Series(IOwriter &, collect*, collect_field, int, double, int, const char *, const char *, bool);
+    void Print_Percentiles(IOwriter &, const IOsketch &, double, const char *, bool);
+    void Print_Histogram(IOwriter &, const long long *, double, const char *, bool);
     
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <string>
+#include "ioflags.h"
+#if FILE_FORMAT > 2
+#include <zmq.hpp>
+#include "msgpack.hpp"
+
+/**
+ *  ZMQ publisher
+ * @file   iopublisher.h
+ * @brief  Contains the definition of the \e IOpublisher class, which pushes the msgpack summaries of FILE_FORMAT 3.
+ * @details The context and the PUSH socket are created once and kept for the lifetime of \e IOtrace, so a flush
+ * only costs the send. The buffer of a summary is handed over to ZMQ without copying. Sends never block: once
+ * PUBLISHER_HWM messages are queued (e.g., no receiver is running), further summaries are dropped and counted.
+ */
+
+/**
+ * @class IOpublisher
+ * @brief persistent PUSH socket for the online output
+ * @details
+ *       \e Connect  creates the socket and connects it to an endpoint (tcp://, ipc:// or inproc://)
+ *       \e Send     sends a msgpack buffer without copying (connects to PUBLISHER_ENDPOINT on first use)
+ *       \e Close    closes the socket (queued messages are kept for at most PUBLISHER_LINGER ms)
+ *       \e Sent / \e Dropped  number of sent and dropped messages
+ *       \e Context  context of the socket (an inproc:// receiver has to use the same context)
+ */
+class IOpublisher
+{
+public:
+	IOpublisher(void) : context(1), sent(0), dropped(0), connected(false) {}
+	~IOpublisher() { Close(); }
+	IOpublisher(const IOpublisher &) = delete;
+	IOpublisher &operator=(const IOpublisher &) = delete;
+
+	bool Connect(const std::string &endpoint = PUBLISHER_ENDPOINT, int hwm = PUBLISHER_HWM);
+	bool Send(msgpack::sbuffer &);
+	void Close(void);
+
+	long long Sent(void) const { return sent; }
+	long long Dropped(void) const { return dropped; }
+	const std::string &Endpoint(void) const { return endpoint; }
+	zmq::context_t &Context(void) { return context; }
+
+private:
+	zmq::context_t context;
+	zmq::socket_t socket;
+	std::string endpoint;
+	long long sent;
+	long long dropped;
+	bool connected;
+};
+
+#else
+class IOpublisher; // only available with FILE_FORMAT 3
+#endif
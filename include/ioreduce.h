@@ -0,0 +1,40 @@
+#include <mpi.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <math.h>
+
+/**
+ *  distributed rank metrics
+ * @file   ioreduce.h
+ * @brief  Contains the functions used to compute the rank metrics across all ranks instead of on rank 0.
+ * @details Every rank summarizes its own phases in a \e rank_partial. The partials are combined with a
+ * custom MPI operation. Means, min, max and byte sums are all decomposable this way. Medians and percentiles
+ * are not, they are found with a distributed selection (\e Select) that only exchanges counts.
+ */
+
+/**
+ * @brief partial rank metrics of a single field (e.g., T_avr) over the phases of one or more ranks
+ */
+struct rank_partial
+{
+	double inv;		// sum of 1/x over x != 0 (harmonic mean)
+	double w_inv;	// sum of bytes/x over x != 0 (weighted harmonic mean)
+	double sum;		// sum of x (arithmetic mean)
+	double min;
+	double max;
+	double agg_max; // sum of the running maximum (see Compute_Rank_Metrics_Core)
+	long long bytes;
+	long long n; // number of values (NaN values are skipped)
+};
+
+namespace ioreduce
+{
+	void Init(rank_partial &);
+	void Add(rank_partial &, double, long long);
+	void Merge(rank_partial &, const rank_partial &);
+	int Allreduce(const rank_partial *, rank_partial *, int, MPI_Comm);
+	int Select(const std::vector<double> *, const int *, const long long *, double *, int, MPI_Comm);
+}
@@ -0,0 +1,57 @@
+#include "iotime.h"
+
+/**
+ *  running metrics of the online output
+ * @file   iorunning.h
+ * @brief  Contains the definition of the \e IOrunning class, which keeps the metrics over all flushes of the
+ * incremental online output (DELTA_OUTPUT 1).
+ * @details A flush only passes the phases and samples of its interval. The metrics over the whole run are kept in
+ * mergeable accumulators on rank 0: a \e rank_partial of the phase bandwidths (sums, extrema, bytes and counts, see
+ * ioreduce.h) and sketches of the phase and individual bandwidths (percentiles with a relative error of
+ * SKETCH_ALPHA, see iosketch.h). The request size and latency histograms of the actual modes are
+ * summed bucket by bucket (see iohistogram.h). Adding an interval costs the same no matter how many intervals came before.
+ */
+
+// modes of the online output, in the order of the jsonl lines (required: bandwidth, actual: throughput)
+#define IO_RUNNING_MODES 6
+static const char *const io_running_names[IO_RUNNING_MODES] = {"read_sync", "read_async_t", "read_async_b", "write_async_t", "write_async_b", "write_sync"};
+static const bool io_running_req[IO_RUNNING_MODES] = {false, false, true, false, true, false};
+
+/**
+ * @brief accumulators of a mode over all flushes
+ */
+struct io_running_mode
+{
+	rank_partial phases; // phase bandwidth (B_sum) or throughput (T_avr) of all ranks
+	IOsketch sketch;	 // distribution of the phase values
+	IOsketch sketch_ind; // distribution of the individual operations (SKETCH)
+	IOsketch sketch_l;	 // latency of the individual operations (SKETCH, actual modes)
+	IOhistogram hist;	 // request size and latency of the individual operations (HISTOGRAM, actual modes)
+	long long bytes;
+	long long ops;
+	long long n_phases;
+};
+
+/**
+ * @class IOrunning
+ * @brief running metrics of the delta output
+ * @details
+ *       \e Update   adds the phases of an interval (collective)
+ *       \e Metrics  mean, percentiles and extrema of a mode over all intervals
+ *       \e Chunk    number of intervals added so far
+ */
+class IOrunning
+{
+public:
+	IOrunning(void);
+
+	void Update(const std::vector<collect> *const *, const statistics *const *, int, MPI_Comm);
+	void Metrics(int, core_rank_metrics &) const;
+
+	const io_running_mode &Mode(int m) const { return mode[m]; }
+	int Chunk(void) const { return chunk; }
+
+private:
+	io_running_mode mode[IO_RUNNING_MODES];
+	int chunk;
+};
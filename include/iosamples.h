@@ -0,0 +1,85 @@
+#include <deque>
+#include <mpi.h>
+#include <stdlib.h>
+
+/**
+ *  per-operation samples
+ * @file   iosamples.h
+ * @brief  Contains the chunked structure-of-arrays arena that stores the individual I/O operations of an \e IOdata object.
+ * @details Samples are appended into fixed-size blocks. Inside a block, start time, end time, bandwidth and phase
+ * index are stored in separate contiguous arrays. A full block is never reallocated or copied, a new one is
+ * linked instead, so appending a sample takes the same time regardless of how many samples were recorded.
+ * With a cap (see MEMORY_CAP in ioflags.h), the oldest block is recycled once the cap is reached.
+ */
+
+#define IOSAMPLES_BLOCK 4096 // samples per block
+
+/**
+ * @brief a block of samples. The four arrays share a single allocation of \e IOsamples::block_n entries each
+ */
+struct io_sample_block
+{
+	double *t_s;   // start time
+	double *t_e;   // end time
+	double *b;	   // bandwidth (bytes / (t_e - t_s))
+	int *phase;	   // phase the operation belongs to (1 based, see IOdata::phase_data)
+	size_t n;	   // samples in the block
+};
+
+/**
+ * @brief field of a sample. Used to select the array that is gathered
+ */
+enum io_sample_field
+{
+	SAMPLE_T_S,
+	SAMPLE_T_E,
+	SAMPLE_B,
+	SAMPLE_PHASE
+};
+
+/**
+ * @class IOsamples
+ * @brief chunked SoA arena of individual I/O operations
+ * @details
+ *       \e Cap     limits the number of samples (0: unlimited)
+ *       \e Add     appends a sample
+ *       \e Swap    exchanges the samples with another arena (double buffering, see ASYNC_FLUSH)
+ *       \e Pack    copies a field of all samples into a contiguous array
+ *       \e Gather  gathers a field of all ranks on rank 0 directly from the blocks
+ *       \e Size    samples currently held. \e Dropped: samples recycled because of the cap
+ *
+ * blocks are iterated from the oldest to the newest with \e Blocks and \e Block
+ */
+class IOsamples
+{
+public:
+	IOsamples(void);
+	~IOsamples(void);
+	IOsamples(const IOsamples &) = delete;
+	IOsamples &operator=(const IOsamples &) = delete;
+
+	void Cap(size_t);
+	void Add(double, double, double, int);
+	void Clear(void);
+	void Swap(IOsamples &);
+	void Pack(io_sample_field, void *) const;
+	void Gather(io_sample_field, void *, int *, MPI_Comm) const;
+
+	size_t Size(void) const { return n_samples; }
+	long long Dropped(void) const { return dropped; }
+	size_t Blocks(void) const { return blocks.size(); }
+	const io_sample_block &Block(size_t i) const { return *blocks[i]; }
+
+	static size_t Sample_Size(void) { return 3 * sizeof(double) + sizeof(int); }
+
+private:
+	std::deque<io_sample_block *> blocks; // oldest block first
+	size_t block_n;						  // capacity of a block
+	size_t max_blocks;					  // blocks kept with a cap (0: unlimited)
+	size_t n_samples;
+	long long dropped;
+
+	io_sample_block *New_Block(void);
+	void Free_Block(io_sample_block *);
+	static const void *Field(const io_sample_block *, io_sample_field);
+};
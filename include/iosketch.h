@@ -0,0 +1,57 @@
+#include <mpi.h>
+#include <vector>
+#include <math.h>
+#include "ioflags.h"
+
+/**
+ *  mergeable quantile sketch
+ * @file   iosketch.h
+ * @brief  Contains the definition of the \e IOsketch class, a DDSketch of the individual I/O operations of a rank.
+ * @details A value x is counted in the bucket i = ceil(log_gamma(x / min)) with gamma = (1 + alpha) / (1 - alpha),
+ * so every bucket spans a fixed relative range and any percentile is returned with a relative error of at most
+ * alpha (SKETCH_ALPHA). The number of buckets is fixed (SKETCH_BINS): values below the minimum are counted in the
+ * first bucket and values above the range in the last one. As all ranks use the same buckets, sketches are
+ * merged by adding the counts, so the sketches of all ranks are combined with a single MPI_Reduce of
+ * O(SKETCH_BINS) values instead of gathering every sample.
+ */
+
+// percentiles printed for every sketch
+#define SKETCH_N_PERCENTILES 9
+static const double sketch_percentiles[SKETCH_N_PERCENTILES] = {0.01, 0.05, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999};
+static const char *const sketch_percentile_names[SKETCH_N_PERCENTILES] = {"p1", "p5", "p25", "p50", "p75", "p90", "p95", "p99", "p99.9"};
+
+/**
+ * @class IOsketch
+ * @brief DDSketch with a fixed number of buckets
+ * @details
+ *       \e Add         counts a value (NaN and infinite values are skipped)
+ *       \e Quantile    returns the q-quantile (0 <= q <= 1)
+ *       \e Merge       adds the counts of another sketch (e.g., of the next interval)
+ *       \e Reduce      merges the sketches of all ranks on rank 0
+ */
+class IOsketch
+{
+public:
+	IOsketch(double min_value = 1);
+
+	void Add(double);
+	void Clear(void);
+	double Quantile(double) const;
+	void Merge(const IOsketch &);
+
+	long long Count(void) const { return n; }
+	double Min(void) const { return min; }
+	double Max(void) const { return max; }
+	double Mean(void) const { return (n == 0) ? 0 : sum / n; }
+
+	static void Reduce(const IOsketch *const *, IOsketch *const *, int, MPI_Comm);
+
+private:
+	std::vector<long long> bins;
+	double min_value; // lower end of the first bucket
+	double log_gamma;
+	long long n;
+	double min;
+	double max;
+	double sum;
+};
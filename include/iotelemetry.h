@@ -0,0 +1,98 @@
+#include <math.h>
+#include <string>
+#include "iotelemetry_reader.h"
+
+/**
+ *  live telemetry segment (writer)
+ * @file   iotelemetry.h
+ * @brief  Contains the definition of the \e IOtelemetry class, which publishes the current phase state of a rank in
+ * the shared memory segment of its node (TELEMETRY, see iotelemetry_reader.h for the layout and the reader).
+ * @details The first local rank creates the segment with one slot per local rank, the others attach to it
+ * (see \e IOtrace::Init). Afterwards, every update only writes the own slot of the rank under its seqlock: no
+ * MPI call, no lock and no system call. The segment is removed by the first local rank at MPI_Finalize.
+ */
+
+/**
+ * @class IOtelemetry
+ * @brief writer of the slot of a rank
+ * @details
+ *       \e Create   creates the segment (first local rank)
+ *       \e Attach   maps the segment and claims a slot
+ *       \e Start    an operation starts (and possibly a phase)
+ *       \e Sample   bandwidth or throughput of an operation
+ *       \e Complete a phase ends and is added to the ring
+ */
+class IOtelemetry
+{
+public:
+	IOtelemetry(void) : slot(NULL), base(NULL), size(0), owner(false) {}
+	~IOtelemetry() { Close(); }
+	IOtelemetry(const IOtelemetry &) = delete;
+	IOtelemetry &operator=(const IOtelemetry &) = delete;
+
+	bool Create(const std::string &, int);
+	bool Attach(const std::string &, int, int, double);
+	void Close(void);
+	bool Active(void) const { return slot != NULL; }
+
+	inline void Start(int m, const io_telemetry_phase &p, long long bytes, bool new_phase, double time)
+	{
+		io_telemetry_mode &s = Begin(m, time);
+		s.phase = p;
+		s.bytes += bytes;
+		s.ops++;
+		if (new_phase)
+		{
+			s.phases++;
+			s.in_phase = 1;
+		}
+		End();
+	}
+
+	inline void Sample(int m, const io_telemetry_phase &p, double b, double t, double time)
+	{
+		io_telemetry_mode &s = Begin(m, time);
+		s.phase = p;
+		if (!isnan(b))
+			s.b_last = b;
+		if (!isnan(t))
+			s.t_last = t;
+		End();
+	}
+
+	inline void Complete(int m, const io_telemetry_phase &p, double time)
+	{
+		io_telemetry_mode &s = Begin(m, time);
+		s.phase = p;
+		s.in_phase = 0;
+		io_telemetry_entry &e = slot->ring[slot->state.head % IO_TELEMETRY_RING];
+		e.mode = m;
+		e.phase = p;
+		slot->state.head++;
+		End();
+	}
+
+private:
+	// seqlock of the single writer: odd while the slot is updated
+	inline io_telemetry_mode &Begin(int m, double time)
+	{
+		slot->seq.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot->state.t_update = time;
+		slot->state.updates++;
+		return slot->state.mode[m];
+	}
+
+	inline void End(void)
+	{
+		seq += 2;
+		slot->seq.store(seq, std::memory_order_release);
+	}
+
+	io_telemetry_slot *slot;
+	char *base;
+	size_t size;
+	uint64_t seq = 0;
+	bool owner; // created the segment (removes it on Close)
+	std::string name;
+};
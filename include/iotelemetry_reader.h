@@ -0,0 +1,258 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ *  live telemetry segment (reader)
+ * @file   iotelemetry_reader.h
+ * @brief  Contains the layout of the shared memory segment of TELEMETRY (/dev/shm/<name>, one per node) and
+ * \e IOtelemetry_reader, a header-only reader for node-local monitors. The header has no dependency on MPI or the
+ * rest of TMIO.
+ * @details The segment consists of an \e io_telemetry_header followed by one \e io_telemetry_slot per local rank.
+ * Each slot has a single writer (its rank) and is protected by a seqlock: the writer makes the sequence odd, updates
+ * the slot and makes it even again. A reader copies the slot and retries if the sequence was odd or changed
+ * meanwhile, so readers never block the writer and never see a torn state. Besides the current state of the
+ * four modes, a slot holds a ring of the last IO_TELEMETRY_RING completed phases, so a reader sampling slower than
+ * the phases end can still fetch all of them (\e Phases).
+ */
+
+#define IO_TELEMETRY_MAGIC "TMIOSHM" // 8 bytes including '\0'
+#define IO_TELEMETRY_VERSION 1
+#define IO_TELEMETRY_MODES 4 // async write, async read, sync write, sync read
+#define IO_TELEMETRY_RING 64 // completed phases kept per slot
+
+static const char *const io_telemetry_modes[IO_TELEMETRY_MODES] = {"write_async", "read_async", "write_sync", "read_sync"};
+
+/**
+ * @brief expands the name of a segment (TELEMETRY_NAME): %u is replaced by the user id and %j by the job id of the
+ * batch system (SLURM_JOB_ID, PBS_JOBID, LSB_JOBID or FLUX_JOB_ID, "0" outside a job), so jobs sharing a node
+ * get different segments. A monitor started in the job finds the segment with the same pattern
+ *
+ * @param pattern [in] name with placeholders, e.g. "/tmio_telemetry.%u.%j"
+ * @return std::string name for shm_open
+ */
+inline std::string io_telemetry_name(const char *pattern)
+{
+	const char *job = NULL;
+	for (const char *v : {"SLURM_JOB_ID", "PBS_JOBID", "LSB_JOBID", "FLUX_JOB_ID"})
+		if ((job = getenv(v)) != NULL && *job != '\0')
+			break;
+	std::string name;
+	for (const char *c = pattern; *c != '\0'; c++)
+	{
+		if (c[0] == '%' && c[1] == 'u')
+			name += std::to_string(getuid());
+		else if (c[0] == '%' && c[1] == 'j')
+			name += (job != NULL && *job != '\0') ? job : "0";
+		else
+		{
+			// only the leading '/' is allowed by shm_open
+			name += (*c == '/' && c != pattern) ? '_' : *c;
+			continue;
+		}
+		c++;
+	}
+	return name;
+}
+
+/**
+ * @brief a phase (the fields of collect). Times are in seconds since the start of the trace
+ */
+struct io_telemetry_phase
+{
+	double t_start;
+	double t_end_act;
+	double t_end_req;
+	double T_sum;
+	double T_avr;
+	double B_sum;
+	double B_avr;
+	long long data;
+	long long n_op;
+};
+
+/**
+ * @brief state of a mode (async/sync write/read) of a rank
+ */
+struct io_telemetry_mode
+{
+	io_telemetry_phase phase; // current phase, or the last one if in_phase is 0
+	long long phases;		  // phases since the start
+	long long bytes;		  // bytes since the start
+	long long ops;			  // operations since the start
+	double b_last;			  // bandwidth of the last operation (required, async only)
+	double t_last;			  // throughput of the last operation (actual)
+	int32_t in_phase;		  // 1 while a phase is active
+	int32_t reserved;
+};
+
+/**
+ * @brief state of a rank that is copied as a whole by \e IOtelemetry_reader::Read
+ */
+struct io_telemetry_state
+{
+	int32_t rank; // rank in MPI_COMM_WORLD (-1: slot not in use)
+	int32_t pid;
+	double t_epoch;	  // wall clock time (CLOCK_REALTIME) of the start of the trace
+	double t_update;  // trace time of the last update
+	uint64_t updates; // number of updates
+	uint64_t head;	  // number of completed phases written to the ring
+	io_telemetry_mode mode[IO_TELEMETRY_MODES];
+};
+
+/**
+ * @brief completed phase in the ring of a slot
+ */
+struct io_telemetry_entry
+{
+	int32_t mode; // index in io_telemetry_modes
+	int32_t reserved;
+	io_telemetry_phase phase;
+};
+
+struct alignas(64) io_telemetry_slot
+{
+	std::atomic<uint64_t> seq; // odd while the writer updates the slot
+	io_telemetry_state state;
+	io_telemetry_entry ring[IO_TELEMETRY_RING]; // entry i is at ring[i % IO_TELEMETRY_RING]
+};
+
+struct alignas(64) io_telemetry_header
+{
+	char magic[8];		// IO_TELEMETRY_MAGIC
+	uint32_t version;	// IO_TELEMETRY_VERSION
+	uint32_t n_slots;	// number of local ranks
+	uint64_t slot_size; // sizeof(io_telemetry_slot)
+	uint64_t size;		// size of the segment in bytes
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the seqlock needs a lock-free 64 bit atomic");
+
+/**
+ * @class IOtelemetry_reader
+ * @brief maps a telemetry segment read-only and copies consistent snapshots of the slots
+ * @details
+ *       \e Open    maps the segment (shm_open name, see \e io_telemetry_name) and checks the header
+ *       \e Read    copies the state of a slot
+ *       \e Phases  copies the completed phases of a slot that are newer than a position
+ *       \e Slots   number of slots (local ranks)
+ */
+class IOtelemetry_reader
+{
+public:
+	IOtelemetry_reader(void) : base(NULL), size(0) {}
+	IOtelemetry_reader(const char *name) : base(NULL), size(0) { Open(name); }
+	~IOtelemetry_reader() { Close(); }
+	IOtelemetry_reader(const IOtelemetry_reader &) = delete;
+	IOtelemetry_reader &operator=(const IOtelemetry_reader &) = delete;
+
+	bool Open(const char *name)
+	{
+		Close();
+		int fd = shm_open(name, O_RDONLY, 0);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(io_telemetry_header))
+		{
+			close(fd);
+			return false;
+		}
+		void *p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED)
+			return false;
+		base = (const char *)p;
+		size = st.st_size;
+
+		const io_telemetry_header *h = Header();
+		if (memcmp(h->magic, IO_TELEMETRY_MAGIC, 8) != 0 || h->version != IO_TELEMETRY_VERSION || h->slot_size != sizeof(io_telemetry_slot) ||
+			h->size > size || sizeof(io_telemetry_header) + h->n_slots * sizeof(io_telemetry_slot) > size)
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void Close(void)
+	{
+		if (base)
+			munmap((void *)base, size);
+		base = NULL;
+		size = 0;
+	}
+
+	bool Is_Open(void) const { return base != NULL; }
+	int Slots(void) const { return base ? (int)Header()->n_slots : 0; }
+
+	/**
+	 * @brief copies the state of a slot. Retries while the writer updates it
+	 *
+	 * @param i [in] slot (local rank)
+	 * @param out [out] state
+	 * @param tries [in] maximal number of attempts
+	 * @return true if a consistent state was copied
+	 */
+	bool Read(int i, io_telemetry_state &out, int tries = 1000) const
+	{
+		const io_telemetry_slot *s = Slot(i);
+		for (int k = 0; k < tries; k++)
+		{
+			uint64_t seq = s->seq.load(std::memory_order_acquire);
+			if (seq & 1)
+				continue;
+			memcpy(&out, (const void *)&s->state, sizeof(out));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (s->seq.load(std::memory_order_relaxed) == seq)
+				return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief copies the completed phases of a slot with a position of at least \e next. Phases that were already
+	 * overwritten in the ring are skipped (next jumps ahead)
+	 *
+	 * @param i [in] slot (local rank)
+	 * @param next [in,out] position of the next phase to read (0 at the start). Set to the position after the last copied phase
+	 * @param out [out] phases (at least IO_TELEMETRY_RING entries)
+	 * @param tries [in] maximal number of attempts
+	 * @return int number of copied phases (-1 if no consistent copy was possible)
+	 */
+	int Phases(int i, uint64_t &next, io_telemetry_entry *out, int tries = 1000) const
+	{
+		const io_telemetry_slot *s = Slot(i);
+		for (int k = 0; k < tries; k++)
+		{
+			uint64_t seq = s->seq.load(std::memory_order_acquire);
+			if (seq & 1)
+				continue;
+			uint64_t head = s->state.head;
+			uint64_t first = (head > IO_TELEMETRY_RING && next < head - IO_TELEMETRY_RING) ? head - IO_TELEMETRY_RING : next;
+			int n = (head > first) ? (int)(head - first) : 0;
+			for (int j = 0; j < n; j++)
+				memcpy(&out[j], (const void *)&s->ring[(first + j) % IO_TELEMETRY_RING], sizeof(io_telemetry_entry));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (s->seq.load(std::memory_order_relaxed) == seq)
+			{
+				next = first + n;
+				return n;
+			}
+		}
+		return -1;
+	}
+
+private:
+	const io_telemetry_header *Header(void) const { return (const io_telemetry_header *)base; }
+	const io_telemetry_slot *Slot(int i) const { return (const io_telemetry_slot *)(base + sizeof(io_telemetry_header)) + i; }
+
+	const char *base;
+	size_t size;
+};
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <math.h>
+#include <mpi.h>
+#include <stdint.h>
+
+/**
+ *  per-thread trace buffers
+ * @file   iothread.h
+ * @brief  Contains definitions of the per-thread recording buffers used with MPI_THREAD_MULTIPLE.
+ * @details Each application thread that calls a traced MPI function owns one \e IOthread. The thread
+ * appends \e io_record entries to its own chunk list (single producer), while \e IOtrace::Drain
+ * (single consumer, see \e IOtrace::Record) replays the records of all lists in time order into the \e IOdata
+ * objects. Pushing a record takes no lock. As a thread takes the time stamp of a call before it pushes the record, it
+ * publishes a low-watermark while the call is in flight, and the drain stops at the lowest one (see \e IOtrace::Drain).
+ */
+
+#define IOTHREAD_CHUNK 1024 // records per chunk
+
+/**
+ * @brief kind of a recorded call. Sync operations are recorded once at their end
+ */
+enum io_record_kind
+{
+	WRITE_ASYNC_START,
+	WRITE_ASYNC_REQUIRED,
+	WRITE_ASYNC_END,
+	WRITE_SYNC,
+	READ_ASYNC_START,
+	READ_ASYNC_REQUIRED,
+	READ_ASYNC_END,
+	READ_SYNC,
+	FILE_OPEN,
+	FILE_CLOSE
+};
+
+/**
+ * @brief a single traced call
+ *
+ * @param t time stamp of the call (start time for sync operations). Records are merged according to it
+ * @param t_end end time of sync operations
+ * @param size bytes of the operation (start and sync records)
+ * @param offset offset of the operation (start and sync records)
+ * @param ptr_key pointer key of the request (see AsyncRequest::Ptr_Key)
+ * @param handle_key handle key of the request (see AsyncRequest::Handle_Key)
+ * @param kind see \e io_record_kind
+ */
+struct io_record
+{
+	double t;
+	double t_end;
+	long long size;
+	MPI_Offset offset;
+	uint64_t ptr_key;
+	uint64_t handle_key;
+	int kind;
+};
+
+/**
+ * @brief fixed size block of records. \e n is the number of published records, \e next is set
+ * by the producer once the chunk is full
+ */
+struct io_chunk
+{
+	io_record records[IOTHREAD_CHUNK];
+	std::atomic<int> n;
+	std::atomic<io_chunk *> next;
+
+	io_chunk(void) : n(0), next(NULL) {}
+};
+
+/**
+ * @class IOthread
+ * @brief recording buffer of a single thread (SPSC chunk list) together with the thread local
+ * state of the sync calls and the overhead.
+ * @details
+ * producer (owning thread):
+ *       \e Enter         publishes the low-watermark of a traced call before its time stamp is taken
+ *       \e Stamp         raises the low-watermark to the time stamp of the call
+ *       \e Push          appends a record, publishes it with a release store and clears the low-watermark
+ *       \e Add_Overhead  accumulates the tracing overhead of the thread
+ *
+ * consumer (thread calling IOtrace::Drain):
+ *       \e Low           returns the low-watermark. No record below it can be published later
+ *       \e Peek          returns the oldest unread record or NULL
+ *       \e Pop           consumes the record returned by Peek. Fully consumed chunks are freed
+ *       \e Take_Overhead returns the overhead accumulated since the last call
+ */
+class IOthread
+{
+public:
+	IOthread(void);
+	~IOthread(void);
+
+	//? producer
+	bool Enter(void);
+	void Stamp(double);
+	void Push(const io_record &);
+	void Add_Overhead(double);
+
+	//? consumer
+	double Low(void) const { return low.load(std::memory_order_seq_cst); }
+	const io_record *Peek(void);
+	void Pop(void);
+	double Take_Overhead(void);
+
+	// sync calls in flight (set at Start, recorded at End)
+	double t_sync_write_start;
+	double t_sync_read_start;
+	long long size_sync_write;
+	long long size_sync_read;
+	MPI_Offset offset_sync_write;
+	MPI_Offset offset_sync_read;
+
+	double t_overhead;	 // start of the current traced call
+	int pending;		 // records pushed since the last drain attempt of the thread (see IOtrace::Record)
+	IOthread *next;		 // next registered thread (see IOtrace::Local)
+
+private:
+	std::atomic<double> low;		// low-watermark: bound of the next record while a call is in flight, else infinity
+	double t_last;					// time of the last pushed record (producer copy)
+	bool in_flight;					// a call holds the low-watermark (producer copy)
+	io_chunk *tail;					// chunk written by the producer
+	int tail_n;						// records in tail (producer copy)
+	io_chunk *head;					// chunk read by the consumer
+	int head_n;						// records consumed from head
+	std::atomic<double> overhead;	// written by the producer only
+	double overhead_taken;			// consumer copy of overhead at the last Take_Overhead
+};
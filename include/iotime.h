@@ -1,4 +1,5 @@
 #include "statistics.h"
+#include "iocolumns.h"
 
 /**
  * @class iotime
@@ -9,12 +10,13 @@ class iotime
 {
 
 public:
-	iotime(double*, double*, statistics, statistics, statistics, statistics);
+	iotime(double*, double*, const statistics &, const statistics &, const statistics &, const statistics &, double *t_clock = NULL);
 	iotime(void);
 	~iotime();
-	void print(std::ofstream &);
-	std::string Print_Json(bool jsonl = false);
-	const char *Color_Percent(double);
+	void print(std::ofstream &) const;
+	std::string Print_Json(bool jsonl = false) const;
+	void Columns(IOcolumns &) const;
+	const char *Color_Percent(double) const;
 
 #if FILE_FORMAT > 1
 MSGPACK_DEFINE(
@@ -36,7 +38,9 @@ MSGPACK_DEFINE(
 	delta_t_overhead,
 	delta_t_overhead_post_runtime,
 	delta_t_overhead_peri_runtime,
-	delta_t_overhead_dft);
+	delta_t_overhead_dft,
+	t_clock_offset,
+	t_clock_error);
 
 
 
@@ -69,5 +73,9 @@ private:
 	double delta_t_rank0_overhead_post_runtime; //deta_t_rank0_vec[2]
 	double delta_t_rank0_overhead_peri_runtime; // line_start,deta_t_rank0_vec[1]
 
+	// clock alignment (see CLOCK_SYNC)
+	double t_clock_offset; // max offset applied to the timestamps of a rank
+	double t_clock_error;  // max estimated error of the offsets
+
 	std::string name = "io_time";
 };
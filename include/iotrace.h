@@ -3,6 +3,9 @@
 #else
 #include "ioanalysis.h"
 #endif
+#include "iothread.h"
+#include "ioclock.h"
+#include "ioworker.h"
 
 /**
  *  IO trace class
@@ -19,6 +22,16 @@
 * \e IOtrace constructor. Initilizes all variables to 0
 * \e Init sets the attribute rank to the current MPI rank
 *
+* With MPI_THREAD_MULTIPLE, each thread records its calls into its own \e IOthread buffer
+* (see \e Local). Every THREAD_DRAIN records of a thread, and at each \e Summary, the buffers of all threads are
+* merged by time up to the lowest low-watermark of the calls in flight and replayed through \e Apply (see \e Stamp
+* and \e Drain). Otherwise, \e Apply is called directly from the
+* trace functions.
+*
+* \e Summary closes the interval and passes the data to \e Flush (gathers, statistics and output). With
+* ASYNC_FLUSH, the data of an online summary is swapped into a second set of \e IOdata objects and flushed
+* by a background thread (\e IOworker) on its own communicator, so the application continues right away.
+*
 * write async trace functions
 *       \e Write_Async_Start     sets variables at async write I/O call
 *       \e Write_Async_End       sets variables at end of async write I/O operation (@ wait or test)
@@ -35,11 +48,30 @@
 * \e Get_Relevant_Ranks: extract the ranks accesing a file pointer
 * ********************************************************
 */
+/**
+ * @brief state of an interval between two summaries as seen by the application thread. Passed to \e IOtrace::Flush,
+ * as the application continues to change the members of IOtrace while a background flush runs
+ */
+struct io_interval
+{
+	double t_app;		 // elapsed application time of the rank
+	double t_overhead;	 // tracing overhead during the interval
+	double t_request;	 // time the summary was requested
+	double t_blocked;	 // time the application waited for a background flush (< 0: flushed synchronously)
+	double clock_offset; // see IOtrace::clock_offset
+	double clock_error;
+	bool finalize;
+	bool online;
+
+	// overhead after the application time: the summary so far, or the hand over to the background flush
+	double Post(double now) const { return (t_blocked < 0) ? now - t_request : t_blocked; }
+};
+
 class IOtrace
 {
 public:
 	IOtrace();
-	void Init(void);
+	void Init(bool thread_multiple = false);
 	void Open(void);
 	void Summary(void);
 	void Close(void);
@@ -69,6 +101,12 @@ public:
 	//*************************************
 	void Set(std::string, bool);
 
+	//*************************************
+	//* Get Functions
+	//*************************************
+	void Count(std::string, long long &, long long &);
+	void Phases(std::string, std::vector<collect> &);
+
 	#if defined BW_LIMIT
 	void Apply_Limit(void);
 	#elif defined CUSTOM_MPI
@@ -79,43 +117,35 @@ private:
 	int rank;			 // current MPI rank
 	int processes;		 // number of ranks
 	double open;		 // flag indicating file status
-	int data_size_read;	 // store size of variable for read
-	int data_size_write; // store size of variable for write
 
 	double t_async_write_start; // time stamp for start of async write operation
-	double t_sync_write_start;	// time stamp for start of sync write operation
 	double t_async_read_start;	// time stamp for start of async read operation
-	double t_sync_read_start;	// time stamp for start of sync read operation
-	double t_sync_read_end;
-	double t_sync_write_end;
+	double t_sync_read_end;	// time stamp for end of the last sync read operation
+	double t_sync_write_end;	// time stamp for end of the last sync write operation
 
 	long long size_async_write; // size of async write operation in KB
-	long long size_sync_write;	// size of sync write operation in KB
 	long long size_async_read;	// size of async read operation in KB
-	long long size_sync_read;	// size of async read operation in KB
 
-	double t_0;				// start time (for each rank)
+	IOclock clock;			// time source of the traced calls
+	double t_0;				// start time (for each rank). Shifted by the clock offset to rank 0 (see CLOCK_SYNC)
+	double clock_offset = 0; // estimated offset of the relative time to rank 0
+	double clock_error = 0;	 // estimated error of clock_offset
 	double delta_t_app = 0; // elapsed time (for each rank)
-	double t_overhead = 0;
 	double delta_t_io_overhead = 0; // elapsed overhead during io tracing (for each rank)
 	double t_summary = 0;			// elapsed time (for each rank)
 
 	bool online_file_generation = false; // elapsed time (for each rank)
 	bool finalize = false;
+	bool thread_multiple = false;			  // MPI_THREAD_MULTIPLE: record into per thread buffers
+	std::atomic<IOthread *> threads{NULL}; // registered thread buffers (lock-free list)
+	IOthread single_thread;				   // state of the calls without MPI_THREAD_MULTIPLE
+	std::atomic<bool> draining{false};	   // set while the records are replayed or Summary uses the data
 
-	// ques for async tracing
-	std::vector<double> async_write_time;
-	std::vector<long long> async_write_size;
-	std::vector<int> async_write_queue_req;
-	std::vector<int> async_write_queue_act;
-	std::vector<AsyncRequest> async_write_requests;
-
-
-	std::vector<double> async_read_time;
-	std::vector<long long> async_read_size;
-	std::vector<int> async_read_queue_req;
-	std::vector<int> async_read_queue_act;
-	std::vector<AsyncRequest> async_read_requests;
+	// ques for async tracing (see AsyncQueue)
+	AsyncQueue async_write_queue;
+	AsyncQueue async_read_queue;
+	long long async_write_act_open = 0; // async write requests whose actual end was not queried yet
+	long long async_read_act_open = 0;  // async read requests whose actual end was not queried yet
 
 
 	IOdata aw, ar, sw, sr;
@@ -124,9 +154,17 @@ private:
 	IOdata *p_sw = &sw;
 	IOdata *p_sr = &sr;
 
+	// ASYNC_FLUSH: data of the previous interval, flushed by the worker while the application records into aw,...
+	IOdata back_aw, back_ar, back_sw, back_sr;
+	IOworker worker;
+	MPI_Comm FLUSH_WORLD; // communicator of Flush (duplicate of IO_WORLD with ASYNC_FLUSH, else IO_WORLD)
+
 #if defined BW_LIMIT || defined CUSTOM_MPI
 	Bw_limit bw_limit;
 #endif
+	IOpublisher *publisher = NULL; // persistent ZMQ socket of rank 0 (FILE_FORMAT 3)
+	IOrunning running; // metrics over all flushes of the incremental online output (DELTA_OUTPUT)
+	IOtelemetry telemetry; // slot of this rank in the shared memory segment of the node (TELEMETRY)
 
 		char caller[12] = "\tIOtrace";
 	MPI_Comm IO_WORLD;
@@ -134,16 +172,38 @@ private:
 	//*************************************
 	//* Request monitoring
 	//*************************************
-	bool Check_Request_Write(MPI_Request *, double *, long long *, int mode);
-	bool Check_Request_Read(MPI_Request *, double *, long long *, int mode);
+	bool Check_Request_Write(uint64_t, uint64_t, double *, long long *, int mode);
+	bool Check_Request_Read(uint64_t, uint64_t, double *, long long *, int mode);
 	bool Act_Done(int mode = 0);
 
+	//*************************************
+	//* Recording and replay
+	//*************************************
+	double Stamp(void);
+	void Record(const io_record &);
+	void Apply(const io_record &);
+	void Drain(void);
+	IOthread *Local(void);
+	void Free_Threads(void);
+
 	//*************************************
 	//* Overhead
 	//*************************************
 	double Overhead_Start(double);
 	void Overhead_End(void);
-	double *Overhead_Calculation(void);
+	double *Overhead_Calculation(const io_interval &);
+	// selected at Init (TMIO_OVERHEAD), no check per traced call
+	double (IOtrace::*overhead_start)(double) = &IOtrace::Overhead_Start_Traced<OVERHEAD == 1>;
+	void (IOtrace::*overhead_end)(void) = &IOtrace::Overhead_End_Traced<OVERHEAD == 1>;
+	template <bool on>
+	double Overhead_Start_Traced(double);
+	template <bool on>
+	void Overhead_End_Traced(void);
+
+	//*************************************
+	//* Summary
+	//*************************************
+	void Flush(IOdata *, IOdata *, IOdata *, IOdata *, const io_interval &);
 
 	//*************************************
 	//* Monitore ellapsed time
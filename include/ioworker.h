@@ -0,0 +1,47 @@
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/**
+ *  background worker
+ * @file   ioworker.h
+ * @brief  Contains the definition of the \e IOworker class, a single background thread that runs one job at a time.
+ * @details Used for the asynchronous online mode (see ASYNC_FLUSH in ioflags.h): \e IOtrace::Summary swaps the
+ * data of the interval into a second buffer and hands the flush (gathers, statistics and output) over to the
+ * worker. A new job waits until the previous one finished, as there is only one second buffer.
+ */
+
+/**
+ * @class IOworker
+ * @brief runs jobs one after the other on a background thread
+ * @details
+ *       \e Start   starts the thread
+ *       \e Run     waits for the previous job and hands over the next one
+ *       \e Wait    waits until the current job finished
+ *       \e Stop    waits for the current job and joins the thread
+ */
+class IOworker
+{
+public:
+	IOworker(void) : busy(false), stop(false) {}
+	~IOworker() { Stop(); }
+	IOworker(const IOworker &) = delete;
+	IOworker &operator=(const IOworker &) = delete;
+
+	void Start(void);
+	void Run(std::function<void(void)>);
+	void Wait(void);
+	void Stop(void);
+	bool Running(void) const { return thread.joinable(); }
+
+private:
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cv; // signals a new job, the end of a job and the stop
+	std::function<void(void)> job;
+	bool busy; // a job was handed over and did not finish yet
+	bool stop;
+
+	void Loop(void);
+};
@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "ioflags.h"
+
+/**
+ *  buffered output writer
+ * @file   iowriter.h
+ * @brief  Contains the definition of the \e IOwriter class used by ioprint to write the json, jsonl and binary files.
+ * @details Text is formatted straight into a buffer of WRITER_BUFFER bytes, which is written to the file in one
+ * block once it is full (or appended to a string). Numbers of the sample series are formatted with std::to_chars,
+ * i.e., with the shortest representation that reads back to the same double, instead of std::to_string.
+ */
+
+/**
+ * @class IOwriter
+ * @brief writes formatted text to a file or to a string
+ * @details
+ *       \e Append      copies text to the buffer
+ *       \e Format      printf style formatting into the buffer
+ *       \e Number      shortest round-trip representation of a double ("NaN" for NaN)
+ *       \e Flush       writes the buffer to the file (or string)
+ */
+class IOwriter
+{
+public:
+	IOwriter(const std::string &, bool append = false);
+	IOwriter(std::string *);
+	IOwriter(const IOwriter &) = delete;
+	IOwriter &operator=(const IOwriter &) = delete;
+	~IOwriter();
+
+	bool Is_Open(void) const { return file != NULL || str != NULL; }
+	void Append(const char *, size_t);
+	void Append(const char *s) { Append(s, strlen(s)); }
+	void Append(const std::string &s) { Append(s.data(), s.size()); }
+	void Format(const char *, ...) __attribute__((format(printf, 2, 3)));
+	void Number(double);
+	void Integer(long long);
+	void Flush(void);
+
+private:
+	void Reserve(size_t);
+
+	char *buffer;
+	size_t used;
+	size_t capacity;
+	FILE *file;
+	std::string *str;
+};
@@ -1,4 +1,10 @@
+#include <climits>
 #include "freq_analysis.h"
+#include "iosamples.h"
+#include "ioreduce.h"
+#include "iosketch.h"
+#include "iohistogram.h"
+#include "ioconfig.h"
 
 
 /**
@@ -8,10 +14,67 @@
  * @date   05.08.2021
  */
 
+/**
+ * @brief owning array allocated with malloc (as returned by the gather and iohf functions). Move-only and freed on
+ * destruction. Assigning a raw pointer adopts it, and the buffer converts to \e T* so it is used like the plain array
+ */
+template <class T>
+class io_buffer
+{
+public:
+    io_buffer(void) : p(NULL) {}
+    ~io_buffer(void) { free(p); }
+    io_buffer(const io_buffer &) = delete;
+    io_buffer &operator=(const io_buffer &) = delete;
+    io_buffer(io_buffer &&other) noexcept : p(other.p) { other.p = NULL; }
+    io_buffer &operator=(io_buffer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            free(p);
+            p = other.p;
+            other.p = NULL;
+        }
+        return *this;
+    }
+    io_buffer &operator=(T *q)
+    {
+        if (q != p)
+            free(p);
+        p = q;
+        return *this;
+    }
+    operator T *() const { return p; }
+    T *get(void) const { return p; }
+
+private:
+    T *p;
+};
+
+/**
+ * @brief overlapping phases of all ranks found by the sweep in \e statistics::Overlap. Instead of a copy of the
+ * overlapping phases after every start/end event, only the change (delta) of each event is stored. Any set of
+ * overlapping phases can be restored with \e Phases, and the sums over them are kept as running sums
+ * (see \e statistics::Phase_Bandwidth). Memory is O(events) instead of O(events x overlapping phases)
+ */
+#define IO_OVERLAP_NONE INT_MIN // event without a change (end of a phase that did not start)
+
+struct io_overlap
+{
+    std::vector<int> delta;   // phase that started (id) or ended (-id-1) at each event (or IO_OVERLAP_NONE)
+    std::vector<int> n;       // number of overlapping phases after each event
+    std::vector<double> time; // time of each event (only with ALL_SAMPLES > 2)
+
+    size_t Size(void) const { return n.size(); }
+    int Non_Empty(void) const;
+    std::vector<int> Phases(size_t) const;
+};
+
 /**
  * @brief class that captures statistics. Used to capture sync and async write/read. For async, bandwidth and throughput need an instance
  * 
  * @param req_or_act describes if the bandwidth (req) or the throughput (act) is captured by an instance of this calss
+ * @note the class owns all arrays it holds (including the collect and phase arrays passed to the constructor) and is move-only
  */
 class statistics{
     
@@ -25,31 +88,37 @@ class statistics{
     iometrics bandwidth;  // bandwidth metrics 
 
     //? data from phases (rank level)
-    collect* all_data;
+    io_buffer<collect> all_data;
 
     
 	//? Phase overlap (app level) (only if calc is on)
-    double* throughput_avr_phase; // throughput for every overlapping phase 
-    double* throughput_sum_phase;
-    double* bandwidth_avr_phase; // bandwidth for every overlapping phase 
-    double* bandwidth_sum_phase;
-    int*  phases_of_ranks; // vector containing number of phases each rank had
-    int*    n_overlap_act; // number overall overlap accros different phases
-    int*    n_overlap_req; // number overall overlap accros different phases
-    std::vector<std::vector<int>> phase_overlap_act; // stores the overlaping index 
-    std::vector<double> phase_time_act; //store the time intervals
-    std::vector<std::vector<int>> phase_overlap_req; // stores the overlaping index 
-    std::vector<double> phase_time_req; //store the time intervals
+    io_buffer<double> throughput_avr_phase; // throughput for every overlapping phase 
+    io_buffer<double> throughput_sum_phase;
+    io_buffer<double> bandwidth_avr_phase; // bandwidth for every overlapping phase 
+    io_buffer<double> bandwidth_sum_phase;
+    io_buffer<int>    phases_of_ranks; // vector containing number of phases each rank had
+    io_buffer<int>    n_overlap_act; // number overall overlap accros different phases
+    io_buffer<int>    n_overlap_req; // number overall overlap accros different phases
+    io_overlap overlap_act; // overlapping phases and time intervals (actual)
+    io_overlap overlap_req; // overlapping phases and time intervals (required)
     
 
 
     //? arrays for ind I/O data
-    double *all_b = NULL; // for individual bandwidth of every IO operation
-    double *all_t = NULL; // for individual throughput of every IO operation
-    double *all_t_act_s = NULL;
-    double *all_t_act_e = NULL;
-    double *all_t_req_s = NULL;
-    double *all_t_req_e = NULL;
+    io_buffer<double> all_b; // for individual bandwidth of every IO operation
+    io_buffer<double> all_t; // for individual throughput of every IO operation
+    io_buffer<double> all_t_act_s;
+    io_buffer<double> all_t_act_e;
+    io_buffer<double> all_t_req_s;
+    io_buffer<double> all_t_req_e;
+    long long agg_samples_act = 0; // number of gathered actual samples (all_t, all_t_act_s, all_t_act_e)
+    long long agg_samples_req = 0; // number of gathered required samples (all_b, all_t_req_s, all_t_req_e)
+    long long dropped_act = 0;     // actual samples dropped over all ranks (MEMORY_CAP)
+    long long dropped_req = 0;     // required samples dropped over all ranks (MEMORY_CAP)
+    IOsketch sketch_b; // bandwidth of the individual required I/O operations of all ranks (SKETCH)
+    IOsketch sketch_t; // throughput of the individual actual I/O operations of all ranks (SKETCH)
+    IOsketch sketch_l; // latency of the individual actual I/O operations of all ranks (SKETCH)
+    IOhistogram hist;  // request size and latency of the individual actual I/O operations of all ranks (HISTOGRAM)
 
 
 
@@ -73,6 +142,11 @@ class statistics{
     long long   max_bytes_phase; // max bytes transferred during a phase
     long long   agg_bytes;        // aggregated bytes over entire application       
 
+    //? time info (aggregated over all ranks)
+    double time_act;  // time from start to actual end of all phases
+    double time_req;  // time from start to required end of all phases
+    double time_lost; // waiting time (see Lost_Time)
+
     
 
     #if FILE_FORMAT > 1
@@ -84,25 +158,30 @@ class statistics{
     statistics();
     statistics(collect* ,int *, int, int, bool flag=false, bool flag2=false);
     ~statistics();
+    statistics(const statistics &) = delete;
+    statistics &operator=(const statistics &) = delete;
+    statistics(statistics &&) = default;
+    statistics &operator=(statistics &&) = default;
     
     //? Phase detection
     void Remove_Phase(int s = 0, int e = 0);
-    void Overlap(std::vector<std::vector<int>>& , std::vector<double>& , std::string mode);
-    double *Phase_Bandwidth(std::vector<std::vector<int>> &,std::string);
+    bool Skip_Phases(int, int, int) const;
+    void Overlap(io_overlap &, collect_field mode);
+    double *Phase_Bandwidth(const io_overlap &, collect_field);
     void Phase_Detection(void);
-    void Gather_Ind_Bandwidth(int, int, std::vector<double> ,std::vector<double>,std::vector<double> ,std::vector<double>,std::vector<double> ,std::vector<double> , MPI_Comm);
+    void Gather_Ind_Bandwidth(int, int, const IOsamples &, const IOsamples &, MPI_Comm);
+    void Reduce_Phase_Info(const std::vector<collect> &, int, MPI_Comm);
     
     //? compute metrics
     void Compute(void);
     void Compute_Metrics(void);
     void Compute_App_Metrics(void);
-    void Compute_Rank_Metrics(void);
-    void Compute_Rank_Metrics_Core(bool,bool);
-    void Clean(void);
+    void Compute_Rank_Metrics(const std::vector<collect> &, int, MPI_Comm);
+    void Set_Rank_Metrics(bool, bool, const rank_partial &, const double *);
 
     //? Time 
-    double Lost_Time();
-	double Total_Time(std::string mode="t_end_act");
+    double Lost_Time() const;
+	double Total_Time(std::string mode="t_end_act") const;
     
     
 };
@@ -11,6 +11,9 @@
 #include <fstream>
 #include <algorithm>
 #include <cstring>
+#ifdef OPENMP
+#include <omp.h>
+#endif
 #endif
 
 #ifdef SCOREP 
@@ -89,10 +89,10 @@ void Bw_limit::Reset(void)
  * @brief returns the I/O traces to extern libaries.
  *
  * @param mode either "aw", "sw", "ar" or "sr"
- * @param info info needs to be in the form of iocollect: "t_start", "t_end_act", "t_end_req", "T_sum", "T_avr", "B_sum", "B_avr"
+ * @param info field of iocollect (see collect_field)
  * @return double
  */
-double Bw_limit::Get(std::string mode, std::string info)
+double Bw_limit::Get(std::string mode, collect_field info)
 {
 
 	if (mode == "aw")
@@ -114,10 +114,10 @@ double Bw_limit::Get(std::string mode, std::string info)
  * @brief assigns the I/O traces by extern libaries.
  *
  * @param mode either "aw", "sw", "ar" or "sr"
- * @param info info needs to be in the form of iocollect: "t_start", "t_end_act", "t_end_req", "T_sum", "T_avr", "B_sum", "B_avr"
+ * @param info field of iocollect (see collect_field)
  * @param value value assigned to the variable
  */
-void Bw_limit::Set(std::string mode, std::string info, double value)
+void Bw_limit::Set(std::string mode, collect_field info, double value)
 {
 
 	if (mode == "aw")
@@ -203,12 +203,12 @@ void Bw_limit::Limit_Async(void)
 	{
 		// static int counter = 0;
 		// counter++;
-		// Set("aw", "B_sum",Get("aw", "B_sum")*1/counter);
-		double B = TOL * Get("aw", "B_sum");
+		// Set("aw", FIELD_B_SUM,Get("aw", FIELD_B_SUM)*1/counter);
+		double B = TOL * Get("aw", FIELD_B_SUM);
 		double T = ((double)EMPI_DATA_IWRITE) / ((double)EMPI_UTIME_IWRITE / 1'000'000);
 		// printf("asyn write: EMPI_UTIME_IWRITE: %ld, EMPI_DATA_IWRITE: %ld, \n", EMPI_UTIME_IWRITE, EMPI_DATA_IWRITE);
-		Set("aw", "T_avr", T);
-		Set("aw", "t_end_act", Get("aw", "t_start") + (double)EMPI_UTIME_IWRITE / 1'000'000);
+		Set("aw", FIELD_T_AVR, T);
+		Set("aw", FIELD_T_END_ACT, Get("aw", FIELD_T_START) + (double)EMPI_UTIME_IWRITE / 1'000'000);
 
 		bool change = false;
 
@@ -230,7 +230,7 @@ void Bw_limit::Limit_Async(void)
 		change = true;
 #endif
 
-		Set("aw", "B_avr", B);
+		Set("aw", FIELD_B_AVR, B);
 		EMPI_DESIRED_BW_IWRITE = B;
 #if BW_LIMIT_VERBOSE >= 1
 		double Tempi = ((double)EMPI_DATA_IWRITE) / ((double)EMPI_UTIME_IWRITE / 1'000'000);
@@ -279,12 +279,12 @@ void Bw_limit::Limit_Async(void)
 	if (p_ar->phase_data.size() > counter_iread)
 	{
 		// if (p_ar->phase_data.size() == 1)
-		double B = TOL * Get("ar", "B_sum");
-		// double T = Get("ar", "T_sum");
+		double B = TOL * Get("ar", FIELD_B_SUM);
+		// double T = Get("ar", FIELD_T_SUM);
 		double T = ((double)EMPI_DATA_IREAD) / ((double)EMPI_UTIME_IREAD / 1'000'000);
-		// Set("ar", "T_sum", T);
-		Set("ar", "T_avr", T);
-		Set("ar", "t_end_act", Get("ar", "t_start") + (double)EMPI_UTIME_IREAD / 1'000'000);
+		// Set("ar", FIELD_T_SUM, T);
+		Set("ar", FIELD_T_AVR, T);
+		Set("ar", FIELD_T_END_ACT, Get("ar", FIELD_T_START) + (double)EMPI_UTIME_IREAD / 1'000'000);
 
 		bool change = false;
 
@@ -303,7 +303,7 @@ void Bw_limit::Limit_Async(void)
 		change = true;
 #endif
 
-		Set("ar", "B_avr", B);
+		Set("ar", FIELD_B_AVR, B);
 		EMPI_DESIRED_BW_IREAD = B;
 #if BW_LIMIT_VERBOSE >= 1
 		double Tempi = ((double)EMPI_DATA_IREAD) / ((double)EMPI_UTIME_IREAD / 1000000);
@@ -380,8 +380,8 @@ void Bw_limit::Set_Throughput(void)
 	if (p_aw->phase_data.size() > counter_iwrite)
 	{
 		double T = ((double)EMPI_DATA_IWRITE) / ((double)EMPI_UTIME_IWRITE / 1'000'000);
-		Set("aw", "T_avr", T);
-		Set("aw", "t_end_act", Get("aw", "t_start") + (double)EMPI_UTIME_IWRITE / 1'000'000);
+		Set("aw", FIELD_T_AVR, T);
+		Set("aw", FIELD_T_END_ACT, Get("aw", FIELD_T_START) + (double)EMPI_UTIME_IWRITE / 1'000'000);
 
 #if BW_LIMIT_VERBOSE >= 1
 		printf("%s > rank %i / %i > %sasync write %s> T set to(%.2f) Mb/s %s\n", caller, rank, processes - 1, YELLOW, BLUE, T / 1'000'000, BLACK);
@@ -395,8 +395,8 @@ void Bw_limit::Set_Throughput(void)
 	if (p_ar->phase_data.size() > counter_iread)
 	{
 		double T = ((double)EMPI_DATA_IREAD) / ((double)EMPI_UTIME_IREAD / 1'000'000);
-		Set("ar", "T_avr", T);
-		Set("ar", "t_end_act", Get("ar", "t_start") + (double)EMPI_UTIME_IREAD / 1'000'000);
+		Set("ar", FIELD_T_AVR, T);
+		Set("ar", FIELD_T_END_ACT, Get("ar", FIELD_T_START) + (double)EMPI_UTIME_IREAD / 1'000'000);
 
 #if BW_LIMIT_VERBOSE >= 1
 		printf("%s > rank %i / %i > %sasync read %s> T set to(%.2f) Mb/s %s\n", caller, rank, processes - 1, YELLOW, BLUE, T / 1'000'000, BLACK);
@@ -6,133 +6,91 @@
 namespace iohf
 {
 
-	// Compute the Median
+	// Compute the Median (NaN values are ignored, -1 if there are no values)
 	double Median(double tmp[], int n)
 	{
+		double p = 0.5;
 		double median = -1;
-		if (n != 0)
-		{
-#if SKIP_LAST_WRITE > 0 || SKIP_FIRST_READ > 0 || SKIP_LAST_READ > 0 || SKIP_FIRST_WRITE > 0
-
-			double arr[n];
-			int N = 0;
-			for (const int i : tmp)
-				if (!isnan(i))
-					arr[N++] = i;
-
-			std::sort(arr, arr + N);
-
-#else
-			double arr[n];
-			std::copy(tmp, tmp + n, arr);
-			std::sort(arr, arr + n);
-#endif
-
-			if (n % 2 == 0) // even
-				//{
-				median = (arr[n / 2 - 1] + arr[n / 2]) / 2;
-			else
-				//{
-				median = arr[n / 2];
-		}
-
+		Percentiles(tmp, n, &p, &median, 1);
 		return median;
 	}
 
-	double Arithmetic_Mean(double tmp[], int n)
+	// Compute several percentiles in one pass over a single heap copy. Each percentile is found with
+	// nth_element on the part above the previous one (linear interpolation between the closest ranks,
+	// like the median for even n). NaN values are ignored. out is -1 if there are no values
+	void Percentiles(const double *tmp, int n, const double *p, double *out, int n_p)
 	{
+		std::vector<double> arr;
+		arr.reserve(n);
+		for (int i = 0; i < n; i++)
+			if (!isnan(tmp[i]))
+				arr.push_back(tmp[i]);
 
-		double mean = -1;
-		if (n != 0)
+		int N = arr.size();
+		int start = 0;
+		for (int j = 0; j < n_p; j++)
 		{
-			int N = 0;
-			mean = 0;
-			for (int i = 0; i < n; i++)
+			if (N == 0)
 			{
-				if (!isnan(tmp[i]))
-				{
-					mean += tmp[i];
-					N++;
-				}
+				out[j] = -1;
+				continue;
 			}
-
-			mean = mean / N;
+			double pos = p[j] * (N - 1);
+			int lo = (int)pos;
+			if (lo < start) // p is not ascending
+				start = 0;
+			std::nth_element(arr.begin() + start, arr.begin() + lo, arr.end());
+			out[j] = arr[lo];
+			if (pos > lo && lo + 1 < N)
+				out[j] += (pos - lo) * (*std::min_element(arr.begin() + lo + 1, arr.end()) - arr[lo]);
+			start = lo;
 		}
+	}
+
+	//? the means, Min, Max, Variance and Sum below are computed with the fused kernels of iokernels.h
+	double Arithmetic_Mean(double tmp[], int n)
+	{
+		if (n == 0)
+			return -1;
 
-		return mean;
+		io_moments m;
+		iokernels::Moments(tmp, NULL, n, 0, m);
+		return m.sum / m.n;
 	}
 
-	// Compute the Harmonic mean
+	// Compute the Harmonic mean (0 if a value is zero)
 	double Harmonic_Mean(double tmp[], int n)
 	{
+		if (n == 0)
+			return -1;
 
-		double hmean = -1;
-		if (n != 0)
-		{
-			hmean = 0;
-			int N = 0;
-			for (int i = 0; i < n; i++)
-			{
-				if (!isnan(tmp[i]))
-				{
-					hmean += 1 / tmp[i];
-					N++;
-					// std::cout << 1 << "/" << tmp[i] << " + ";
-				}
-			}
-			hmean = N / hmean;
-			// std::cout << "\nhmean is = " << N << "/" << hmean << "\n";
-		}
-		return hmean;
+		io_moments m;
+		iokernels::Moments(tmp, NULL, n, 0, m);
+		return (m.n_zero > 0) ? 0 : m.n / m.inv;
 	}
 
 	// Compute the Harmonic mean
 	double Harmonic_Mean_Non_Zero(double tmp[], int n)
 	{
+		if (n == 0)
+			return 0;
 
-		double hmean = 0;
-		if (n != 0)
-		{
-			hmean = 0;
-			int N = 0;
-			for (int i = 0; i < n; i++)
-			{
-				if (!isnan(tmp[i]) && tmp[i] != 0)
-				{
-					hmean += 1 / tmp[i];
-					N++;
-				}
-			}
-			hmean = N / hmean;
-		}
-		return hmean;
+		io_moments m;
+		iokernels::Moments(tmp, NULL, n, 0, m);
+		return (m.n - m.n_zero) / m.inv;
 	}
 
 	double Weighted_Harmonic_Mean(long long *b, double *tmp, int n)
 	{
+		if (n == 0)
+			return -1;
 
-		double wmean = -1;
-		if (n != 0)
-		{
-			wmean = 0;
-			long long sum_b = 0;
-			for (int i = 0; i < n; i++)
-			{
-				if (!isnan(tmp[i]))
-				{
-					wmean += b[i] / tmp[i];
-					sum_b += b[i];
-					// std::cout << b[i] << "/" << tmp[i] << " + ";
-					// std::cout << "\nwmean is = " << wmean << "   sum_b = " << sum_b <<"\n";
-				}
-			}
-			wmean = sum_b / wmean;
-			// std::cout << "\nwmean is = " << sum_b << "/" << wmean << "\n";
-		}
-		return wmean;
+		std::vector<double> w(b, b + n);
+		io_moments m;
+		iokernels::Moments(tmp, w.data(), n, 0, m);
+		return (m.n_zero > 0) ? 0 : m.w / m.w_inv;
 	}
 
-	// Compute the Minimum
 	double Min(double tmp[], int n, int *ptr)
 	{
 		int index = -1;
@@ -140,6 +98,12 @@ namespace iohf
 		if (n != 0)
 		{
 			min = std::numeric_limits<double>::max();
+			if (ptr == NULL)
+			{
+				io_moments m;
+				iokernels::Moments(tmp, NULL, n, 0, m);
+				return (m.min < min) ? m.min : min;
+			}
 			for (int i = 0; i < n; i++)
 			{
 				if (!isnan(tmp[i]) && min > tmp[i])
@@ -162,6 +126,12 @@ namespace iohf
 
 		if (tmp != NULL)
 		{
+			if constexpr (std::is_same<T, double>::value)
+			{
+				io_moments m;
+				iokernels::Moments(tmp, NULL, n, 0, m);
+				return (m.max > max) ? m.max : max;
+			}
 			for (int i = 0; i < n; i++)
 			{
 				if (!isnan(tmp[i]) && max < tmp[i])
@@ -174,24 +144,25 @@ namespace iohf
 	template long Max<long>(long *tmp, int n);
 	template int Max<int>(int *tmp, int n);
 
-	//! compute the varriance of a array
+	//! compute the varriance of a array (sum over the non NaN values divided by n)
 	double Variance(double tmp[], int n, double mean)
 	{
-		double var = -1;
-		if (n != 0)
-		{
-			var = 0;
-			if (isnan(mean))
-				mean = Arithmetic_Mean(tmp, n);
-			for (int i = 0; i < n; i++)
-			{
-				if (!isnan(tmp[i]))
-					var += pow(tmp[i] - mean, 2);
-			}
-			var = var / n;
-		}
-
-		return var;
+		if (n == 0)
+			return -1;
+
+		// shift by the mean (if known) or by the first value, then one pass is numerically safe
+		double shift = mean;
+		for (int i = 0; i < n && isnan(shift); i++)
+			shift = tmp[i];
+		if (isnan(shift))
+			return 0;
+
+		io_moments m;
+		iokernels::Moments(tmp, NULL, n, shift, m);
+		if (isnan(mean))
+			return (m.dev2 - m.dev * m.dev / m.n) / n;
+		double d = mean - shift;
+		return (m.dev2 - 2 * d * m.dev + m.n * d * d) / n;
 	}
 
 	double Standard_Deviation(double tmp[], int n, double mean)
@@ -207,6 +178,8 @@ namespace iohf
 		// computes sum
 		if (a != NULL)
 		{
+			if constexpr (std::is_same<T, double>::value)
+				return iokernels::Sum(a, n);
 			for (int i = 0; i < n; i++)
 				sum += a[i];
 		}
@@ -295,32 +268,8 @@ namespace iohf
 	void Gather_Summary(int n, int processes, int rank, T *buff_all_values, std::vector<T> my_vector, int *arr_all_n, MPI_Comm IO_WORLD, MPI_Datatype type)
 	{
 
-		// buffer to store all values
-		int displacment[processes];
-
-		if (rank == 0)
-		{
-			displacment[0] = 0;
-			for (int i = 1; i < processes; i++)
-			displacment[i] = displacment[i - 1] + arr_all_n[i - 1];
-		}
-		
-		#if HDEBUG >= 1
-		if (rank == 0)
-		{
-		std::cout << "Rank " << rank << " calling MPI_Gatherv with n=" << n << std::endl;
-				std::cout << "arr_all_n: ";
-				for (int i = 0; i < processes; i++) std::cout << arr_all_n[i] << " ";
-				std::cout << "\ndisplacement: ";
-				for (int i = 0; i < processes; i++) std::cout << displacment[i] << " ";
-				std::cout << std::endl;
-			}
-		else{
-			std::cout << "Rank " << rank << " calling MPI_Gatherv with n=" << n << std::endl;
-		}
-		#endif
-
-		MPI_Gatherv(my_vector.data(), n, type, buff_all_values, arr_all_n, displacment, type, 0, IO_WORLD);
+		// two-level or flat gather (see GATHER_MODE)
+		IOgather::Get(IO_WORLD).Gatherv(my_vector.data(), n, type, buff_all_values, arr_all_n);
 	}
 	template void Gather_Summary<int>(int, int, int, int *, std::vector<int>, int *, MPI_Comm, MPI_Datatype);
 	template void Gather_Summary<long long>(int, int, int, long long *, std::vector<long long>, int *, MPI_Comm, MPI_Datatype);
@@ -368,35 +317,168 @@ namespace iohf
 		}
 	}
 
-	// sorts array and returns index
+	// maps a double to an unsigned integer with the same order (-0 and +0 are equal)
+	uint64_t Sort_Key(double x)
+	{
+		if (x == 0)
+			x = 0;
+		uint64_t u;
+		memcpy(&u, &x, sizeof(u));
+		return (u >> 63) ? ~u : u | (1ULL << 63);
+	}
+
+	// stable LSD radix sort of (key, index) pairs, one byte per pass. Passes where all keys share the
+	// byte are skipped. With OPENMP, each pass is split into contiguous blocks (one per thread) that are
+	// counted and scattered in parallel, which keeps the sort stable
+	void Radix_Sort(uint64_t *key, int *id, int N)
+	{
+		const int radix = 256;
+#ifdef OPENMP
+		int blocks = omp_get_max_threads();
+#else
+		int blocks = 1;
+#endif
+		if (blocks > N / 1024)
+			blocks = (N / 1024 > 0) ? N / 1024 : 1;
+
+		uint64_t *key_src = key;
+		int *id_src = id;
+		uint64_t *key_dst = (uint64_t *)malloc(sizeof(uint64_t) * N);
+		int *id_dst = (int *)malloc(sizeof(int) * N);
+		long long *count = (long long *)malloc(sizeof(long long) * radix * blocks);
+
+		for (int shift = 0; shift < 64; shift += 8)
+		{
+			//? (1) count the digits of every block
+#ifdef OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (int b = 0; b < blocks; b++)
+			{
+				long long *c = count + (long long)b * radix;
+				std::fill(c, c + radix, 0);
+				int lo = (int)((long long)N * b / blocks);
+				int hi = (int)((long long)N * (b + 1) / blocks);
+				for (int i = lo; i < hi; i++)
+					c[(key_src[i] >> shift) & (radix - 1)]++;
+			}
+
+			//? (2) offsets: digit major, block minor (skip the pass if all keys have the same digit)
+			bool skip = false;
+			long long offset = 0;
+			for (int d = 0; d < radix; d++)
+			{
+				long long n_digit = 0;
+				for (int b = 0; b < blocks; b++)
+				{
+					long long c = count[(long long)b * radix + d];
+					count[(long long)b * radix + d] = offset;
+					offset += c;
+					n_digit += c;
+				}
+				if (n_digit == N)
+					skip = true;
+			}
+			if (skip)
+				continue;
+
+			//? (3) scatter
+#ifdef OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+			for (int b = 0; b < blocks; b++)
+			{
+				long long *c = count + (long long)b * radix;
+				int lo = (int)((long long)N * b / blocks);
+				int hi = (int)((long long)N * (b + 1) / blocks);
+				for (int i = lo; i < hi; i++)
+				{
+					long long pos = c[(key_src[i] >> shift) & (radix - 1)]++;
+					key_dst[pos] = key_src[i];
+					id_dst[pos] = id_src[i];
+				}
+			}
+			std::swap(key_src, key_dst);
+			std::swap(id_src, id_dst);
+		}
+
+		// result in the buffers of the caller
+		if (key_src != key)
+		{
+			memcpy(key, key_src, sizeof(uint64_t) * N);
+			memcpy(id, id_src, sizeof(int) * N);
+			std::swap(key_src, key_dst);
+			std::swap(id_src, id_dst);
+		}
+		free(key_dst);
+		free(id_dst);
+		free(count);
+	}
+
+	// sorts array and returns index (stable)
 	int *Sort_With_Index(double *v, int N)
 	{
 
 		int *id = (int *)malloc(N * sizeof(int));
+		uint64_t *key = (uint64_t *)malloc(N * sizeof(uint64_t));
+#ifdef OPENMP
+#pragma omp parallel for
+#endif
 		for (int i = 0; i < N; i++)
+		{
 			id[i] = i;
+			key[i] = Sort_Key(v[i]);
+		}
 
-		std::stable_sort(id, id + N, [&v](int i, int j)
-						 { return v[i] < v[j]; });
-
+		Radix_Sort(key, id, N);
+		free(key);
 		return id;
 	}
 
-	int *Sort_With_Index(collect *all_data, int N, std::string mode)
+	int *Sort_With_Index(collect *all_data, int N, collect_field mode)
 	{
 
 		int *id = (int *)malloc(N * sizeof(int));
+		double collect::*field = collect::Member(mode);
+		if (field == NULL)
+		{
+			// unknown field: every value reads as 0 (see collect::get), so the order is kept
+			for (int i = 0; i < N; i++)
+				id[i] = i;
+			return id;
+		}
+
+		uint64_t *key = (uint64_t *)malloc(N * sizeof(uint64_t));
+#ifdef OPENMP
+#pragma omp parallel for
+#endif
 		for (int i = 0; i < N; i++)
+		{
 			id[i] = i;
+			key[i] = Sort_Key(all_data[i].*field);
+		}
 
-		std::stable_sort(id, id + N, [all_data, mode](int i, int j)
-						 { return all_data[i].get(mode) < all_data[j].get(mode); });
-
+		Radix_Sort(key, id, N);
+		free(key);
 		return id;
 	}
 
+	int *Sort_With_Index(collect *all_data, int N, std::string mode)
+	{
+		return Sort_With_Index(all_data, N, collect::Field(mode));
+	}
+
 	// prints graph of overlapping phases
 	void Overlap_Graph(std::vector<std::vector<int>> &res, int N)
+	{
+		std::vector<int> n(res.size());
+		for (unsigned int i = 0; i < res.size(); i++)
+			n[i] = res[i].size();
+		Overlap_Graph(n, N);
+	}
+
+	// prints graph of overlapping phases from the number of overlapping phases at each event
+	void Overlap_Graph(const std::vector<int> &res, int N)
 	{
 
 		Function_Debug(__PRETTY_FUNCTION__);
@@ -407,7 +489,7 @@ namespace iohf
 
 			unsigned int col = 0;
 			for (unsigned int i = 0; i < row; i++)
-				col = (res[i].size() > col) ? res[i].size() : col;
+				col = ((unsigned int)res[i] > col) ? res[i] : col;
 
 			std::cout << "\n"
 					  << std::string((int)log10(col), ' ') << " ^";
@@ -418,9 +500,9 @@ namespace iohf
 						  << j << std::string((int)log10(col) - (int)log10(j), ' ') << "|";
 				for (unsigned int i = 0; i < row; i++)
 				{
-					if (res[i].size() > j)
+					if ((unsigned int)res[i] > j)
 						std::cout << "\u2588";
-					else if (res[i].size() == j)
+					else if ((unsigned int)res[i] == j)
 						std::cout << "\u2588";
 					else
 						std::cout << " ";
@@ -617,6 +699,16 @@ namespace iohf
 		return n;
 	}
 
+	int *N_Phase(const std::vector<int> &n)
+	{
+		if (n.size() == 0)
+			return NULL;
+
+		int *out = (int *)malloc(n.size() * sizeof(int));
+		std::copy(n.begin(), n.end(), out);
+		return out;
+	}
+
 	int *N_Phase(std::vector<std::vector<int>> &res)
 	{
 		if (res.size() == 0)
@@ -20,7 +20,7 @@
  * @param rank current rank
  * @param processes all processes
  */
-collect *ioanalysis::Gather_Collect(IOdata *iodata, int *n, int rank, int processes, MPI_Comm IO_WORLD, bool finilize)
+collect *ioanalysis::Gather_Collect(IOdata *iodata, int *n, int rank, int processes, MPI_Comm IO_WORLD)
 {
 
 	iohf::Function_Debug(__PRETTY_FUNCTION__);
@@ -79,30 +79,17 @@ collect *ioanalysis::Gather_Collect(IOdata *iodata, int *n, int rank, int proces
 
 	//* gather using the new type
 	//***************************
-	int *displacement = NULL;
 	if (rank == 0)
 	{
-		displacement = (int *)malloc(sizeof(int) * processes);
 		int sum = 0;
 		for (int i = 0; i < processes; i++)
-		{
-			displacement[i] = (i > 0) ? displacement[i - 1] + n[i - 1] : 0;
 			sum += n[i];
-		}
 
 		all_data = (collect *)malloc(sizeof(collect) * sum);
 	}
 
-	// gather collected data
-	MPI_Gatherv(&iodata->phase_data[0], iodata->phase_data.size(), GATHER_collect, all_data, n, displacement, GATHER_collect, 0, IO_WORLD);
-
-	// clean up
-	if (rank == 0)
-		free(displacement);
-
-	// remove unneeded elements
-	if (finilize)
-		iodata->phase_data.clear();
+	// gather collected data (see GATHER_MODE)
+	IOgather::Get(IO_WORLD).Gatherv(iodata->phase_data.data(), iodata->phase_data.size(), GATHER_collect, all_data, n);
 
 	// clean after the code has been executed 4 time (one for each mode: async/sync write/read)
 	if (counter == 4)
@@ -160,26 +147,21 @@ n_struct *ioanalysis::Gather_N_OP(n_struct n, int rank, int processes, MPI_Comm
 
 	//* gather using the new type
 	//***************************
-	int *displace = NULL;
-	int all_n[processes];
-	// find displacment based on number of operations (all_n)
+	int *all_n = NULL;
+	// every rank sends a single n_struct
 	if (rank == 0)
 	{
-		displace = (int *)malloc(sizeof(int) * processes);
+		all_n = (int *)malloc(sizeof(int) * processes);
 		for (int i = 0; i < processes; i++)
-		{
-			displace[i] = (i > 0) ? displace[i - 1] + 1 : 0;
 			all_n[i] = 1;
-		}
 
 		// set memory to collect all data
 		out = (n_struct *)malloc(sizeof(n_struct) * processes);
 	}
 
-	// finally gather data into all_data
-	int err = MPI_Gatherv(&n, 1, GATHER_n_op, out, all_n, displace, GATHER_n_op, 0, IO_WORLD);
-	if (displace != NULL)
-		free(displace);
+	// finally gather data into all_data (see GATHER_MODE)
+	int err = IOgather::Get(IO_WORLD).Gatherv(&n, 1, GATHER_n_op, out, all_n);
+	free(all_n);
 
 	if (err != MPI_SUCCESS)
 	{
@@ -341,4 +323,261 @@ AsyncRequest::AsyncRequest(MPI_Request* orig){
 bool AsyncRequest::check_request(MPI_Request *request) {
 	// TODO: find a better way to compare these, as request can change from outside
     return ((request != nullptr) && (ptr == request))  || (handle == *request);
+}
+
+uint64_t AsyncRequest::Ptr_Key(void) const
+{
+	return Ptr_Key(ptr);
+}
+
+uint64_t AsyncRequest::Handle_Key(void) const
+{
+	return Handle_Key(handle);
+}
+
+uint64_t AsyncRequest::Ptr_Key(MPI_Request *request)
+{
+	return (uint64_t)(uintptr_t)request;
+}
+
+/**
+ * @brief converts a request handle into a key. MPI_Request is an integer (MPICH) or a pointer (OpenMPI),
+ * so the bytes are copied instead of casted
+ */
+uint64_t AsyncRequest::Handle_Key(MPI_Request request)
+{
+	uint64_t key = 0;
+	memcpy(&key, &request, sizeof(MPI_Request) < sizeof(uint64_t) ? sizeof(MPI_Request) : sizeof(uint64_t));
+	return key;
+}
+
+//! ------------------------ ASYNC QUEUE -------------------------------
+
+//**********************************************************************
+//*                       1. AsyncQueue
+//**********************************************************************
+AsyncQueue::AsyncQueue(void)
+{
+	live = 0;
+	for (int k = 0; k < 2; k++)
+	{
+		used[k] = 0;
+		index[k].assign(64, async_bucket{0, -1, -1});
+	}
+}
+
+//**********************************************************************
+//*                       2. Push
+//**********************************************************************
+/**
+ * @brief adds a new async request to the queue. Both counters (required and actual) are set to one
+ *
+ * @param request [in] request pointer passed to the async I/O call
+ * @param t [in] start time of the request
+ * @param b [in] bytes of the request
+ */
+void AsyncQueue::Push(MPI_Request *request, double t, long long b)
+{
+	Push(AsyncRequest::Ptr_Key(request), AsyncRequest::Handle_Key(*request), t, b);
+}
+
+/**
+ * @brief adds a new async request given by its pointer and handle key (see AsyncRequest)
+ */
+void AsyncQueue::Push(uint64_t ptr_key, uint64_t handle_key, double t, long long b)
+{
+	int slot;
+	if (free_slots.empty())
+	{
+		slot = slots.size();
+		slots.push_back(async_entry(ptr_key, handle_key, t, b));
+	}
+	else
+	{
+		slot = free_slots.back();
+		free_slots.pop_back();
+		slots[slot] = async_entry(ptr_key, handle_key, t, b);
+	}
+
+	Link(0, ptr_key, slot);
+	Link(1, handle_key, slot);
+	live++;
+}
+
+//**********************************************************************
+//*                       3. Find
+//**********************************************************************
+/**
+ * @brief finds the oldest entry matching the request. The pointer is checked first, then the handle.
+ *
+ * @param request [in] request passed to MPI_Wait/MPI_Test
+ * @return async_entry* matching entry or NULL if the request is not traced
+ */
+async_entry *AsyncQueue::Find(MPI_Request *request)
+{
+	if (request == NULL || live == 0)
+		return NULL;
+
+	return Find(AsyncRequest::Ptr_Key(request), AsyncRequest::Handle_Key(*request));
+}
+
+/**
+ * @brief finds the oldest entry matching the pointer key or, if none, the handle key.
+ * A pointer key of 0 (NULL request) never matches
+ */
+async_entry *AsyncQueue::Find(uint64_t ptr_key, uint64_t handle_key)
+{
+	if (ptr_key == 0 || live == 0)
+		return NULL;
+
+	size_t pos = Probe(0, ptr_key);
+	if (index[0][pos].head != -1)
+		return &slots[index[0][pos].head];
+
+	pos = Probe(1, handle_key);
+	if (index[1][pos].head != -1)
+		return &slots[index[1][pos].head];
+
+	return NULL;
+}
+
+//**********************************************************************
+//*                       4. Retire
+//**********************************************************************
+/**
+ * @brief removes a finished entry (required and actual queried) from the queue. The slot is reused by \e Push
+ */
+void AsyncQueue::Retire(async_entry *entry)
+{
+	int slot = entry - slots.data();
+	Unlink(0, entry->key[0], slot);
+	Unlink(1, entry->key[1], slot);
+	entry->queue_req = 0;
+	entry->queue_act = 0;
+	free_slots.push_back(slot);
+	live--;
+}
+
+bool AsyncQueue::Empty(void) const
+{
+	return live == 0;
+}
+
+int AsyncQueue::Size(void) const
+{
+	return live;
+}
+
+//**********************************************************************
+//*                       5. Index helpers
+//**********************************************************************
+uint64_t AsyncQueue::Hash(uint64_t x)
+{
+	// splitmix64 finalizer
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+/**
+ * @brief linear probing. Returns the bucket holding \e key or the empty bucket where it would be inserted
+ */
+size_t AsyncQueue::Probe(int k, uint64_t key) const
+{
+	size_t mask = index[k].size() - 1;
+	size_t pos = Hash(key) & mask;
+	while (index[k][pos].head != -1 && index[k][pos].key != key)
+		pos = (pos + 1) & mask;
+	return pos;
+}
+
+/**
+ * @brief appends \e slot to the chain of \e key in index \e k
+ */
+void AsyncQueue::Link(int k, uint64_t key, int slot)
+{
+	if (2 * (used[k] + 1) > (int)index[k].size())
+		Grow(k);
+
+	size_t pos = Probe(k, key);
+	async_bucket &b = index[k][pos];
+	slots[slot].next[k] = -1;
+	if (b.head == -1)
+	{
+		b.key = key;
+		b.head = slot;
+		b.tail = slot;
+		slots[slot].prev[k] = -1;
+		used[k]++;
+	}
+	else
+	{
+		slots[b.tail].next[k] = slot;
+		slots[slot].prev[k] = b.tail;
+		b.tail = slot;
+	}
+}
+
+/**
+ * @brief removes \e slot from the chain of \e key in index \e k. Empty chains free their bucket
+ */
+void AsyncQueue::Unlink(int k, uint64_t key, int slot)
+{
+	size_t pos = Probe(k, key);
+	async_bucket &b = index[k][pos];
+	async_entry &e = slots[slot];
+
+	if (e.prev[k] != -1)
+		slots[e.prev[k]].next[k] = e.next[k];
+	else
+		b.head = e.next[k];
+
+	if (e.next[k] != -1)
+		slots[e.next[k]].prev[k] = e.prev[k];
+	else
+		b.tail = e.prev[k];
+
+	if (b.head == -1)
+	{
+		Erase_Bucket(k, pos);
+		used[k]--;
+	}
+}
+
+/**
+ * @brief backward shift deletion, keeps probe sequences intact without tombstones
+ */
+void AsyncQueue::Erase_Bucket(int k, size_t pos)
+{
+	std::vector<async_bucket> &b = index[k];
+	size_t mask = b.size() - 1;
+	size_t i = pos;
+	size_t j = pos;
+	while (true)
+	{
+		j = (j + 1) & mask;
+		if (b[j].head == -1)
+			break;
+		size_t home = Hash(b[j].key) & mask;
+		// entry at j stays if its home lies cyclically in (i, j]
+		if ((i <= j) ? (i < home && home <= j) : (i < home || home <= j))
+			continue;
+		b[i] = b[j];
+		i = j;
+	}
+	b[i].head = -1;
+	b[i].tail = -1;
+}
+
+void AsyncQueue::Grow(int k)
+{
+	std::vector<async_bucket> old;
+	old.swap(index[k]);
+	index[k].assign(2 * old.size(), async_bucket{0, -1, -1});
+	for (unsigned int i = 0; i < old.size(); i++)
+		if (old[i].head != -1)
+			index[k][Probe(k, old[i].key)] = old[i];
 }
\ No newline at end of file
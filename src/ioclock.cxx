@@ -0,0 +1,221 @@
+#include "ioclock.h"
+#include <algorithm>
+
+/**
+ * @file ioclock.cxx
+ * @brief Contains definitions of methods from the \e IOclock class.
+ */
+
+IOclock::IOclock(void)
+{
+	ref[0] = clock_ref{0, 0, 1e-9};
+	ref[1] = ref[0];
+	active.store(0, std::memory_order_relaxed);
+	calibrated = false;
+	drift = 0;
+	raw_sync = 0;
+	t_sync = 0;
+}
+
+//************************************************************************************
+//*                               1. Calibrate
+//************************************************************************************
+/**
+ * @brief maps the raw counter to MPI_Wtime. The first call estimates the scale (TSC: busy wait of 10 ms,
+ * CLOCK_MONOTONIC_RAW: nanoseconds). Later calls store the deviation from MPI_Wtime in \e drift and continue the
+ * mapping from the current time, so \e Now never steps. Only the scale changes: the rate of MPI_Wtime over the
+ * interval since the last calibration (if longer than 10 ms), corrected by at most CLOCK_SLEW so the deviation
+ * vanishes after an interval of the same length.
+ */
+void IOclock::Calibrate(void)
+{
+#if CLOCK_SOURCE != 0
+	const double min_interval = 0.01;
+	uint64_t raw;
+	double t;
+	Sample(raw, t);
+
+	clock_ref next;
+	if (!calibrated)
+	{
+		next = clock_ref{raw, t, 1e-9};
+#if CLOCK_SOURCE == 2
+		uint64_t raw_2;
+		double t_2;
+		do
+			Sample(raw_2, t_2);
+		while (t_2 - t < min_interval);
+		next = clock_ref{raw_2, t_2, (t_2 - t) / (double)(raw_2 - raw)};
+		raw = raw_2;
+		t = t_2;
+#endif
+		calibrated = true;
+	}
+	else
+	{
+		int current = active.load(std::memory_order_relaxed);
+		const clock_ref &last = ref[current];
+		double t_now = last.t + (double)(int64_t)(raw - last.raw) * last.scale;
+		drift = t_now - t;
+		next = clock_ref{raw, t_now, last.scale};
+		if (t - t_sync > min_interval && raw > raw_sync)
+		{
+			double slew = std::clamp(-drift / (t - t_sync), -CLOCK_SLEW, CLOCK_SLEW);
+			next.scale = (t - t_sync) / (double)(raw - raw_sync) * (1 + slew);
+		}
+	}
+	raw_sync = raw;
+	t_sync = t;
+
+	int slot = 1 - active.load(std::memory_order_relaxed);
+	ref[slot] = next;
+	active.store(slot, std::memory_order_release);
+#endif
+}
+
+//************************************************************************************
+//*                               2. Sample
+//************************************************************************************
+/**
+ * @brief reads the raw counter around MPI_Wtime and returns the midpoint. Keeps the narrowest of a few reads, as
+ * an error of the mapping is only slewed away afterwards and a rank descheduled in between would skew the scale
+ *
+ * @param raw [out] raw counter
+ * @param t [out] MPI_Wtime
+ */
+void IOclock::Sample(uint64_t &raw, double &t)
+{
+	uint64_t width = UINT64_MAX;
+	for (int i = 0; i < 5; i++)
+	{
+		uint64_t before = Raw();
+		double t_i = MPI_Wtime();
+		uint64_t after = Raw();
+		if (after - before < width)
+		{
+			width = after - before;
+			raw = before + (after - before) / 2;
+			t = t_i;
+		}
+	}
+}
+
+//************************************************************************************
+//*                               3. Offset
+//************************************************************************************
+/**
+ * @brief estimates the offset of the relative time (Now() - t_0) of this rank to the one of rank 0.
+ * @details Two levels, so the estimation does not grow with the number of ranks of rank 0: the ranks of each node
+ * measure their offset to the node leader (all nodes at the same time), then the leaders measure theirs to rank 0
+ * and pass it to the ranks of the node. The offset of a rank is the sum of both, and so is the error (see
+ * \e Ping_Pong). Collective over \e comm.
+ *
+ * @param t_0 [in] start time of this rank
+ * @param rank [in] rank in comm
+ * @param processes [in] size of comm
+ * @param comm [in] communicator used for the ping-pong
+ * @param error [out] estimated error of the offset (0 on rank 0)
+ * @return double offset to add to the relative times of this rank (0 on rank 0)
+ */
+double IOclock::Offset(double t_0, int rank, int processes, MPI_Comm comm, double &error) const
+{
+	error = 0;
+	if (processes == 1)
+		return 0;
+
+	MPI_Comm node_comm;
+	MPI_Comm leader_comm;
+	int node_rank = 0;
+	MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+	MPI_Comm_rank(node_comm, &node_rank);
+	MPI_Comm_split(comm, (node_rank == 0) ? 0 : MPI_UNDEFINED, rank, &leader_comm);
+
+	//? 1) offset to the node leader
+	double offset = Ping_Pong(t_0, node_comm, error);
+
+	//? 2) offset of the leader to rank 0 (rank 0 leads its node and the leaders)
+	double node[2] = {0, 0};
+	if (leader_comm != MPI_COMM_NULL)
+	{
+		node[0] = Ping_Pong(t_0, leader_comm, node[1]);
+		MPI_Comm_free(&leader_comm);
+	}
+	MPI_Bcast(node, 2, MPI_DOUBLE, 0, node_comm);
+	MPI_Comm_free(&node_comm);
+
+	error += node[1];
+	return offset + node[0];
+}
+
+//************************************************************************************
+//*                               4. Ping_Pong
+//************************************************************************************
+/**
+ * @brief estimates the offset of the relative time of this rank to the one of rank 0 of \e comm.
+ * @details Every other rank sends \e rounds pings to rank 0 at the same time. Rank 0 answers them in the order
+ * they arrive with its relative time t_ref. The rank takes t_1 before the ping and t_2 after the answer, and
+ * keeps the round with the smallest round trip time: offset = t_ref - (t_1 + t_2)/2, with an error of at most
+ * half the round trip time. Collective over \e comm.
+ *
+ * @param t_0 [in] start time of this rank
+ * @param comm [in] communicator
+ * @param error [out] estimated error of the offset (0 on rank 0)
+ * @return double offset (0 on rank 0)
+ */
+double IOclock::Ping_Pong(double t_0, MPI_Comm comm, double &error) const
+{
+	const int rounds = 10;
+	const int tag = 4242;
+	double offset = 0;
+	double t_ref = 0;
+	int rank = 0;
+	int processes = 1;
+	MPI_Comm_rank(comm, &rank);
+	MPI_Comm_size(comm, &processes);
+	error = 0;
+
+	if (rank == 0)
+	{
+		MPI_Status status;
+		for (int i = 0; i < (processes - 1) * rounds; i++)
+		{
+			MPI_Recv(&t_ref, 1, MPI_DOUBLE, MPI_ANY_SOURCE, tag, comm, &status);
+			t_ref = Now() - t_0;
+			MPI_Send(&t_ref, 1, MPI_DOUBLE, status.MPI_SOURCE, tag, comm);
+		}
+	}
+	else
+	{
+		double rtt_min = std::numeric_limits<double>::max();
+		for (int k = 0; k < rounds; k++)
+		{
+			double t_1 = Now() - t_0;
+			MPI_Send(&t_1, 1, MPI_DOUBLE, 0, tag, comm);
+			MPI_Recv(&t_ref, 1, MPI_DOUBLE, 0, tag, comm, MPI_STATUS_IGNORE);
+			double t_2 = Now() - t_0;
+			if (t_2 - t_1 < rtt_min)
+			{
+				rtt_min = t_2 - t_1;
+				offset = t_ref - (t_1 + t_2) / 2;
+			}
+		}
+		error = rtt_min / 2;
+	}
+	return offset;
+}
+
+double IOclock::Drift(void) const
+{
+	return drift;
+}
+
+std::string IOclock::Info(void) const
+{
+#if CLOCK_SOURCE == 2
+	return "Clock   : TSC";
+#elif CLOCK_SOURCE == 1
+	return "Clock   : CLOCK_MONOTONIC_RAW";
+#else
+	return "Clock   : MPI_Wtime";
+#endif
+}
@@ -13,44 +13,46 @@ collect::collect(void)
     n_op = 0;
 }
 
-double collect::get(std::string mode) const
+/**
+ * @brief maps the name of a field to the field
+ *
+ * @param mode "t_start", "t_end_act", "t_end_req", "T_sum", "T_avr", "B_sum" or "B_avr"
+ * @return collect_field (FIELD_NONE if the name is unknown)
+ */
+collect_field collect::Field(std::string mode)
 {
     if (mode == "t_start")
-        return t_start;
+        return FIELD_T_START;
     else if (mode == "t_end_act")
-        return t_end_act;
+        return FIELD_T_END_ACT;
     else if (mode == "t_end_req")
-        return t_end_req;
+        return FIELD_T_END_REQ;
     else if (mode == "T_sum")
-        return T_sum;
+        return FIELD_T_SUM;
     else if (mode == "T_avr")
-        return T_avr;
+        return FIELD_T_AVR;
     else if (mode == "B_sum")
-        return B_sum;
+        return FIELD_B_SUM;
     else if (mode == "B_avr")
-        return B_avr;
+        return FIELD_B_AVR;
     else
-        return 0;
+        return FIELD_NONE;
 }
 
-void collect::set(std::string mode, double value)
+void collect::set(collect_field field, double value)
 {
-    if (mode == "t_start")
-        t_start = value;
-    else if (mode == "t_end_act")
-        t_end_act = value;
-    else if (mode == "t_end_req")
-        t_end_req = value;
-    else if (mode == "T_sum")
-        T_sum = value;
-    else if (mode == "T_avr")
-        T_avr = value;
-    else if (mode == "B_sum")
-        B_sum = value;
-    else if (mode == "B_avr")
-        B_avr = value;
-    else
+    if (field == FIELD_NONE)
         printf("not supported assignment");
+    else
+        this->*Member(field) = value;
 }
 
+double collect::get(std::string mode) const
+{
+    return get(Field(mode));
+}
 
+void collect::set(std::string mode, double value)
+{
+    set(Field(mode), value);
+}
@@ -0,0 +1,324 @@
+#include "iocolumns.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <sys/uio.h>
+
+/**
+ * @file iocolumns.cxx
+ * @brief Contains definitions of methods from the \e IOcolumns class.
+ */
+
+// directory entry of a column without offset
+static io_column_entry Entry(const std::string &name, uint32_t type, uint32_t width, uint64_t count)
+{
+	io_column_entry e;
+	memset(&e, 0, sizeof(e));
+	if (name.size() >= IO_COLUMNS_NAME)
+		printf("IOcolumns: column name %s is truncated\n", name.c_str());
+	strncpy(e.name, name.c_str(), IO_COLUMNS_NAME - 1);
+	e.type = type;
+	e.width = width;
+	e.count = count;
+	return e;
+}
+
+// assigns the offsets of the columns (aligned to 8 bytes) starting at offset and returns the end
+static uint64_t Place(io_column_entry *e, size_t n, uint64_t offset)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		e[i].offset = offset;
+		offset += e[i].count * e[i].width;
+		offset = (offset + 7) / 8 * 8;
+	}
+	return offset;
+}
+
+// writes n values of type at an offset (PMPI: not traced). MPI counts are int, so above INT_MAX values the
+// buffer is described by one element of a struct type: n / IOCOLUMNS_CHUNK contiguous chunks and the rest
+static int Write_At(MPI_File fh, MPI_Offset at, const void *values, uint64_t n, MPI_Datatype type, bool collective)
+{
+	int count = (int)n;
+	MPI_Datatype large = type;
+	if (n > INT_MAX)
+	{
+		MPI_Aint lb, extent;
+		MPI_Type_get_extent(type, &lb, &extent);
+		MPI_Datatype chunk;
+		MPI_Type_contiguous(IOCOLUMNS_CHUNK, type, &chunk);
+		int lengths[2] = {(int)(n / IOCOLUMNS_CHUNK), (int)(n % IOCOLUMNS_CHUNK)};
+		MPI_Aint displacement[2] = {0, (MPI_Aint)(n / IOCOLUMNS_CHUNK * IOCOLUMNS_CHUNK) * extent};
+		MPI_Datatype types[2] = {chunk, type};
+		MPI_Type_create_struct(2, lengths, displacement, types, &large);
+		MPI_Type_commit(&large);
+		MPI_Type_free(&chunk);
+		count = 1;
+	}
+
+	int err;
+	if (collective)
+		err = PMPI_File_write_at_all(fh, at, values, count, large, MPI_STATUS_IGNORE);
+	else
+		err = PMPI_File_write_at(fh, at, values, count, large, MPI_STATUS_IGNORE);
+	if (large != type)
+		MPI_Type_free(&large);
+	return err;
+}
+
+// header of a file with n columns
+static void Header(io_columns_header *h, uint32_t n, uint64_t size)
+{
+	memcpy(h->magic, IO_COLUMNS_MAGIC, 8);
+	h->version = IO_COLUMNS_VERSION;
+	h->n_columns = n;
+	h->size = size;
+}
+
+IOcolumns::~IOcolumns()
+{
+	for (void *p : owned)
+		free(p);
+}
+
+//! ------------------------------ Columns ---------------------------------
+//************************************************************************************
+//*                               1. Add
+//************************************************************************************
+/**
+ * @brief adds an array as a column. The array is not copied and has to outlive \e Write
+ *
+ * @param name [in] name of the column ("<mode>/<name>", shorter than IO_COLUMNS_NAME)
+ * @param values [in] values (may be NULL if n is 0)
+ * @param n [in] number of values
+ */
+template <class T>
+void IOcolumns::Add(const std::string &name, const T *values, uint64_t n)
+{
+	entries.push_back(Entry(name, io_column_type_of<T>(), sizeof(T), (values) ? n : 0));
+	data.push_back(values);
+}
+template void IOcolumns::Add<double>(const std::string &, const double *, uint64_t);
+template void IOcolumns::Add<int>(const std::string &, const int *, uint64_t);
+template void IOcolumns::Add<long long>(const std::string &, const long long *, uint64_t);
+
+//************************************************************************************
+//*                               2. Column
+//************************************************************************************
+/**
+ * @brief adds a column owned by the instance
+ *
+ * @param name [in] name of the column
+ * @param n [in] number of values
+ * @return T* values to fill
+ */
+template <class T>
+T *IOcolumns::Column(const std::string &name, uint64_t n)
+{
+	T *values = (T *)malloc(sizeof(T) * (n ? n : 1));
+	owned.push_back(values);
+	Add(name, values, n);
+	return values;
+}
+template double *IOcolumns::Column<double>(const std::string &, uint64_t);
+template int *IOcolumns::Column<int>(const std::string &, uint64_t);
+template long long *IOcolumns::Column<long long>(const std::string &, uint64_t);
+
+//************************************************************************************
+//*                               3. Rank_Column
+//************************************************************************************
+/**
+ * @brief adds a column with the values of this rank, owned by the instance. Every rank has to add the same rank
+ * columns in the same order. Rank columns are only written by \e Write_All
+ *
+ * @param name [in] name of the column
+ * @param n [in] number of values of this rank
+ * @return T* values to fill
+ */
+template <class T>
+T *IOcolumns::Rank_Column(const std::string &name, uint64_t n)
+{
+	T *values = (T *)malloc(sizeof(T) * (n ? n : 1));
+	owned.push_back(values);
+	rank_entries.push_back(Entry(name, io_column_type_of<T>(), sizeof(T), n));
+	rank_data.push_back(values);
+	return values;
+}
+template double *IOcolumns::Rank_Column<double>(const std::string &, uint64_t);
+template int *IOcolumns::Rank_Column<int>(const std::string &, uint64_t);
+template long long *IOcolumns::Rank_Column<long long>(const std::string &, uint64_t);
+
+//! ------------------------------ Output ----------------------------------
+//************************************************************************************
+//*                               1. Write
+//************************************************************************************
+/**
+ * @brief writes the header, the directory and the columns (each aligned to 8 bytes)
+ *
+ * @param name [in] name of the file
+ * @return true if the file was written completely
+ */
+bool IOcolumns::Write(const std::string &name) const
+{
+	static const char padding[8] = {0};
+	uint32_t n_columns = entries.size();
+
+	// header and directory in one buffer
+	size_t head = sizeof(io_columns_header) + n_columns * sizeof(io_column_entry);
+	char *buffer = (char *)calloc(head, 1);
+	io_column_entry *e = (io_column_entry *)(buffer + sizeof(io_columns_header));
+	std::copy(entries.begin(), entries.end(), e);
+	Header((io_columns_header *)buffer, n_columns, Place(e, n_columns, head));
+
+	std::vector<struct iovec> iov;
+	iov.reserve(2 * n_columns + 1);
+	iov.push_back({buffer, head});
+	for (uint32_t i = 0; i < n_columns; i++)
+	{
+		size_t bytes = e[i].count * e[i].width;
+		if (bytes > 0)
+			iov.push_back({(void *)data[i], bytes});
+		if (bytes % 8 != 0)
+			iov.push_back({(void *)padding, 8 - bytes % 8});
+	}
+
+	int fd = open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+	{
+		printf("IOcolumns: could not open %s\n", name.c_str());
+		free(buffer);
+		return false;
+	}
+
+	// writev in batches of at most IOV_MAX buffers, resuming after partial writes
+	size_t i = 0;
+	bool ok = true;
+	while (i < iov.size() && ok)
+	{
+		int n = (iov.size() - i < IOV_MAX) ? iov.size() - i : IOV_MAX;
+		ssize_t written = writev(fd, &iov[i], n);
+		if (written < 0)
+		{
+			ok = false;
+			break;
+		}
+		while (i < iov.size() && written >= (ssize_t)iov[i].iov_len)
+			written -= iov[i++].iov_len;
+		if (written > 0)
+		{
+			iov[i].iov_base = (char *)iov[i].iov_base + written;
+			iov[i].iov_len -= written;
+		}
+	}
+	close(fd);
+	free(buffer);
+	if (!ok)
+		printf("IOcolumns: could not write %s\n", name.c_str());
+	return ok;
+}
+
+//************************************************************************************
+//*                               2. Write_All
+//************************************************************************************
+/**
+ * @brief writes the file collectively with MPI-IO. The offset of the values of a rank inside each rank column is
+ * the exclusive prefix sum (MPI_Exscan) of the number of values of the ranks before it. Rank 0 writes the header,
+ * the directory, its columns and the index columns, then all ranks write their values with MPI_File_write_at_all.
+ * The PMPI functions are called directly, so the writes are not traced. Columns with more than INT_MAX values
+ * are written as a single element of a derived datatype (see \e Write_At).
+ *
+ * @param name [in] name of the file
+ * @param comm [in] communicator (all ranks have to call this function)
+ * @return true if the file was written completely (on all ranks)
+ */
+bool IOcolumns::Write_All(const std::string &name, MPI_Comm comm) const
+{
+	int rank, procs;
+	MPI_Comm_rank(comm, &rank);
+	MPI_Comm_size(comm, &procs);
+	int n_rank = rank_entries.size();
+
+	// position of the values of this rank and number of values of all ranks
+	std::vector<long long> count(n_rank + 1), before(n_rank + 1, 0), total(n_rank + 1);
+	for (int c = 0; c < n_rank; c++)
+		count[c] = rank_entries[c].count;
+	MPI_Exscan(count.data(), before.data(), n_rank, MPI_LONG_LONG, MPI_SUM, comm);
+	if (rank == 0)
+		std::fill(before.begin(), before.end(), 0);
+	MPI_Allreduce(count.data(), total.data(), n_rank, MPI_LONG_LONG, MPI_SUM, comm);
+	long long *all = (rank == 0) ? (long long *)malloc(sizeof(long long) * procs * (n_rank + 1)) : NULL;
+	MPI_Gather(count.data(), n_rank, MPI_LONG_LONG, all, n_rank, MPI_LONG_LONG, 0, comm);
+
+	// layout (rank 0): header, directory, columns, index columns, rank columns. The offsets are broadcast
+	std::vector<uint64_t> offset(n_rank + 1);
+	char *buffer = NULL;
+	size_t head = 0;
+	if (rank == 0)
+	{
+		size_t n_global = entries.size() + n_rank;
+		uint32_t n_columns = n_global + n_rank;
+		std::vector<io_column_entry> e(entries);
+		std::vector<const void *> values(data);
+		std::vector<long long> index((size_t)procs * n_rank + 1);
+		for (int c = 0; c < n_rank; c++)
+		{
+			for (int r = 0; r < procs; r++)
+				index[(size_t)c * procs + r] = all[(size_t)r * n_rank + c];
+			e.push_back(Entry(std::string(rank_entries[c].name) + "_per_rank", IO_COLUMN_INT64, sizeof(long long), procs));
+			values.push_back(&index[(size_t)c * procs]);
+		}
+		for (int c = 0; c < n_rank; c++)
+		{
+			e.push_back(rank_entries[c]);
+			e.back().count = total[c];
+		}
+
+		head = sizeof(io_columns_header) + n_columns * sizeof(io_column_entry);
+		uint64_t end_global = Place(e.data(), n_global, head);
+		uint64_t size = Place(e.data() + n_global, n_rank, end_global);
+		for (int c = 0; c < n_rank; c++)
+			offset[c] = e[n_global + c].offset;
+		offset[n_rank] = size;
+
+		// header, directory and the columns of rank 0 in one buffer
+		buffer = (char *)calloc(end_global, 1);
+		Header((io_columns_header *)buffer, n_columns, size);
+		memcpy(buffer + sizeof(io_columns_header), e.data(), n_columns * sizeof(io_column_entry));
+		for (size_t i = 0; i < n_global; i++)
+			if (e[i].count > 0)
+				memcpy(buffer + e[i].offset, values[i], e[i].count * e[i].width);
+		head = end_global;
+	}
+	free(all);
+	MPI_Bcast(offset.data(), n_rank + 1, MPI_UINT64_T, 0, comm);
+
+	MPI_File fh;
+	int err = PMPI_File_open(comm, name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+	if (err != MPI_SUCCESS)
+	{
+		if (rank == 0)
+			printf("IOcolumns: could not open %s\n", name.c_str());
+		free(buffer);
+		return false;
+	}
+	bool ok = true;
+	if (rank == 0)
+		ok = Write_At(fh, 0, buffer, head, MPI_BYTE, false) == MPI_SUCCESS;
+	for (int c = 0; c < n_rank; c++)
+	{
+		const io_column_entry &e = rank_entries[c];
+		MPI_Datatype type = (e.type == IO_COLUMN_DOUBLE) ? MPI_DOUBLE : (e.type == IO_COLUMN_INT32) ? MPI_INT : MPI_LONG_LONG;
+		MPI_Offset at = offset[c] + before[c] * e.width;
+		ok &= Write_At(fh, at, rank_data[c], e.count, type, true) == MPI_SUCCESS;
+	}
+	// drops the rest of an older, longer file
+	ok &= PMPI_File_set_size(fh, offset[n_rank]) == MPI_SUCCESS;
+	PMPI_File_close(&fh);
+	free(buffer);
+
+	int all_ok = ok;
+	MPI_Allreduce(MPI_IN_PLACE, &all_ok, 1, MPI_INT, MPI_LAND, comm);
+	if (rank == 0 && !all_ok)
+		printf("IOcolumns: could not write %s\n", name.c_str());
+	return all_ok;
+}
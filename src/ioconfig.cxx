@@ -0,0 +1,137 @@
+#include "ioconfig.h"
+#include "iotelemetry_reader.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file ioconfig.cxx
+ * @brief Contains definitions of methods from the \e ioconfig namespace.
+ */
+
+namespace ioconfig
+{
+	// compile-time defaults until Load is called
+	static io_config settings = {ALL_SAMPLES, SKETCH, HISTOGRAM, SAME_T_END, ONLINE, SYNC_MODE, OVERHEAD, FILE_FORMAT, PARALLEL_OUTPUT, DELTA_OUTPUT, TELEMETRY, TELEMETRY_NAME, PUBLISHER_ENDPOINT};
+	static bool report = true; // only rank 0 reports invalid settings (its settings are used)
+
+	// integer variable between min and max. Invalid values are reported and the default is kept
+	static int Env(const char *name, int value, int min, int max)
+	{
+		const char *s = getenv(name);
+		if (s == NULL || *s == '\0')
+			return value;
+		char *end;
+		long v = strtol(s, &end, 10);
+		if (*end != '\0' || v < min || v > max)
+		{
+			if (report)
+				printf("TMIO: ignoring %s=%s (expected %i..%i)\n", name, s, min, max);
+			return value;
+		}
+		return (int)v;
+	}
+
+	static std::string Env(const char *name, const std::string &value)
+	{
+		const char *s = getenv(name);
+		return (s == NULL || *s == '\0') ? value : std::string(s);
+	}
+
+	//! ------------------------------ Settings ---------------------------------
+	//************************************************************************************
+	//*                               1. Load
+	//************************************************************************************
+	/**
+	 * @brief reads the TMIO_* variables and broadcasts the numeric settings of rank 0. Collective
+	 *
+	 * @param IO_WORLD [in] communicator
+	 */
+	void Load(MPI_Comm IO_WORLD)
+	{
+		int rank = 0;
+		MPI_Comm_rank(IO_WORLD, &rank);
+		report = (rank == 0);
+		io_config &c = settings;
+		c.all_samples = Env("TMIO_ALL_SAMPLES", c.all_samples, 0, 5);
+		c.sketch = Env("TMIO_SKETCH", c.sketch, 0, 1);
+		c.histogram = Env("TMIO_HISTOGRAM", c.histogram, 0, 1);
+		c.same_t_end = Env("TMIO_SAME_T_END", c.same_t_end, 0, 1);
+		c.online = Env("TMIO_ONLINE", c.online, 0, 1);
+		if (MEMORY_CAP > 0 && c.online == 0)
+		{
+			if (report)
+				printf("TMIO: ONLINE 0 needs all samples and is not possible with MEMORY_CAP\n");
+			c.online = 1;
+		}
+		c.sync_mode = Env("TMIO_SYNC_MODE", c.sync_mode, 0, 1);
+		c.overhead = Env("TMIO_OVERHEAD", c.overhead, 0, 1);
+		// msgpack and ZMQ need the libraries at build time: only the compiled format or 0 and 1
+		c.file_format = Env("TMIO_FILE_FORMAT", c.file_format, 0, (FILE_FORMAT > 1) ? FILE_FORMAT : 1);
+		if (c.file_format > 1 && c.file_format != FILE_FORMAT)
+		{
+			if (report)
+				printf("TMIO: FILE_FORMAT %i is not compiled in, using %i\n", c.file_format, FILE_FORMAT);
+			c.file_format = FILE_FORMAT;
+		}
+		c.parallel_output = Env("TMIO_PARALLEL_OUTPUT", c.parallel_output, 0, 1);
+		c.delta_output = Env("TMIO_DELTA_OUTPUT", c.delta_output, 0, 1);
+		if (c.delta_output && c.file_format != 0)
+		{
+			if (report)
+				printf("TMIO: DELTA_OUTPUT requires FILE_FORMAT 0 (jsonl) and is disabled\n");
+			c.delta_output = 0;
+		}
+		c.telemetry = Env("TMIO_TELEMETRY", c.telemetry, 0, 1);
+		c.telemetry_name = io_telemetry_name(Env("TMIO_TELEMETRY_NAME", TELEMETRY_NAME).c_str());
+		c.publisher_endpoint = Env("TMIO_PUBLISHER_ENDPOINT", c.publisher_endpoint);
+
+		int v[11] = {c.all_samples, c.sketch, c.histogram, c.same_t_end, c.online, c.sync_mode, c.overhead, c.file_format, c.parallel_output, c.delta_output, c.telemetry};
+		MPI_Bcast(v, 11, MPI_INT, 0, IO_WORLD);
+		c.all_samples = v[0];
+		c.sketch = v[1];
+		c.histogram = v[2];
+		c.same_t_end = v[3];
+		c.online = v[4];
+		c.sync_mode = v[5];
+		c.overhead = v[6];
+		c.file_format = v[7];
+		c.parallel_output = v[8];
+		c.delta_output = v[9];
+		c.telemetry = v[10];
+	}
+
+	//************************************************************************************
+	//*                               2. Get
+	//************************************************************************************
+	const io_config &Get(void)
+	{
+		return settings;
+	}
+
+	//************************************************************************************
+	//*                               3. Samples
+	//************************************************************************************
+	/**
+	 * @brief true if the individual I/O operations have to be kept: for the output (ALL_SAMPLES > 4) or for the
+	 * offline phase bandwidth (TMIO_ONLINE 0)
+	 */
+	bool Samples(void)
+	{
+		return settings.all_samples > 4 || settings.online == 0;
+	}
+
+	//************************************************************************************
+	//*                               4. Info
+	//************************************************************************************
+	/**
+	 * @brief runtime settings for the settings banner of rank 0
+	 */
+	std::string Info(void)
+	{
+		const io_config &c = settings;
+		char buff[256];
+		snprintf(buff, sizeof(buff), "Online  : %i\nSync    : %i\nOverhead: %i\nSketch  : %i\nHist.   : %i\nDelta   : %i\nParallel: %i\nTelem.  : %s\n", c.online,
+				 c.sync_mode, c.overhead, c.sketch, c.histogram, c.delta_output, c.parallel_output, c.telemetry ? c.telemetry_name.c_str() : "0");
+		return buff;
+	}
+}
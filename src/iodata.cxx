@@ -1,6 +1,7 @@
 #include "iodata.h"
 
-IOdata::IOdata(void): phase(false)
+IOdata::IOdata(void): phase(false), sketch_l(SKETCH_MIN_LATENCY), record_act(NULL), record_req(NULL), record_sync(NULL),
+                      end_req(NULL), end_act(NULL), end_sync(NULL)
 {
 }
 
@@ -22,16 +23,176 @@ void IOdata::Mode(int r, bool a, bool b)
 
     phase = false;
     rank  = r;
-    
-    #if ONLINE == 1
+    telemetry_mode = (a ? 0 : 1) + (b ? 0 : 2);
+    Recorder(ioconfig::Get());
     online_counter = 0;
-    #endif
+
+#if MEMORY_CAP > 0
+    // split the cap over the 4 modes and the actual and required samples
+    samples_act.Cap(MEMORY_CAP / (4 * 2 * IOsamples::Sample_Size()));
+    samples_req.Cap(MEMORY_CAP / (4 * 2 * IOsamples::Sample_Size()));
+#endif
 
 #if IODATA_VERBOSE >= 2
     printf("%s > rank %i %s> collecting data for %s %s%s\n", caller, rank, CYAN, w_or_r, a_or_s, BLACK);
 #endif
 }
 
+//! ----------------------- Recording ------------------------------
+//**********************************************************************
+//*                       1. Recorder
+//**********************************************************************
+/**
+ * @brief selects the recorders of the actual, required and sync I/O operations and the phase ends for the runtime
+ * settings (see ioconfig.h)
+ *
+ * @param c [in] runtime settings
+ * @details every combination of samples, sketches, histograms (actual) or same end time (required), telemetry and
+ * the online phase bandwidth is a specialization of \e Record_Act and \e Record_Req. The settings are therefore
+ * checked once here and not for every I/O operation. Samples are only kept if they are written (ALL_SAMPLES > 4)
+ * or needed offline (ONLINE 0). The sync phases (SYNC_MODE) and the phase bandwidths at the end of a phase (ONLINE)
+ * are selected the same way
+ */
+void IOdata::Recorder(const io_config &c)
+{
+    static const io_recorder act[32] = {
+        Record_Act<0, 0, 0, 0, 0>, Record_Act<0, 0, 0, 0, 1>, Record_Act<0, 0, 0, 1, 0>, Record_Act<0, 0, 0, 1, 1>,
+        Record_Act<0, 0, 1, 0, 0>, Record_Act<0, 0, 1, 0, 1>, Record_Act<0, 0, 1, 1, 0>, Record_Act<0, 0, 1, 1, 1>,
+        Record_Act<0, 1, 0, 0, 0>, Record_Act<0, 1, 0, 0, 1>, Record_Act<0, 1, 0, 1, 0>, Record_Act<0, 1, 0, 1, 1>,
+        Record_Act<0, 1, 1, 0, 0>, Record_Act<0, 1, 1, 0, 1>, Record_Act<0, 1, 1, 1, 0>, Record_Act<0, 1, 1, 1, 1>,
+        Record_Act<1, 0, 0, 0, 0>, Record_Act<1, 0, 0, 0, 1>, Record_Act<1, 0, 0, 1, 0>, Record_Act<1, 0, 0, 1, 1>,
+        Record_Act<1, 0, 1, 0, 0>, Record_Act<1, 0, 1, 0, 1>, Record_Act<1, 0, 1, 1, 0>, Record_Act<1, 0, 1, 1, 1>,
+        Record_Act<1, 1, 0, 0, 0>, Record_Act<1, 1, 0, 0, 1>, Record_Act<1, 1, 0, 1, 0>, Record_Act<1, 1, 0, 1, 1>,
+        Record_Act<1, 1, 1, 0, 0>, Record_Act<1, 1, 1, 0, 1>, Record_Act<1, 1, 1, 1, 0>, Record_Act<1, 1, 1, 1, 1>};
+    static const io_recorder req[32] = {
+        Record_Req<0, 0, 0, 0, 0>, Record_Req<0, 0, 0, 0, 1>, Record_Req<0, 0, 0, 1, 0>, Record_Req<0, 0, 0, 1, 1>,
+        Record_Req<0, 0, 1, 0, 0>, Record_Req<0, 0, 1, 0, 1>, Record_Req<0, 0, 1, 1, 0>, Record_Req<0, 0, 1, 1, 1>,
+        Record_Req<0, 1, 0, 0, 0>, Record_Req<0, 1, 0, 0, 1>, Record_Req<0, 1, 0, 1, 0>, Record_Req<0, 1, 0, 1, 1>,
+        Record_Req<0, 1, 1, 0, 0>, Record_Req<0, 1, 1, 0, 1>, Record_Req<0, 1, 1, 1, 0>, Record_Req<0, 1, 1, 1, 1>,
+        Record_Req<1, 0, 0, 0, 0>, Record_Req<1, 0, 0, 0, 1>, Record_Req<1, 0, 0, 1, 0>, Record_Req<1, 0, 0, 1, 1>,
+        Record_Req<1, 0, 1, 0, 0>, Record_Req<1, 0, 1, 0, 1>, Record_Req<1, 0, 1, 1, 0>, Record_Req<1, 0, 1, 1, 1>,
+        Record_Req<1, 1, 0, 0, 0>, Record_Req<1, 1, 0, 0, 1>, Record_Req<1, 1, 0, 1, 0>, Record_Req<1, 1, 0, 1, 1>,
+        Record_Req<1, 1, 1, 0, 0>, Record_Req<1, 1, 1, 0, 1>, Record_Req<1, 1, 1, 1, 0>, Record_Req<1, 1, 1, 1, 1>};
+
+    int keep = ioconfig::Samples() ? 16 : 0;
+    int live = c.telemetry ? 2 : 0;
+    int online = c.online ? 1 : 0;
+    record_act = act[keep + (c.sketch ? 8 : 0) + (c.histogram ? 4 : 0) + live + online];
+    record_req = req[keep + (c.sketch ? 8 : 0) + (c.same_t_end ? 4 : 0) + live + online];
+    record_sync = c.sync_mode ? Record_Sync<1> : Record_Sync<0>;
+    end_req = online ? End_Req<1> : End_Req<0>;
+    end_act = online ? End_Act<1> : End_Act<0>;
+    end_sync = online ? End_Sync<1> : End_Sync<0>;
+}
+
+//**********************************************************************
+//*                       2. Record_Act
+//**********************************************************************
+/**
+ * @brief records an actual I/O operation: samples (keep), throughput and latency sketches (sketch), size and latency
+ * histograms (histogram), the summed throughput of the phase (online) and the telemetry slot (live)
+ *
+ * @return double throughput of the I/O operation
+ */
+template <bool keep, bool sketch, bool histogram, bool live, bool online>
+double IOdata::Record_Act(IOdata &d, long long b, double ts, double te)
+{
+    double b_act = b / (te - ts);
+    // Sum: aggregated throughput of the individual I/O operations
+    if (online)
+        d.phase_data.back().T_sum += b_act;
+    if (keep)
+        d.samples_act.Add(b_act, ts, te, (int)d.phase_data.size());
+    if (sketch)
+    {
+        d.sketch_t.Add(b_act);
+        d.sketch_l.Add(te - ts);
+    }
+    if (histogram)
+        d.hist.Add(b, te - ts);
+    if (live && d.telemetry)
+        d.telemetry->Sample(d.telemetry_mode, d.Telemetry_Phase(), NAN, b_act, te);
+    return b_act;
+}
+
+//**********************************************************************
+//*                       3. Record_Req
+//**********************************************************************
+/**
+ * @brief records a required I/O operation: samples (keep), bandwidth sketch (sketch), the summed bandwidth of the
+ * phase (online) and the telemetry slot (live). With same_end, the operation ends with the required phase (SAME_T_END)
+ *
+ * @return double required bandwidth of the I/O operation
+ */
+template <bool keep, bool sketch, bool same_end, bool live, bool online>
+double IOdata::Record_Req(IOdata &d, long long b, double ts, double te)
+{
+    if (same_end)
+        te = d.phase_data.back().t_end_req;
+    double b_req = b / (te - ts);
+    // Sum: aggregated bandwidth of the individual I/O operations
+    if (online)
+        d.phase_data.back().B_sum += b_req;
+    if (keep)
+        d.samples_req.Add(b_req, ts, te, (int)d.phase_data.size());
+    if (sketch)
+        d.sketch_b.Add(b_req);
+    if (live && d.telemetry)
+        d.telemetry->Sample(d.telemetry_mode, d.Telemetry_Phase(), b_req, NAN, te);
+    return b_req;
+}
+
+//**********************************************************************
+//*                       4. Record_Sync
+//**********************************************************************
+/**
+ * @brief records a sync I/O operation. Each operation is a phase, or with per_file (SYNC_MODE 1) the phase starts
+ * with the first operation after the file was opened and ends when the file is closed (see \e Phase_End_Sync)
+ */
+template <bool per_file>
+void IOdata::Record_Sync(IOdata &d, long long b, double ts, double te, long long of)
+{
+    d.Phase_Start(per_file ? !d.phase : true, ts, b, of);
+    d.Add_Io(0, b, ts, te);
+    if (!per_file)
+        d.Phase_End_Sync(te);
+}
+
+//**********************************************************************
+//*                       5. End_Req, End_Act and End_Sync
+//**********************************************************************
+/**
+ * @brief Average: bytes of the phase divided by the time of the phase, computed when the phase ends (online).
+ * Offline, the phase bandwidths are computed at the summary (see \e Bandwidth_In_Phase_Offline)
+ */
+template <bool online>
+void IOdata::End_Req(collect &c)
+{
+    if (online)
+        c.B_avr = c.data / (c.t_end_req - c.t_start);
+}
+
+template <bool online>
+void IOdata::End_Act(collect &c)
+{
+    if (online)
+        c.T_avr = c.data / (c.t_end_act - c.t_start);
+}
+
+template <bool online>
+void IOdata::End_Sync(collect &c)
+{
+    // average and sum are the same for sync I/O
+    if (online)
+    {
+        c.T_avr = c.data / (c.t_end_act - c.t_start);
+        c.T_sum = c.T_avr;
+    }
+}
+
+//**********************************************************************
+//*                       6. Add_Io
+//**********************************************************************
 /**
  * @brief collects individual I/O operations
  *
@@ -39,80 +200,73 @@ void IOdata::Mode(int r, bool a, bool b)
  * @param b           [in] number of bytes transfered
  * @param ts          [in] start time of I/O operation
  * @param te          [in] end time of I/O operation
+ * @return double bandwidth of the I/O operation
  *
- * @details Adds IO operation to tracked data
+ * @details Adds IO operation to tracked data (see \e IOsamples) with the selected recorder (see \e Recorder). With
+ * MEMORY_CAP, the oldest samples are recycled once the cap is reached
  */
-void IOdata::Add_Io(bool req_or_act, long long b, double ts, double te)
+double IOdata::Add_Io(bool req_or_act, long long b, double ts, double te)
 {
 
     if (req_or_act)
     {
-#if SAME_T_END == 1
-        bandwidth_req.push_back(b / (phase_data.back().t_end_req - ts));
-#else
-        bandwidth_req.push_back(b / (te - ts));
-#endif
-
-#if ALL_SAMPLES > 4
-        t_req_s.push_back(ts);
-        #if SAME_T_END == 1
-        t_req_e.push_back(phase_data.back().t_end_req );
-        #else
-        t_req_e.push_back(te);
-        #endif
-#endif
+        double b_req = record_req(*this, b, ts, te);
 
 #if IODATA_VERBOSE >= 1
-#if SAME_T_END == 1
-        printf("%s > rank %i %s> %s %s phase %li > #%lli > req over: %.3f KB handled in %f s -> B(%li,%lli) = %.3f KB/s%s\n", caller, rank, CYAN, a_or_s, w_or_r, phase_data.size(), bandwidth_req.size() - count_opertaions_agg(phase_data.size() - 1), (double)b / 1000, phase_data.back().t_end_req - ts, phase_data.size(), bandwidth_req.size() - count_opertaions_agg(phase_data.size() - 1), (double)bandwidth_req.back() / 1000, BLACK);
-#else
-        printf("%s > rank %i %s> %s %s phase %li > #%lli > req over: %.3f KB handled in %f s -> B(%li,%lli) = %.3f KB/s%s\n", caller, rank, CYAN, a_or_s, w_or_r, phase_data.size(), bandwidth_req.size() - count_opertaions_agg(phase_data.size() - 1), (double)b / 1000, te - ts, phase_data.size(), bandwidth_req.size() - count_opertaions_agg(phase_data.size() - 1), (double)bandwidth_req.back() / 1000, BLACK);
-#endif
+        if (ioconfig::Get().same_t_end)
+            te = phase_data.back().t_end_req;
+        printf("%s > rank %i %s> %s %s phase %li > #%lli > req over: %.3f KB handled in %f s -> B(%li,%lli) = %.3f KB/s%s\n", caller, rank, CYAN, a_or_s, w_or_r, phase_data.size(), samples_req.Size() - count_opertaions_agg(phase_data.size() - 1), (double)b / 1000, te - ts, phase_data.size(), samples_req.Size() - count_opertaions_agg(phase_data.size() - 1), b_req / 1000, BLACK);
 #endif
 #if IODATA_VERBOSE >= 2
-#if SAME_T_END == 1
-        printf("%s > rank %i %s> %s %s phase %li > #%lli >> opertation from %f -> %f %s\n", caller, rank, YELLOW, a_or_s, w_or_r, phase_data.size(), bandwidth_req.size() - count_opertaions_agg(phase_data.size() - 1), ts, phase_data.back().t_end_req, BLACK);
-#else
-        printf("%s > rank %i %s> %s %s phase %li > #%lli >> opertation from %f -> %f %s\n", caller, rank, YELLOW, a_or_s, w_or_r, phase_data.size(), bandwidth_req.size() - count_opertaions_agg(phase_data.size() - 1), ts, te, BLACK);
-#endif
+        printf("%s > rank %i %s> %s %s phase %li > #%lli >> opertation from %f -> %f %s\n", caller, rank, YELLOW, a_or_s, w_or_r, phase_data.size(), samples_req.Size() - count_opertaions_agg(phase_data.size() - 1), ts, te, BLACK);
 #endif
+        return b_req;
     }
     else
     {
-        bandwidth_act.push_back(b / (te - ts));
-#if ALL_SAMPLES > 4
-        t_act_s.push_back(ts);
-        t_act_e.push_back(te);
-#endif
+        double b_act = record_act(*this, b, ts, te);
 
 #if IODATA_VERBOSE >= 1
-        printf("%s > rank %i %s> %s %s phase %li > #%lli > act over: %.3f KB handled in %f s -> T(%li,%lli) = %.3f KB/s%s\n", caller, rank, CYAN, a_or_s, w_or_r, phase_data.size(), bandwidth_act.size() - count_opertaions_agg(phase_data.size() - 1), (double)b / 1000, te - ts, phase_data.size(), bandwidth_act.size() - count_opertaions_agg(phase_data.size() - 1), (double)bandwidth_act.back() / 1000, BLACK);
+        printf("%s > rank %i %s> %s %s phase %li > #%lli > act over: %.3f KB handled in %f s -> T(%li,%lli) = %.3f KB/s%s\n", caller, rank, CYAN, a_or_s, w_or_r, phase_data.size(), samples_act.Size() - count_opertaions_agg(phase_data.size() - 1), (double)b / 1000, te - ts, phase_data.size(), samples_act.Size() - count_opertaions_agg(phase_data.size() - 1), b_act / 1000, BLACK);
 #endif
 #if IODATA_VERBOSE >= 2
-        printf("%s > rank %i %s> %s %s phase %li > #%lli >> opertation from %f -> %f %s\n", caller, rank, YELLOW, a_or_s, w_or_r, phase_data.size(), bandwidth_act.size() - count_opertaions_agg(phase_data.size() - 1), ts, te, BLACK);
+        printf("%s > rank %i %s> %s %s phase %li > #%lli >> opertation from %f -> %f %s\n", caller, rank, YELLOW, a_or_s, w_or_r, phase_data.size(), samples_act.Size() - count_opertaions_agg(phase_data.size() - 1), ts, te, BLACK);
 #endif
+        return b_act;
     }
 }
 
-
-
-
 /**
  *
  * @details Remove all data traced so far
  */
 void IOdata::Clear_IO(void)
 {
-    bandwidth_act.clear();
-    bandwidth_req.clear();
-    t_act_s.clear();
-    t_act_e.clear();
-    t_req_s.clear();
-    t_req_e.clear();
-    phases.clear();
+    samples_act.Clear();
+    samples_req.Clear();
+    sketch_b.Clear();
+    sketch_t.Clear();
+    sketch_l.Clear();
+    hist.Clear();
     phase_data.clear();
 }
 
+/**
+ *
+ * @details Exchanges all data traced so far with \e other (same data as cleared by \e Clear_IO). The mode and
+ * the state of the current phase stay. Used to hand the data of an interval over to the flush thread (ASYNC_FLUSH)
+ */
+void IOdata::Swap_IO(IOdata &other)
+{
+    samples_act.Swap(other.samples_act);
+    samples_req.Swap(other.samples_req);
+    std::swap(sketch_b, other.sketch_b);
+    std::swap(sketch_t, other.sketch_t);
+    std::swap(sketch_l, other.sketch_l);
+    std::swap(hist, other.hist);
+    phase_data.swap(other.phase_data);
+}
+
 
 /**
  * @brief indicates that the phases starts. this function works for both async (actual and required) and sync I/O. 
@@ -145,8 +299,9 @@ void IOdata::Phase_Start(bool condition, double t, long long b, long long of)
     phase_data.back().data += b;
     // count I/O operations during phase
     phase_data.back().n_op += 1;
-    // record current phase
-    phases.push_back(phase_data.size());
+
+    if (telemetry)
+        telemetry->Start(telemetry_mode, Telemetry_Phase(), b, condition, t);
     
     // record current offset
     //offset.push_back(of);
@@ -175,26 +330,16 @@ void IOdata::Phase_End_Req(long long b, double ts, double te)
     if (phase){
         phase_data.back().t_end_req = te;
         phase = false;
-
-#if ONLINE == 1 
-        //Average: bytes during phase divided by actual I/O time
-        phase_data.back().B_avr = phase_data.back().data / (phase_data.back().t_end_req - phase_data.back().t_start);
+        end_req(phase_data.back());
 
 #if IODATA_VERBOSE >= 1
         printf("%s > rank %i %s> %s %s phase %li > req phase over >> %.3f KB handled in %.5f sec --> B_avr(%li) = %.3f KB/s %s\n", caller, rank, CYAN, a_or_s, w_or_r, phase_data.size(), (double)phase_data.back().data/1000, phase_data.back().t_end_req - phase_data.back().t_start, phase_data.size(), phase_data.back().B_avr / 1000, BLACK);
-#endif
-
-        
 #endif
     }
 
-    // add required values to tracked data
+    // add required values to tracked data (and to the summed bandwidth of the phase, see Record_Req)
     Add_Io(1, b, ts, te);
 
-//Sum: aggregegated bandwidth of individual I/O opertaions
-#if ONLINE == 1 
-    phase_data.back().B_sum  += bandwidth_req.back();    
-
 #if IODATA_VERBOSE >= 3
     static int counter = 0; 
     counter+=1; 
@@ -203,8 +348,6 @@ void IOdata::Phase_End_Req(long long b, double ts, double te)
         counter = 0;
     }
 #endif
-    
-#endif
 }
 
 
@@ -221,43 +364,60 @@ void IOdata::Phase_End_Act(long long b, double ts, double te, bool phase_conditi
 {
 
     
-    // if ONLINE == 1, calculate phase bandwidth
+    // phase bandwidth with ONLINE 1 (see End_Act)
     if (phase_condition)
     {
         phase_data.back().t_end_act   = te;
-
-#if ONLINE == 1
-        // avr bytes during phase divided by actual I/O time
-        phase_data.back().T_avr = phase_data.back().data/(phase_data.back().t_end_act - phase_data.back().t_start);
+        end_act(phase_data.back());
 
 #if IODATA_VERBOSE >= 1
         printf("%s > rank %i %s> %s %s phase %li > act phase over >> %.3f KB handled in %.5f sec --> T_avr(%li) = %.3f MB/s %s\n", caller, rank, CYAN, a_or_s, w_or_r, phase_data.size(), (double)phase_data.back().data/1000, phase_data.back().t_end_act - phase_data.back().t_start, phase_data.size(), phase_data.back().T_avr / 1'000'000, BLACK);
 #endif
 #if IODATA_VERBOSE >= 3
         printf("%s > rank %i %s> %s %s phase %li > act phase over >> %.3f KB handled in %.5f sec --> T_sum(%li) = %.3f MB/s %s\n", caller, rank, BLUE, a_or_s, w_or_r, phase_data.size(), (double)phase_data.back().data/1000, phase_data.back().t_end_act - phase_data.back().t_start, phase_data.size(), phase_data.back().T_sum / 1'000'000, BLACK);
-#endif
-        
 #endif
     }
     
     //TODO: flag to contol granualrtiy of sampling
-    //add actual values to tracked data
+    //add actual values to tracked data (and to the summed throughput of the phase, see Record_Act)
     Add_Io(0, b, ts, te);
 
-//Sum: aggregegated bandwidth of individual I/O opertaions
-#if ONLINE == 1 
-    phase_data.back().T_sum  += bandwidth_act.back();    
-#endif
+    if (telemetry && phase_condition)
+        telemetry->Complete(telemetry_mode, Telemetry_Phase(), te);
 
+}
 
+/**
+ * @brief current phase (phase_data.back()) in the layout of the telemetry segment (see iotelemetry_reader.h)
+ */
+io_telemetry_phase IOdata::Telemetry_Phase(void) const
+{
+    const collect &c = phase_data.back();
+    return {c.t_start, c.t_end_act, c.t_end_req, c.T_sum, c.T_avr, c.B_sum, c.B_avr, c.data, c.n_op};
 }
 
 //! ----------------------- Sync ------------------------------
 //**********************************************************************
-//*                       1. Lost_Time
+//*                       1. Add_Sync
+//**********************************************************************
+/**
+ * @brief records a sync I/O operation with the recorder of the sync mode (see \e Record_Sync)
+ *
+ * @param b  [in] number of bytes transfered
+ * @param ts [in] start time of I/O operation
+ * @param te [in] end time of I/O operation
+ * @param of [in] offset
+ */
+void IOdata::Add_Sync(long long b, double ts, double te, long long of)
+{
+    record_sync(*this, b, ts, te, of);
+}
+
+//**********************************************************************
+//*                       2. Phase_End_Sync
 //**********************************************************************
 /**
- * @brief end of sync phase. Calculates throughput if ONLINE flag is passed (see \e ioflags.h)
+ * @brief end of sync phase. Calculates throughput if ONLINE is set (see \e ioflags.h and \e End_Sync)
  * 
  */
 void IOdata::Phase_End_Sync(double t)
@@ -271,10 +431,9 @@ void IOdata::Phase_End_Sync(double t)
         
         
         phase_data.back().t_end_act = t;
-#if ONLINE == 1
-        phase_data.back().T_avr     = phase_data.back().data / (phase_data.back().t_end_act - phase_data.back().t_start);
-        phase_data.back().T_sum     = phase_data.back().T_avr;
-#endif
+        end_sync(phase_data.back());
+        if (telemetry)
+            telemetry->Complete(telemetry_mode, Telemetry_Phase(), t);
 
 
 #if IODATA_VERBOSE >= 1
@@ -328,10 +487,12 @@ long long IOdata::count_opertaions(long long a)
 {
     long long counter = 0;
 
-    for (unsigned int i = 0; i < phases.size(); i++)
+    for (size_t i = 0; i < samples_act.Blocks(); i++)
     {
-        if (phases[i] == a)
-            counter++;
+        const io_sample_block &block = samples_act.Block(i);
+        for (size_t j = 0; j < block.n; j++)
+            if (block.phase[j] == a)
+                counter++;
     }
 
     return counter;
@@ -359,63 +520,53 @@ void IOdata::Bandwidth_In_Phase_Offline(void)
     iohf::Function_Debug(__PRETTY_FUNCTION__);
     Debug_Info_Bandwidth_In_Phase();
 
-    int counter = 0;
-    int loops = phase_data.size();
-    double tmp_act = 0;
-    double tmp_req = 0;
-
-    for (int i = 0; i < loops; i++)
+    // sum the individual bandwidths of each phase (phase indices are 1 based)
+    for (size_t i = 0; i < phase_data.size(); i++)
     {
+        phase_data[i].T_sum = 0;
+        if (a_or_s_flag)
+            phase_data[i].B_sum = 0;
+    }
 
-    
+    for (size_t i = 0; i < samples_act.Blocks(); i++)
+    {
+        const io_sample_block &block = samples_act.Block(i);
+        for (size_t j = 0; j < block.n; j++)
+            if (block.phase[j] > 0 && block.phase[j] <= (int)phase_data.size())
+                phase_data[block.phase[j] - 1].T_sum += block.b[j];
+    }
 
-        if (counter == phases[i])
-        {
-            tmp_act += bandwidth_act[i];
-            if (a_or_s_flag)
-                tmp_req += bandwidth_req[i];
-        }
-        if (i == loops - 1 || counter != phases[i + 1])
+    if (a_or_s_flag)
+    {
+        for (size_t i = 0; i < samples_req.Blocks(); i++)
         {
-            counter++;
-
-            phase_data[i].T_sum = tmp_act;
-            tmp_act = 0;
-
-            if (a_or_s_flag)
-            {
-                
-                phase_data[i].B_sum = tmp_req;
-                tmp_req = 0;
-            }
+            const io_sample_block &block = samples_req.Block(i);
+            for (size_t j = 0; j < block.n; j++)
+                if (block.phase[j] > 0 && block.phase[j] <= (int)phase_data.size())
+                    phase_data[block.phase[j] - 1].B_sum += block.b[j];
         }
     }
 
-if (phases.size() > 0){
-    for (int i = 0; i <= phases.back(); i++)
+    for (size_t i = 0; i < phase_data.size(); i++)
     {
-        
         phase_data[i].T_avr = phase_data[i].data / (phase_data[i].t_end_act - phase_data[i].t_start);
-        
-        if (a_or_s_flag){
+
+        if (a_or_s_flag)
             phase_data[i].B_avr = phase_data[i].data / (phase_data[i].t_end_act - phase_data[i].t_start);
-        }
     }
 }
 
-}
-
 void IOdata::Debug_Info_Bandwidth_In_Phase(void)
 {
 #if IODATA_VERBOSE >= 1
     printf("%s > rank %i %s> %s %s merge > merging individual bandwidths inside a phase to a single phase bandwidth. %s\n", caller, rank, CYAN, a_or_s, w_or_r, BLACK);
 #endif
 #if IODATA_VERBOSE >= 2
-    printf("%s > rank %i %s> %s %s merge >> merging %li bandwidths to %li phase bandwidths %s\n", caller, rank, CYAN, a_or_s, w_or_r, bandwidth_req.size(), phase_data.size(), BLACK);
+    printf("%s > rank %i %s> %s %s merge >> merging %li bandwidths to %li phase bandwidths %s\n", caller, rank, CYAN, a_or_s, w_or_r, samples_req.Size(), phase_data.size(), BLACK);
 #endif
 #if IODATA_VERBOSE >= 3
-    printf("%s > rank %i %s> %s %s merge >>> act > %li -> %li %s\n", caller, rank, YELLOW, a_or_s, w_or_r, bandwidth_act.size(), phase_data.size(), BLACK);
+    printf("%s > rank %i %s> %s %s merge >>> act > %li -> %li %s\n", caller, rank, YELLOW, a_or_s, w_or_r, samples_act.Size(), phase_data.size(), BLACK);
     if (a_or_s_flag)
-        printf("%s > rank %i %s> %s %s merge >>> req > %li -> %li %s\n", caller, rank, YELLOW, a_or_s, w_or_r, bandwidth_req.size(), phase_data.size(), BLACK);
+        printf("%s > rank %i %s> %s %s merge >>> req > %li -> %li %s\n", caller, rank, YELLOW, a_or_s, w_or_r, samples_req.Size(), phase_data.size(), BLACK);
 #endif
 }
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include "iogather.h"
+#include <unistd.h>
+
+/**
+ * @file iogather.cxx
+ * @brief Contains definitions of methods from the \e IOgather class.
+ */
+
+// waits for a non-blocking collective. With ASYNC_FLUSH, the gather runs on the flush thread, which polls and
+// sleeps in between, so the core is left to the application. PMPI: the request is not traced
+static int Wait(MPI_Request *request)
+{
+#if ASYNC_FLUSH == 1
+	int done = 0;
+	int err;
+	while ((err = PMPI_Test(request, &done, MPI_STATUS_IGNORE)) == MPI_SUCCESS && !done)
+		usleep(ASYNC_FLUSH_POLL);
+	return err;
+#else
+	return PMPI_Wait(request, MPI_STATUS_IGNORE);
+#endif
+}
+
+// MPI_Gatherv to rank 0 as non-blocking collective (see Wait)
+static int Igatherv(const void *send, int send_count, MPI_Datatype send_type, void *recv, const int *n, const int *displacement, MPI_Datatype type, MPI_Comm c)
+{
+	MPI_Request request;
+	int err = MPI_Igatherv(send, send_count, send_type, recv, n, displacement, type, 0, c, &request);
+	return (err == MPI_SUCCESS) ? Wait(&request) : err;
+}
+
+//************************************************************************************
+//*                               1. Get
+//************************************************************************************
+std::map<MPI_Comm, IOgather *> IOgather::instances;
+std::mutex IOgather::instances_lock;
+
+/**
+ * @brief returns the gather instance of a communicator. The first call for a communicator is collective over
+ * \e c as it splits the communicator into node and leader communicators. Later calls reuse the instance
+ *
+ * @param c [in] communicator (usually IO_WORLD)
+ * @return IOgather& instance for \e c
+ */
+IOgather &IOgather::Get(MPI_Comm c)
+{
+	std::lock_guard<std::mutex> lock(instances_lock);
+	IOgather *&instance = instances[c];
+	if (instance == NULL)
+		instance = new IOgather(c);
+
+	return *instance;
+}
+
+//************************************************************************************
+//*                               2. Free
+//************************************************************************************
+/**
+ * @brief frees all instances and their node and leader communicators. Called once the last summary is
+ * gathered, before PMPI_Finalize
+ */
+void IOgather::Free(void)
+{
+	std::lock_guard<std::mutex> lock(instances_lock);
+	for (std::map<MPI_Comm, IOgather *>::iterator it = instances.begin(); it != instances.end(); ++it)
+		delete it->second;
+	instances.clear();
+}
+
+IOgather::IOgather(MPI_Comm c)
+{
+	comm = c;
+	MPI_Comm_rank(comm, &rank);
+	MPI_Comm_size(comm, &processes);
+	node_comm = MPI_COMM_NULL;
+	leader_comm = MPI_COMM_NULL;
+	node_rank = 0;
+	node_procs = 1;
+	nodes = processes;
+	node_size = NULL;
+	node_ranks = NULL;
+	in_order = true;
+
+#if GATHER_MODE == 1
+	MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+	MPI_Comm_rank(node_comm, &node_rank);
+	MPI_Comm_size(node_comm, &node_procs);
+	MPI_Comm_split(comm, (node_rank == 0) ? 0 : MPI_UNDEFINED, rank, &leader_comm);
+
+	// ranks of each node, collected on rank 0 in the order the node blocks arrive
+	int *members = NULL;
+	if (node_rank == 0)
+		members = (int *)malloc(sizeof(int) * node_procs);
+	MPI_Gather(&rank, 1, MPI_INT, members, 1, MPI_INT, 0, node_comm);
+
+	if (leader_comm != MPI_COMM_NULL)
+	{
+		MPI_Comm_size(leader_comm, &nodes);
+		int *displacement = NULL;
+		if (rank == 0)
+		{
+			node_size = (int *)malloc(sizeof(int) * nodes);
+			node_ranks = (int *)malloc(sizeof(int) * processes);
+			displacement = (int *)malloc(sizeof(int) * nodes);
+		}
+		MPI_Gather(&node_procs, 1, MPI_INT, node_size, 1, MPI_INT, 0, leader_comm);
+		if (rank == 0)
+		{
+			displacement[0] = 0;
+			for (int i = 1; i < nodes; i++)
+				displacement[i] = displacement[i - 1] + node_size[i - 1];
+		}
+		MPI_Gatherv(members, node_procs, MPI_INT, node_ranks, node_size, displacement, MPI_INT, 0, leader_comm);
+
+		if (rank == 0)
+		{
+			for (int i = 0; i < processes; i++)
+				if (node_ranks[i] != i)
+					in_order = false;
+			free(displacement);
+		}
+	}
+	free(members);
+#endif
+}
+
+IOgather::~IOgather(void)
+{
+	if (node_comm != MPI_COMM_NULL)
+		MPI_Comm_free(&node_comm);
+	if (leader_comm != MPI_COMM_NULL)
+		MPI_Comm_free(&leader_comm);
+	free(node_size);
+	free(node_ranks);
+}
+
+//************************************************************************************
+//*                               3. Gatherv
+//************************************************************************************
+/**
+ * @brief gathers the data of all ranks on rank 0 in rank order (same result as MPI_Gatherv to rank 0)
+ *
+ * @param send [in] data of the current rank
+ * @param n [in] number of elements of \e type the current rank sends
+ * @param type [in] datatype of the elements
+ * @param recv [out] receive buffer of rank 0 (sum of \e n_all elements)
+ * @param n_all [in] number of elements of each rank (only needed on rank 0)
+ * @return int MPI error code
+ */
+int IOgather::Gatherv(const void *send, int n, MPI_Datatype type, void *recv, const int *n_all)
+{
+	return Gatherv(send, n, type, n, recv, n_all, type);
+}
+
+/**
+ * @brief gathers the data of all ranks on rank 0 in rank order. The send buffer is described by \e send_count
+ * elements of \e send_type (e.g., a struct type over the blocks of IOsamples) that match \e n elements of \e type
+ *
+ * @param send [in] data of the current rank
+ * @param send_count [in] count of \e send_type
+ * @param send_type [in] datatype describing the send buffer
+ * @param n [in] number of elements of \e type the current rank sends
+ * @param recv [out] receive buffer of rank 0 (sum of \e n_all elements)
+ * @param n_all [in] number of elements of each rank (only needed on rank 0)
+ * @param type [in] datatype of the received elements
+ * @return int MPI error code (first failing call)
+ */
+int IOgather::Gatherv(const void *send, int send_count, MPI_Datatype send_type, int n, void *recv, const int *n_all, MPI_Datatype type)
+{
+	MPI_Aint lb, extent;
+	MPI_Type_get_extent(type, &lb, &extent);
+
+	//? flat gather
+	if (node_comm == MPI_COMM_NULL)
+	{
+		int *displacement = NULL;
+		if (rank == 0)
+		{
+			displacement = (int *)malloc(sizeof(int) * processes);
+			displacement[0] = 0;
+			for (int i = 1; i < processes; i++)
+				displacement[i] = displacement[i - 1] + n_all[i - 1];
+		}
+		int err = Igatherv(send, send_count, send_type, recv, n_all, displacement, type, comm);
+		free(displacement);
+		return err;
+	}
+
+	//? (1) gather on the node leader
+	int *n_node = NULL;
+	int *displacement_node = NULL;
+	int total = 0;
+	char *node_buffer = NULL;
+	if (node_rank == 0)
+	{
+		n_node = (int *)malloc(sizeof(int) * node_procs);
+		displacement_node = (int *)malloc(sizeof(int) * node_procs);
+	}
+	MPI_Gather(&n, 1, MPI_INT, n_node, 1, MPI_INT, 0, node_comm);
+	if (node_rank == 0)
+	{
+		for (int i = 0; i < node_procs; i++)
+		{
+			displacement_node[i] = total;
+			total += n_node[i];
+		}
+		// rank 0 collects its node directly into the result if the blocks arrive in order
+		node_buffer = (rank == 0 && in_order) ? (char *)recv : (char *)malloc(total * extent);
+	}
+	int err = Igatherv(send, send_count, send_type, node_buffer, n_node, displacement_node, type, node_comm);
+
+	//? (2) gather the node blocks on rank 0
+	if (leader_comm != MPI_COMM_NULL)
+	{
+		int *n_nodes = NULL;
+		int *displacement_nodes = NULL;
+		char *all = NULL;
+		if (rank == 0)
+		{
+			n_nodes = (int *)malloc(sizeof(int) * nodes);
+			displacement_nodes = (int *)malloc(sizeof(int) * nodes);
+			int k = 0;
+			int sum = 0;
+			for (int i = 0; i < nodes; i++)
+			{
+				n_nodes[i] = 0;
+				for (int j = 0; j < node_size[i]; j++)
+					n_nodes[i] += n_all[node_ranks[k++]];
+				displacement_nodes[i] = sum;
+				sum += n_nodes[i];
+			}
+			all = in_order ? (char *)recv : (char *)malloc(sum * extent);
+		}
+
+		int err_leader;
+		if (rank == 0 && in_order)
+			err_leader = Igatherv(MPI_IN_PLACE, 0, type, all, n_nodes, displacement_nodes, type, leader_comm);
+		else
+			err_leader = Igatherv(node_buffer, total, type, all, n_nodes, displacement_nodes, type, leader_comm);
+		if (err == MPI_SUCCESS)
+			err = err_leader;
+
+		// restore rank order
+		if (rank == 0 && !in_order)
+		{
+			int *displacement = (int *)malloc(sizeof(int) * processes);
+			displacement[0] = 0;
+			for (int i = 1; i < processes; i++)
+				displacement[i] = displacement[i - 1] + n_all[i - 1];
+
+			MPI_Aint offset = 0;
+			for (int i = 0; i < processes; i++)
+			{
+				int r = node_ranks[i];
+				memcpy((char *)recv + displacement[r] * extent, all + offset, n_all[r] * extent);
+				offset += n_all[r] * extent;
+			}
+			free(displacement);
+			free(all);
+		}
+		free(n_nodes);
+		free(displacement_nodes);
+	}
+
+	if (node_buffer != (char *)recv)
+		free(node_buffer);
+	free(n_node);
+	free(displacement_node);
+	return err;
+}
@@ -0,0 +1,65 @@
+#include "iohistogram.h"
+
+/**
+ * @file iohistogram.cxx
+ * @brief Contains definitions of methods from the \e IOhistogram class.
+ */
+
+//************************************************************************************
+//*                               1. Lower
+//************************************************************************************
+/**
+ * @brief returns the lower bound of a bucket (inverse of \e Bucket)
+ *
+ * @param i [in] bucket
+ * @return uint64_t smallest value counted in the bucket (UINT64_MAX above the last bucket)
+ */
+uint64_t IOhistogram::Lower(int i)
+{
+	const int sub = 1 << IOHISTOGRAM_SUB_BITS;
+	if (i < sub)
+		return i;
+	int msb = (i >> IOHISTOGRAM_SUB_BITS) + IOHISTOGRAM_SUB_BITS - 1;
+	if (msb > 63)
+		return UINT64_MAX;
+	return (uint64_t)(sub + (i & (sub - 1))) << (msb - IOHISTOGRAM_SUB_BITS);
+}
+
+//************************************************************************************
+//*                               2. Reduce
+//************************************************************************************
+/**
+ * @brief adds the histograms of all ranks on rank 0 with a single MPI_Reduce. Collective
+ *
+ * @param in [in] histograms of the current rank
+ * @param out [out] histograms summed over all ranks (only set on rank 0)
+ * @param n [in] number of histograms
+ * @param IO_WORLD [in] communicator
+ */
+void IOhistogram::Reduce(const IOhistogram *const *in, IOhistogram *const *out, int n, MPI_Comm IO_WORLD)
+{
+	int rank;
+	MPI_Comm_rank(IO_WORLD, &rank);
+
+	const int bins = 2 * IOHISTOGRAM_BINS;
+	long long *buff = (long long *)malloc(sizeof(long long) * bins * n);
+	for (int k = 0; k < n; k++)
+	{
+		memcpy(buff + k * bins, in[k]->size, sizeof(in[k]->size));
+		memcpy(buff + k * bins + IOHISTOGRAM_BINS, in[k]->latency, sizeof(in[k]->latency));
+	}
+
+	if (rank == 0)
+	{
+		MPI_Reduce(MPI_IN_PLACE, buff, bins * n, MPI_LONG_LONG, MPI_SUM, 0, IO_WORLD);
+		for (int k = 0; k < n; k++)
+		{
+			memcpy(out[k]->size, buff + k * bins, sizeof(out[k]->size));
+			memcpy(out[k]->latency, buff + k * bins + IOHISTOGRAM_BINS, sizeof(out[k]->latency));
+		}
+	}
+	else
+		MPI_Reduce(buff, NULL, bins * n, MPI_LONG_LONG, MPI_SUM, 0, IO_WORLD);
+
+	free(buff);
+}
@@ -0,0 +1,347 @@
+#include "iokernels.h"
+#if SIMD == 1 && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @file iokernels.cxx
+ * @brief Contains the scalar, AVX2 and AVX-512 kernels and their runtime selection (\e iokernels namespace).
+ */
+
+namespace iokernels
+{
+	//! ----------------------- Helpers ------------------------------
+	static void Init(io_moments &m)
+	{
+		m.n = 0;
+		m.n_zero = 0;
+		m.sum = 0;
+		m.dev = 0;
+		m.dev2 = 0;
+		m.inv = 0;
+		m.w = 0;
+		m.w_inv = 0;
+		m.min = INFINITY;
+		m.max = -INFINITY;
+	}
+
+	// adds the moments of b to a
+	static void Merge(io_moments &a, const io_moments &b)
+	{
+		a.n += b.n;
+		a.n_zero += b.n_zero;
+		a.sum += b.sum;
+		a.dev += b.dev;
+		a.dev2 += b.dev2;
+		a.inv += b.inv;
+		a.w += b.w;
+		a.w_inv += b.w_inv;
+		a.min = (b.min < a.min) ? b.min : a.min;
+		a.max = (b.max > a.max) ? b.max : a.max;
+	}
+
+	//! ----------------------- Scalar ------------------------------
+	template <bool weighted>
+	static void Moments_Scalar(const double *x, const double *w, int n, double shift, io_moments &m)
+	{
+		Init(m);
+		for (int i = 0; i < n; i++)
+		{
+			double v = x[i];
+			if (isnan(v))
+				continue;
+			double d = v - shift;
+			m.n++;
+			m.sum += v;
+			m.dev += d;
+			m.dev2 += d * d;
+			if (weighted)
+				m.w += w[i];
+			if (v == 0)
+				m.n_zero++;
+			else
+			{
+				m.inv += 1 / v;
+				if (weighted)
+					m.w_inv += w[i] / v;
+			}
+			m.min = (v < m.min) ? v : m.min;
+			m.max = (v > m.max) ? v : m.max;
+		}
+	}
+
+	static void Moments_Scalar(const double *x, const double *w, int n, double shift, io_moments &m)
+	{
+		if (w == NULL)
+			Moments_Scalar<false>(x, w, n, shift, m);
+		else
+			Moments_Scalar<true>(x, w, n, shift, m);
+	}
+
+	static double Sum_Scalar(const double *x, int n)
+	{
+		double sum = 0;
+		for (int i = 0; i < n; i++)
+			sum += x[i];
+		return sum;
+	}
+
+#if SIMD == 1 && defined(__x86_64__)
+	//! ----------------------- AVX2 ------------------------------
+	// NaN lanes are cleared with the ordered mask, zero lanes are excluded from the inverse sums
+	template <bool weighted>
+	__attribute__((target("avx2"))) static void Moments_Avx2(const double *x, const double *w, int n, double shift, io_moments &m)
+	{
+		const __m256d zero = _mm256_setzero_pd();
+		const __m256d one = _mm256_set1_pd(1);
+		const __m256d s = _mm256_set1_pd(shift);
+		__m256d sum = zero, dev = zero, dev2 = zero, inv = zero, ws = zero, w_inv = zero;
+		__m256d min = _mm256_set1_pd(INFINITY);
+		__m256d max = _mm256_set1_pd(-INFINITY);
+		long long count = 0;
+		long long zeros = 0;
+
+		int i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256d v = _mm256_loadu_pd(x + i);
+			__m256d ord = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+			__m256d is_zero = _mm256_cmp_pd(v, zero, _CMP_EQ_OQ);
+			__m256d non_zero = _mm256_andnot_pd(is_zero, ord);
+			__m256d d = _mm256_and_pd(_mm256_sub_pd(v, s), ord);
+			__m256d r = _mm256_and_pd(_mm256_div_pd(one, _mm256_blendv_pd(one, v, non_zero)), non_zero);
+
+			sum = _mm256_add_pd(sum, _mm256_and_pd(v, ord));
+			dev = _mm256_add_pd(dev, d);
+			dev2 = _mm256_add_pd(dev2, _mm256_mul_pd(d, d));
+			inv = _mm256_add_pd(inv, r);
+			if (weighted)
+			{
+				__m256d wv = _mm256_loadu_pd(w + i);
+				ws = _mm256_add_pd(ws, _mm256_and_pd(wv, ord));
+				w_inv = _mm256_add_pd(w_inv, _mm256_mul_pd(wv, r));
+			}
+			min = _mm256_min_pd(min, _mm256_blendv_pd(_mm256_set1_pd(INFINITY), v, ord));
+			max = _mm256_max_pd(max, _mm256_blendv_pd(_mm256_set1_pd(-INFINITY), v, ord));
+			count += __builtin_popcount(_mm256_movemask_pd(ord));
+			zeros += __builtin_popcount(_mm256_movemask_pd(is_zero));
+		}
+
+		double lane[8][4];
+		_mm256_storeu_pd(lane[0], sum);
+		_mm256_storeu_pd(lane[1], dev);
+		_mm256_storeu_pd(lane[2], dev2);
+		_mm256_storeu_pd(lane[3], inv);
+		_mm256_storeu_pd(lane[4], ws);
+		_mm256_storeu_pd(lane[5], w_inv);
+		_mm256_storeu_pd(lane[6], min);
+		_mm256_storeu_pd(lane[7], max);
+
+		// remaining values
+		Moments_Scalar(x + i, weighted ? w + i : NULL, n - i, shift, m);
+		m.n += count;
+		m.n_zero += zeros;
+		for (int j = 0; j < 4; j++)
+		{
+			m.sum += lane[0][j];
+			m.dev += lane[1][j];
+			m.dev2 += lane[2][j];
+			m.inv += lane[3][j];
+			m.w += lane[4][j];
+			m.w_inv += lane[5][j];
+			m.min = (lane[6][j] < m.min) ? lane[6][j] : m.min;
+			m.max = (lane[7][j] > m.max) ? lane[7][j] : m.max;
+		}
+	}
+
+	__attribute__((target("avx2"))) static void Moments_Avx2(const double *x, const double *w, int n, double shift, io_moments &m)
+	{
+		if (w == NULL)
+			Moments_Avx2<false>(x, w, n, shift, m);
+		else
+			Moments_Avx2<true>(x, w, n, shift, m);
+	}
+
+	__attribute__((target("avx2"))) static double Sum_Avx2(const double *x, int n)
+	{
+		__m256d a = _mm256_setzero_pd();
+		__m256d b = _mm256_setzero_pd();
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			a = _mm256_add_pd(a, _mm256_loadu_pd(x + i));
+			b = _mm256_add_pd(b, _mm256_loadu_pd(x + i + 4));
+		}
+		double lane[4];
+		_mm256_storeu_pd(lane, _mm256_add_pd(a, b));
+		return lane[0] + lane[1] + lane[2] + lane[3] + Sum_Scalar(x + i, n - i);
+	}
+
+	//! ----------------------- AVX-512 ------------------------------
+	// horizontal reductions over the stored lanes (_mm512_reduce_* triggers a -Wuninitialized false positive in GCC 12)
+	__attribute__((target("avx512f"))) static double Reduce_Add(__m512d a)
+	{
+		double l[8];
+		_mm512_storeu_pd(l, a);
+		return ((l[0] + l[4]) + (l[2] + l[6])) + ((l[1] + l[5]) + (l[3] + l[7]));
+	}
+
+	__attribute__((target("avx512f"))) static double Reduce_Min(__m512d a)
+	{
+		double l[8];
+		_mm512_storeu_pd(l, a);
+		double m = l[0];
+		for (int j = 1; j < 8; j++)
+			m = (l[j] < m) ? l[j] : m;
+		return m;
+	}
+
+	__attribute__((target("avx512f"))) static double Reduce_Max(__m512d a)
+	{
+		double l[8];
+		_mm512_storeu_pd(l, a);
+		double m = l[0];
+		for (int j = 1; j < 8; j++)
+			m = (l[j] > m) ? l[j] : m;
+		return m;
+	}
+
+	// NaN and zero lanes are excluded with mask registers
+	template <bool weighted>
+	__attribute__((target("avx512f"))) static void Moments_Avx512(const double *x, const double *w, int n, double shift, io_moments &m)
+	{
+		const __m512d zero = _mm512_setzero_pd();
+		const __m512d one = _mm512_set1_pd(1);
+		const __m512d s = _mm512_set1_pd(shift);
+		__m512d sum = zero, dev = zero, dev2 = zero, inv = zero, ws = zero, w_inv = zero;
+		__m512d min = _mm512_set1_pd(INFINITY);
+		__m512d max = _mm512_set1_pd(-INFINITY);
+		long long count = 0;
+		long long zeros = 0;
+
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			__m512d v = _mm512_loadu_pd(x + i);
+			__mmask8 ord = _mm512_cmp_pd_mask(v, v, _CMP_ORD_Q);
+			__mmask8 is_zero = _mm512_mask_cmp_pd_mask(ord, v, zero, _CMP_EQ_OQ);
+			__mmask8 non_zero = ord & ~is_zero;
+			__m512d d = _mm512_sub_pd(v, s);
+			__m512d r = _mm512_maskz_div_pd(non_zero, one, v);
+
+			sum = _mm512_mask_add_pd(sum, ord, sum, v);
+			dev = _mm512_mask_add_pd(dev, ord, dev, d);
+			dev2 = _mm512_mask_add_pd(dev2, ord, dev2, _mm512_mul_pd(d, d));
+			inv = _mm512_add_pd(inv, r);
+			if (weighted)
+			{
+				__m512d wv = _mm512_loadu_pd(w + i);
+				ws = _mm512_mask_add_pd(ws, ord, ws, wv);
+				w_inv = _mm512_add_pd(w_inv, _mm512_mul_pd(wv, r));
+			}
+			min = _mm512_mask_min_pd(min, ord, min, v);
+			max = _mm512_mask_max_pd(max, ord, max, v);
+			count += __builtin_popcount(ord);
+			zeros += __builtin_popcount(is_zero);
+		}
+
+		// remaining values
+		Moments_Scalar(x + i, weighted ? w + i : NULL, n - i, shift, m);
+		io_moments v;
+		v.n = count;
+		v.n_zero = zeros;
+		v.sum = Reduce_Add(sum);
+		v.dev = Reduce_Add(dev);
+		v.dev2 = Reduce_Add(dev2);
+		v.inv = Reduce_Add(inv);
+		v.w = Reduce_Add(ws);
+		v.w_inv = Reduce_Add(w_inv);
+		v.min = Reduce_Min(min);
+		v.max = Reduce_Max(max);
+		Merge(m, v);
+	}
+
+	__attribute__((target("avx512f"))) static void Moments_Avx512(const double *x, const double *w, int n, double shift, io_moments &m)
+	{
+		if (w == NULL)
+			Moments_Avx512<false>(x, w, n, shift, m);
+		else
+			Moments_Avx512<true>(x, w, n, shift, m);
+	}
+
+	__attribute__((target("avx512f"))) static double Sum_Avx512(const double *x, int n)
+	{
+		__m512d a = _mm512_setzero_pd();
+		__m512d b = _mm512_setzero_pd();
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			a = _mm512_add_pd(a, _mm512_loadu_pd(x + i));
+			b = _mm512_add_pd(b, _mm512_loadu_pd(x + i + 8));
+		}
+		return Reduce_Add(_mm512_add_pd(a, b)) + Sum_Scalar(x + i, n - i);
+	}
+#endif
+
+	//! ----------------------- Selection ------------------------------
+	//**********************************************************************
+	//*                       1. Get
+	//**********************************************************************
+	/**
+	 * @brief returns the kernels of an instruction set
+	 *
+	 * @param l [in] instruction set
+	 * @return const io_kernels* kernels or NULL if the CPU (or the build) does not support the instruction set
+	 */
+	const io_kernels *Get(level l)
+	{
+		static const io_kernels scalar = {"scalar", Moments_Scalar, Sum_Scalar};
+#if SIMD == 1 && defined(__x86_64__)
+		static const io_kernels avx2 = {"avx2", Moments_Avx2, Sum_Avx2};
+		static const io_kernels avx512 = {"avx512", Moments_Avx512, Sum_Avx512};
+		__builtin_cpu_init();
+		if (l == AVX512)
+			return __builtin_cpu_supports("avx512f") ? &avx512 : NULL;
+		if (l == AVX2)
+			return __builtin_cpu_supports("avx2") ? &avx2 : NULL;
+#endif
+		return (l == SCALAR) ? &scalar : NULL;
+	}
+
+	/**
+	 * @brief returns the kernels of the widest instruction set of the CPU (selected on the first call)
+	 */
+	const io_kernels &Get(void)
+	{
+		static const io_kernels *kernels = Get(AVX512) ? Get(AVX512) : (Get(AVX2) ? Get(AVX2) : Get(SCALAR));
+		return *kernels;
+	}
+
+	//**********************************************************************
+	//*                       2. Moments
+	//**********************************************************************
+	/**
+	 * @brief computes the moments of a buffer in a single pass
+	 *
+	 * @param x [in] values (NaN values are skipped)
+	 * @param w [in] weights of the values (NULL: no weights)
+	 * @param n [in] number of values
+	 * @param shift [in] shift of \e dev and \e dev2 (e.g., the mean or an estimate of it)
+	 * @param m [out] moments
+	 */
+	void Moments(const double *x, const double *w, int n, double shift, io_moments &m)
+	{
+		Get().moments(x, w, n, shift, m);
+	}
+
+	//**********************************************************************
+	//*                       3. Sum
+	//**********************************************************************
+	/**
+	 * @brief sum of a buffer (NaN values are not skipped)
+	 */
+	double Sum(const double *x, int n)
+	{
+		return Get().sum(x, n);
+	}
+}
@@ -16,7 +16,7 @@ namespace ioprint
 	 * @param write_async
 	 * @param io_time
 	 */
-	void Summary(int processes, statistics read_sync, statistics read_async, statistics write_sync, statistics write_async, iotime io_time)
+	void Summary(int processes, const statistics &read_sync, const statistics &read_async, const statistics &write_sync, const statistics &write_async, const iotime &io_time)
 	{
 
 		int values = 142;
@@ -27,6 +27,16 @@ namespace ioprint
 		values += 4 * 12;
 #endif
 
+#if PERCENTILES == 1
+		values += 2 * 6;
+#if SHOW_AVR == 1
+		values += 2 * 2;
+#endif
+#if SHOW_SUM == 1
+		values += 2 * 4;
+#endif
+#endif
+
 #if DO_CALC == 0
 		values -= 6 * 3;
 #if SHOW_AVR == 1
@@ -70,6 +80,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean                           : %.3f MB/s\n", GREEN, CYAN, BLACK, read_async.throughput.rank_metric.avr.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Arithmetic mean                         : %.3f MB/s\n", GREEN, CYAN, BLACK, read_async.throughput.rank_metric.avr.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Median                                  : %.3f MB/s\n", GREEN, CYAN, BLACK, read_async.throughput.rank_metric.avr.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s|%s 90th percentile                         : %.3f MB/s\n", GREEN, CYAN, BLACK, read_async.throughput.rank_metric.avr.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s|%s 99th percentile                         : %.3f MB/s\n", GREEN, CYAN, BLACK, read_async.throughput.rank_metric.avr.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s|%s Max                                     : %.3f MB/s\n", GREEN, CYAN, BLACK, read_async.throughput.rank_metric.avr.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Min                                     : %.3f MB/s\n", GREEN, CYAN, BLACK, read_async.throughput.rank_metric.avr.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean x ranks                   : %.3f MB/s\n", GREEN, CYAN, BLACK, read_async.procs_io * read_async.throughput.rank_metric.avr.hmean / 1'000'000);
@@ -85,6 +99,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s| %s|%s Harmonic mean                         : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, read_async.throughput.rank_metric.sum.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Arithmetic mean                       : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, read_async.throughput.rank_metric.sum.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Median                                : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, read_async.throughput.rank_metric.sum.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s| %s|%s 90th percentile                       : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, read_async.throughput.rank_metric.sum.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s| %s|%s 99th percentile                       : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, read_async.throughput.rank_metric.sum.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s| %s|%s Max                                   : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, read_async.throughput.rank_metric.sum.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Min                                   : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, read_async.throughput.rank_metric.sum.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Harmonic mean x ranks                 : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, read_async.procs_io * read_async.throughput.rank_metric.sum.hmean / 1'000'000);
@@ -108,6 +126,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean                           : %.3f MB/s\n", GREEN, RED, BLACK, read_async.bandwidth.rank_metric.sum.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Arithmetic mean                         : %.3f MB/s\n", GREEN, RED, BLACK, read_async.bandwidth.rank_metric.sum.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Median                                  : %.3f MB/s\n", GREEN, RED, BLACK, read_async.bandwidth.rank_metric.sum.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s|%s 90th percentile                         : %.3f MB/s\n", GREEN, RED, BLACK, read_async.bandwidth.rank_metric.sum.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s|%s 99th percentile                         : %.3f MB/s\n", GREEN, RED, BLACK, read_async.bandwidth.rank_metric.sum.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s|%s Max                                     : %.3f MB/s\n", GREEN, RED, BLACK, read_async.bandwidth.rank_metric.sum.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Min                                     : %.3f MB/s\n", GREEN, RED, BLACK, read_async.bandwidth.rank_metric.sum.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean x ranks                   : %.3f MB/s\n", GREEN, RED, BLACK, read_async.procs_io * read_async.bandwidth.rank_metric.sum.hmean / 1'000'000);
@@ -123,6 +145,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s| %s|%s Harmonic mean                         : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, read_async.bandwidth.rank_metric.avr.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Arithmetic mean                       : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, read_async.bandwidth.rank_metric.avr.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Median                                : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, read_async.bandwidth.rank_metric.avr.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s| %s|%s 90th percentile                       : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, read_async.bandwidth.rank_metric.avr.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s| %s|%s 99th percentile                       : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, read_async.bandwidth.rank_metric.avr.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s| %s|%s Max                                   : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, read_async.bandwidth.rank_metric.avr.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Min                                   : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, read_async.bandwidth.rank_metric.avr.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Harmonic mean x ranks                 : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, read_async.procs_io * read_async.bandwidth.rank_metric.avr.hmean / 1'000'000);
@@ -156,6 +182,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s|%s Harmonic mean                             : %.3f MB/s\n", GREEN, BLACK, read_sync.throughput.rank_metric.avr.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s|%s Arithmetic mean                           : %.3f MB/s\n", GREEN, BLACK, read_sync.throughput.rank_metric.avr.amean / 1'000'000);
 		sprintf(out[counter++], "| %s|%s Median                                    : %.3f MB/s\n", GREEN, BLACK, read_sync.throughput.rank_metric.avr.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s|%s 90th percentile                           : %.3f MB/s\n", GREEN, BLACK, read_sync.throughput.rank_metric.avr.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s|%s 99th percentile                           : %.3f MB/s\n", GREEN, BLACK, read_sync.throughput.rank_metric.avr.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s|%s Max                                       : %.3f MB/s\n", GREEN, BLACK, read_sync.throughput.rank_metric.avr.max / 1'000'000);
 		sprintf(out[counter++], "| %s|%s Min                                       : %.3f MB/s\n", GREEN, BLACK, read_sync.throughput.rank_metric.avr.min / 1'000'000);
 		sprintf(out[counter++], "| %s|%s Harmonic mean x ranks                     : %.3f MB/s\n", GREEN, BLACK, read_sync.procs_io * read_sync.throughput.rank_metric.avr.hmean / 1'000'000);
@@ -171,6 +201,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean                           : %.3f MB/s\n", GREEN, BLUE, BLACK, read_sync.throughput.rank_metric.sum.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Arithmetic mean                         : %.3f MB/s\n", GREEN, BLUE, BLACK, read_sync.throughput.rank_metric.sum.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Median                                  : %.3f MB/s\n", GREEN, BLUE, BLACK, read_sync.throughput.rank_metric.sum.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s|%s 90th percentile                         : %.3f MB/s\n", GREEN, BLUE, BLACK, read_sync.throughput.rank_metric.sum.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s|%s 99th percentile                         : %.3f MB/s\n", GREEN, BLUE, BLACK, read_sync.throughput.rank_metric.sum.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s|%s Max                                     : %.3f MB/s\n", GREEN, BLUE, BLACK, read_sync.throughput.rank_metric.sum.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Min                                     : %.3f MB/s\n", GREEN, BLUE, BLACK, read_sync.throughput.rank_metric.sum.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean x ranks                   : %.3f MB/s\n", GREEN, BLUE, BLACK, read_sync.procs_io * read_sync.throughput.rank_metric.sum.hmean / 1'000'000);
@@ -207,6 +241,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean                           : %.3f MB/s\n", GREEN, CYAN, BLACK, write_async.throughput.rank_metric.avr.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Arithmetic mean                         : %.3f MB/s\n", GREEN, CYAN, BLACK, write_async.throughput.rank_metric.avr.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Median                                  : %.3f MB/s\n", GREEN, CYAN, BLACK, write_async.throughput.rank_metric.avr.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s|%s 90th percentile                         : %.3f MB/s\n", GREEN, CYAN, BLACK, write_async.throughput.rank_metric.avr.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s|%s 99th percentile                         : %.3f MB/s\n", GREEN, CYAN, BLACK, write_async.throughput.rank_metric.avr.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s|%s Max                                     : %.3f MB/s\n", GREEN, CYAN, BLACK, write_async.throughput.rank_metric.avr.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Min                                     : %.3f MB/s\n", GREEN, CYAN, BLACK, write_async.throughput.rank_metric.avr.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean x ranks                   : %.3f MB/s\n", GREEN, CYAN, BLACK, write_async.procs_io * write_async.throughput.rank_metric.avr.hmean / 1'000'000);
@@ -222,6 +260,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s| %s|%s Harmonic mean                         : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, write_async.throughput.rank_metric.sum.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Arithmetic mean                       : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, write_async.throughput.rank_metric.sum.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Median                                : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, write_async.throughput.rank_metric.sum.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s| %s|%s 90th percentile                       : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, write_async.throughput.rank_metric.sum.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s| %s|%s 99th percentile                       : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, write_async.throughput.rank_metric.sum.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s| %s|%s Max                                   : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, write_async.throughput.rank_metric.sum.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Min                                   : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, write_async.throughput.rank_metric.sum.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Harmonic mean x ranks                 : %.3f MB/s\n", GREEN, CYAN, BLUE, BLACK, write_async.procs_io * write_async.throughput.rank_metric.sum.hmean / 1'000'000);
@@ -245,6 +287,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean                           : %.3f MB/s\n", GREEN, RED, BLACK, write_async.bandwidth.rank_metric.sum.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Arithmetic mean                         : %.3f MB/s\n", GREEN, RED, BLACK, write_async.bandwidth.rank_metric.sum.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Median                                  : %.3f MB/s\n", GREEN, RED, BLACK, write_async.bandwidth.rank_metric.sum.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s|%s 90th percentile                         : %.3f MB/s\n", GREEN, RED, BLACK, write_async.bandwidth.rank_metric.sum.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s|%s 99th percentile                         : %.3f MB/s\n", GREEN, RED, BLACK, write_async.bandwidth.rank_metric.sum.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s|%s Max                                     : %.3f MB/s\n", GREEN, RED, BLACK, write_async.bandwidth.rank_metric.sum.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Min                                     : %.3f MB/s\n", GREEN, RED, BLACK, write_async.bandwidth.rank_metric.sum.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean x ranks                   : %.3f MB/s\n", GREEN, RED, BLACK, write_async.procs_io * write_async.bandwidth.rank_metric.sum.hmean / 1'000'000);
@@ -260,6 +306,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s| %s|%s Harmonic mean                         : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, write_async.bandwidth.rank_metric.avr.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Arithmetic mean                       : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, write_async.bandwidth.rank_metric.avr.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Median                                : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, write_async.bandwidth.rank_metric.avr.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s| %s|%s 90th percentile                       : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, write_async.bandwidth.rank_metric.avr.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s| %s|%s 99th percentile                       : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, write_async.bandwidth.rank_metric.avr.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s| %s|%s Max                                   : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, write_async.bandwidth.rank_metric.avr.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Min                                   : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, write_async.bandwidth.rank_metric.avr.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s| %s|%s Harmonic mean x ranks                 : %.3f MB/s\n", GREEN, RED, BLUE, BLACK, write_async.procs_io * write_async.bandwidth.rank_metric.avr.hmean / 1'000'000);
@@ -293,6 +343,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s|%s Harmonic mean                             : %.3f MB/s\n", GREEN, BLACK, write_sync.throughput.rank_metric.avr.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s|%s Arithmetic mean                           : %.3f MB/s\n", GREEN, BLACK, write_sync.throughput.rank_metric.avr.amean / 1'000'000);
 		sprintf(out[counter++], "| %s|%s Median                                    : %.3f MB/s\n", GREEN, BLACK, write_sync.throughput.rank_metric.avr.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s|%s 90th percentile                           : %.3f MB/s\n", GREEN, BLACK, write_sync.throughput.rank_metric.avr.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s|%s 99th percentile                           : %.3f MB/s\n", GREEN, BLACK, write_sync.throughput.rank_metric.avr.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s|%s Max                                       : %.3f MB/s\n", GREEN, BLACK, write_sync.throughput.rank_metric.avr.max / 1'000'000);
 		sprintf(out[counter++], "| %s|%s Min                                       : %.3f MB/s\n", GREEN, BLACK, write_sync.throughput.rank_metric.avr.min / 1'000'000);
 		sprintf(out[counter++], "| %s|%s Harmonic mean x ranks                     : %.3f MB/s\n", GREEN, BLACK, write_sync.procs_io * write_sync.throughput.rank_metric.avr.hmean / 1'000'000);
@@ -308,6 +362,10 @@ namespace ioprint
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean                           : %.3f MB/s\n", GREEN, BLUE, BLACK, write_sync.throughput.rank_metric.sum.hmean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Arithmetic mean                         : %.3f MB/s\n", GREEN, BLUE, BLACK, write_sync.throughput.rank_metric.sum.amean / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Median                                  : %.3f MB/s\n", GREEN, BLUE, BLACK, write_sync.throughput.rank_metric.sum.median / 1'000'000);
+#if PERCENTILES == 1
+		sprintf(out[counter++], "| %s| %s|%s 90th percentile                         : %.3f MB/s\n", GREEN, BLUE, BLACK, write_sync.throughput.rank_metric.sum.p90 / 1'000'000);
+		sprintf(out[counter++], "| %s| %s|%s 99th percentile                         : %.3f MB/s\n", GREEN, BLUE, BLACK, write_sync.throughput.rank_metric.sum.p99 / 1'000'000);
+#endif
 		sprintf(out[counter++], "| %s| %s|%s Max                                     : %.3f MB/s\n", GREEN, BLUE, BLACK, write_sync.throughput.rank_metric.sum.max / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Min                                     : %.3f MB/s\n", GREEN, BLUE, BLACK, write_sync.throughput.rank_metric.sum.min / 1'000'000);
 		sprintf(out[counter++], "| %s| %s|%s Harmonic mean x ranks                   : %.3f MB/s\n", GREEN, BLUE, BLACK, write_sync.procs_io * write_sync.throughput.rank_metric.sum.hmean / 1'000'000);
@@ -346,30 +404,19 @@ namespace ioprint
 	 * @param write_async
 	 * @param io_time
 	 */
-	void Jsonl(int processes, statistics read_sync, statistics read_async, statistics write_sync, statistics write_async, iotime io_time)
+	void Jsonl(int processes, const statistics &read_sync, const statistics &read_async, const statistics &write_sync, const statistics &write_async, const iotime &io_time)
 	{
-		std::ofstream file;
 		static bool first_time = true;
-		if (first_time)
-		{
-			file.open(std::to_string(processes) + ".jsonl");
-			first_time = false;
-		}
-		else
-		{
-			file.open(std::to_string(processes) + ".jsonl", std::ios_base::app);
-		}
+		IOwriter file(std::to_string(processes) + ".jsonl", !first_time);
+		first_time = false;
 
-		std::string print = Format_Json(read_sync, "read_sync", false, true);
-		print.append(Format_Json(read_async, "read_async_t", false, true));
-		print.append(Format_Json(read_async, "read_async_b", true, true));
-		print.append(Format_Json(write_async, "write_async_t", false, true));
-		print.append(Format_Json(write_async, "write_async_b", true, true));
-		print.append(Format_Json(write_sync, "write_sync", false, true));
-		print.append(io_time.Print_Json(true));
-		file << print << std::flush;
-		file.flush();
-		file.close();
+		Format_Json(file, read_sync, "read_sync", false, true);
+		Format_Json(file, read_async, "read_async_t", false, true);
+		Format_Json(file, read_async, "read_async_b", true, true);
+		Format_Json(file, write_async, "write_async_t", false, true);
+		Format_Json(file, write_async, "write_async_b", true, true);
+		Format_Json(file, write_sync, "write_sync", false, true);
+		file.Append(io_time.Print_Json(true));
 	}
 
 	//**********************************************************************
@@ -385,29 +432,36 @@ namespace ioprint
 	 * @param write_async
 	 * @param io_time
 	 */
-	void Json(int processes, statistics read_sync, statistics read_async, statistics write_sync, statistics write_async, iotime io_time)
+	void Json(int processes, const statistics &read_sync, const statistics &read_async, const statistics &write_sync, const statistics &write_async, const iotime &io_time)
 	{
-		std::ofstream file;
-		file.open(std::to_string(processes) + ".json");
-		file << "{\n";
-		std::string print = Format_Json(read_sync, "read_sync");
-		print.append(Format_Json(read_async, "read_async_t"));
-		print.append(Format_Json(read_async, "read_async_b", true));
-		print.append(Format_Json(write_async, "write_async_t"));
-		print.append(Format_Json(write_async, "write_async_b", true));
-		// print.append(Format_Json(write_sync, "write_sync", ""));
-		print.append(Format_Json(write_sync, "write_sync"));
-		print.append(io_time.Print_Json());
-		print.append("}\n");
-		file << print;
-		file.close();
+		IOwriter file(std::to_string(processes) + ".json");
+		file.Append("{\n");
+		Format_Json(file, read_sync, "read_sync");
+		Format_Json(file, read_async, "read_async_t");
+		Format_Json(file, read_async, "read_async_b", true);
+		Format_Json(file, write_async, "write_async_t");
+		Format_Json(file, write_async, "write_async_b", true);
+		// Format_Json(file, write_sync, "write_sync", "");
+		Format_Json(file, write_sync, "write_sync");
+		file.Append(io_time.Print_Json());
+		file.Append("}\n");
 	}
 
-	std::string Format_Json(statistics data, std::string mode, bool req, bool jsonl)
+	//**********************************************************************
+	//*                       3. Format_Json
+	//**********************************************************************
+	/**
+	 * @brief writes the statistics of a mode as a json (or jsonl) object
+	 *
+	 * @param out [in,out] writer
+	 * @param data [in] statistics of the mode
+	 * @param mode [in] name of the mode
+	 * @param req [in] required (true) or actual (false) values
+	 * @param jsonl [in] print in jsonl format
+	 */
+	void Format_Json(IOwriter &out, const statistics &data, std::string mode, bool req, bool jsonl)
 	{
-		char buff[27][50];
-		std::string out;
-		int counter = 0;
+		const io_config &cfg = ioconfig::Get();
 		char line_start[2] = {'\0', '\0'};
 		char line_end[2] = {'\0', '\0'};
 		double unit_scale = 1; // in Bytes or Bytes/s ;
@@ -417,45 +471,56 @@ namespace ioprint
 			line_start[0] = '\t';
 		}
 		if (jsonl == true)
-			sprintf(buff[counter++], "\t{\"%s\":{%s", mode.c_str(), line_end);
+			out.Format("\t{\"%s\":{%s", mode.c_str(), line_end);
 		else
-			sprintf(buff[counter++], "\t\"%s\":{%s", mode.c_str(), line_end);
-		sprintf(buff[counter++], "%s\"total_bytes\": %.2e,%s", line_start, data.agg_bytes * unit_scale, line_end);
-		sprintf(buff[counter++], "%s\"max_bytes_per_rank\": %.2e,%s", line_start, data.max_bytes * unit_scale, line_end);
-		// sprintf(buff[counter++], "%s\"max_offset_over_ranks\": %.2e,%s",line_start ,data.max_offset*unit_scale, line_end);
-		sprintf(buff[counter++], "%s\"max_bytes_per_phase\": %.2e,%s", line_start, data.max_bytes_phase * unit_scale, line_end);
-		sprintf(buff[counter++], "%s\"max_io_phases_per_rank\": %i,%s", line_start, data.max_phases, line_end);
-		sprintf(buff[counter++], "%s\"total_io_phases\": %i,%s", line_start, data.agg_phases, line_end);
-		sprintf(buff[counter++], "%s\"max_io_ops_in_phase\": %lli,%s", line_start, data.max_ops, line_end);
-		sprintf(buff[counter++], "%s\"max_io_ops_per_rank\": %lli,%s", line_start, data.max_ops_rank, line_end);
-		sprintf(buff[counter++], "%s\"total_io_ops\": %lli,%s", line_start, data.agg_ops, line_end);
-		sprintf(buff[counter++], "%s\"number_of_ranks\": %i,%s", line_start, data.procs_io, line_end);
-		sprintf(buff[counter++], "%s\"bandwidth\": {%s", line_start, line_end);
+			out.Format("\t\"%s\":{%s", mode.c_str(), line_end);
+		out.Format("%s\"total_bytes\": %.2e,%s", line_start, data.agg_bytes * unit_scale, line_end);
+		out.Format("%s\"max_bytes_per_rank\": %.2e,%s", line_start, data.max_bytes * unit_scale, line_end);
+		// out.Format("%s\"max_offset_over_ranks\": %.2e,%s",line_start ,data.max_offset*unit_scale, line_end);
+		out.Format("%s\"max_bytes_per_phase\": %.2e,%s", line_start, data.max_bytes_phase * unit_scale, line_end);
+		out.Format("%s\"max_io_phases_per_rank\": %i,%s", line_start, data.max_phases, line_end);
+		out.Format("%s\"total_io_phases\": %i,%s", line_start, data.agg_phases, line_end);
+		out.Format("%s\"max_io_ops_in_phase\": %lli,%s", line_start, data.max_ops, line_end);
+		out.Format("%s\"max_io_ops_per_rank\": %lli,%s", line_start, data.max_ops_rank, line_end);
+		out.Format("%s\"total_io_ops\": %lli,%s", line_start, data.agg_ops, line_end);
+#if MEMORY_CAP > 0
+		out.Format("%s\"dropped_samples\": %lli,%s", line_start, (req) ? data.dropped_req : data.dropped_act, line_end);
+#endif
+		out.Format("%s\"number_of_ranks\": %i,%s", line_start, data.procs_io, line_end);
+		out.Format("%s\"bandwidth\": {%s", line_start, line_end);
 		// FIXME show these only for exact
-		sprintf(buff[counter++], "%s%s\"weighted_harmonic_mean\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.whmean * unit_scale : data.throughput.rank_metric.avr.whmean * unit_scale, line_end);
-		sprintf(buff[counter++], "%s%s\"harmonic_mean\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.hmean * unit_scale : data.throughput.rank_metric.avr.hmean * unit_scale, line_end);
-		sprintf(buff[counter++], "%s%s\"arithmetic_mean\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.amean * unit_scale : data.throughput.rank_metric.avr.amean * unit_scale, line_end);
-		sprintf(buff[counter++], "%s%s\"median\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.median * unit_scale : data.throughput.rank_metric.avr.median * unit_scale, line_end);
-		sprintf(buff[counter++], "%s%s\"max\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.max * unit_scale : data.throughput.rank_metric.avr.max * unit_scale, line_end);
-		sprintf(buff[counter++], "%s%s\"min\": %.2e", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.min * unit_scale : data.throughput.rank_metric.avr.min * unit_scale);
+		out.Format("%s%s\"weighted_harmonic_mean\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.whmean * unit_scale : data.throughput.rank_metric.avr.whmean * unit_scale, line_end);
+		out.Format("%s%s\"harmonic_mean\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.hmean * unit_scale : data.throughput.rank_metric.avr.hmean * unit_scale, line_end);
+		out.Format("%s%s\"arithmetic_mean\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.amean * unit_scale : data.throughput.rank_metric.avr.amean * unit_scale, line_end);
+		out.Format("%s%s\"median\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.median * unit_scale : data.throughput.rank_metric.avr.median * unit_scale, line_end);
+#if PERCENTILES == 1
+		out.Format("%s%s\"p90\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.p90 * unit_scale : data.throughput.rank_metric.avr.p90 * unit_scale, line_end);
+		out.Format("%s%s\"p99\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.p99 * unit_scale : data.throughput.rank_metric.avr.p99 * unit_scale, line_end);
+#endif
+		out.Format("%s%s\"max\": %.2e,%s", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.max * unit_scale : data.throughput.rank_metric.avr.max * unit_scale, line_end);
+		out.Format("%s%s\"min\": %.2e", line_start, line_start, (req) ? data.bandwidth.rank_metric.sum.min * unit_scale : data.throughput.rank_metric.avr.min * unit_scale);
 #if DO_CALC > 0
-		sprintf(buff[counter++], ",%s%s%s\"app\": %.2e", line_end, line_start, line_start, (req) ? data.bandwidth.app_metric.sum.max * unit_scale : data.throughput.app_metric.avr.max * unit_scale);
-		sprintf(buff[counter++], ",%s%s%s\"appH\": %.2e", line_end, line_start, line_start, (req) ? data.bandwidth.app_metric.sum.hmean * unit_scale : data.throughput.app_metric.avr.hmean * unit_scale);
+		out.Format(",%s%s%s\"app\": %.2e", line_end, line_start, line_start, (req) ? data.bandwidth.app_metric.sum.max * unit_scale : data.throughput.app_metric.avr.max * unit_scale);
+		out.Format(",%s%s%s\"appH\": %.2e", line_end, line_start, line_start, (req) ? data.bandwidth.app_metric.sum.hmean * unit_scale : data.throughput.app_metric.avr.hmean * unit_scale);
 // #else
 // values -=2;
 #endif
 		if (req)
 		{
 #if SHOW_AVR == 1
-			sprintf(buff[counter++], ",%s%s%s\"weighted_avr_harmonic_mean\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.whmean * unit_scale);
-			sprintf(buff[counter++], ",%s%s%s\"harmonic_avr_mean\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.hmean * unit_scale);
-			sprintf(buff[counter++], ",%s%s%s\"arithmetic_avr_mean\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.amean * unit_scale);
-			sprintf(buff[counter++], ",%s%s%s\"median_avr\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.median * unit_scale);
-			sprintf(buff[counter++], ",%s%s%s\"max_avr\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.max * unit_scale);
-			sprintf(buff[counter++], ",%s%s%s\"min_avr\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.min * unit_scale);
+			out.Format(",%s%s%s\"weighted_avr_harmonic_mean\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.whmean * unit_scale);
+			out.Format(",%s%s%s\"harmonic_avr_mean\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.hmean * unit_scale);
+			out.Format(",%s%s%s\"arithmetic_avr_mean\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.amean * unit_scale);
+			out.Format(",%s%s%s\"median_avr\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.median * unit_scale);
+#if PERCENTILES == 1
+			out.Format(",%s%s%s\"p90_avr\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.p90 * unit_scale);
+			out.Format(",%s%s%s\"p99_avr\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.p99 * unit_scale);
+#endif
+			out.Format(",%s%s%s\"max_avr\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.max * unit_scale);
+			out.Format(",%s%s%s\"min_avr\": %.2e", line_end, line_start, line_start, data.throughput.rank_metric.avr.min * unit_scale);
 #if DO_CALC > 0
-			sprintf(buff[counter++], ",%s%s%s\"app_avr\": %.2e", line_end, line_start, line_start, data.throughput.app_metric.avr.max * unit_scale);
-			sprintf(buff[counter++], ",%s%s%s\"appH_avr\": %.2e", line_end, line_start, line_start, data.throughput.app_metric.avr.hmean * unit_scale);
+			out.Format(",%s%s%s\"app_avr\": %.2e", line_end, line_start, line_start, data.throughput.app_metric.avr.max * unit_scale);
+			out.Format(",%s%s%s\"appH_avr\": %.2e", line_end, line_start, line_start, data.throughput.app_metric.avr.hmean * unit_scale);
 // #else
 // values -=2;
 #endif
@@ -466,15 +531,15 @@ namespace ioprint
 		else
 		{
 #if SHOW_SUM == 1
-			sprintf(buff[counter++], ",%s%s%S\"weighted_sum_harmonic_mean\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.whmean * unit_scale);
-			sprintf(buff[counter++], ",%s%s%S\"harmonic_sum_mean\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.hmean * unit_scale);
-			sprintf(buff[counter++], ",%s%s%S\"arithmetic_sum_mean\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.amean * unit_scale);
-			sprintf(buff[counter++], ",%s%s%S\"median_sum\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.median * unit_scale);
-			sprintf(buff[counter++], ",%s%s%S\"max_sum\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.max * unit_scale);
-			sprintf(buff[counter++], ",%s%s%S\"min_sum\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.min * unit_scale);
+			out.Format(",%s%s%S\"weighted_sum_harmonic_mean\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.whmean * unit_scale);
+			out.Format(",%s%s%S\"harmonic_sum_mean\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.hmean * unit_scale);
+			out.Format(",%s%s%S\"arithmetic_sum_mean\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.amean * unit_scale);
+			out.Format(",%s%s%S\"median_sum\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.median * unit_scale);
+			out.Format(",%s%s%S\"max_sum\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.max * unit_scale);
+			out.Format(",%s%s%S\"min_sum\": %.2e", line_end, line_start, line_start data.bandwidth.rank_metric.sum.min * unit_scale);
 #if DO_CALC > 0
-			sprintf(buff[counter++], ",%s%s%S\"app_sum\": %.2e", line_end, line_start, line_start data.bandwidth.app_metric.sum.max * unit_scale);
-			sprintf(buff[counter++], ",%s%s%S\"appH_sum\": %.2e", line_end, line_start, line_start data.bandwidth.app_metric.sum.hmean * unit_scale);
+			out.Format(",%s%s%S\"app_sum\": %.2e", line_end, line_start, line_start data.bandwidth.app_metric.sum.max * unit_scale);
+			out.Format(",%s%s%S\"appH_sum\": %.2e", line_end, line_start, line_start data.bandwidth.app_metric.sum.hmean * unit_scale);
 // #else
 // values -=2;
 #endif
@@ -483,110 +548,378 @@ namespace ioprint
 #endif
 		}
 
-		for (int i = 0; i < counter; i++)
-			out.append(buff[i]);
-
 		// print b to output string
 		int n = (data.max_ops > 10) ? 5 : data.max_ops;
 		n = (data.max_ops == 1) ? data.procs_io : data.max_ops;
 
 #if ALL_SAMPLES > 0 && DO_CALC > 0
-		std::string tmp_0;
-		std::string tmp_1;
-		std::string tmp_2;
 		if (req)
 		{
 
-			tmp_0 = Print_Series(data.bandwidth_sum_phase, data.phase_overlap_req.size(), unit_scale, n, "\"b_overlap_sum\": [", "]", jsonl);
-			tmp_1 = Print_Series(data.bandwidth_avr_phase, data.phase_overlap_req.size(), unit_scale, n, "\"b_overlap_avr\": [", "]", jsonl);
-			tmp_2 = Print_Series(data.n_overlap_req, data.phase_overlap_req.size(), 1, n, "\"n_overlap\": [", "]", jsonl);
+			Print_Series(out, data.bandwidth_sum_phase.get(), data.overlap_req.Size(), unit_scale, n, "\"b_overlap_sum\": [", "]", jsonl);
+			Print_Series(out, data.bandwidth_avr_phase.get(), data.overlap_req.Size(), unit_scale, n, "\"b_overlap_avr\": [", "]", jsonl);
+			Print_Series(out, data.n_overlap_req.get(), data.overlap_req.Size(), 1, n, "\"n_overlap\": [", "]", jsonl);
 		}
 		else
 		{
-			tmp_0 = Print_Series(data.throughput_sum_phase, data.phase_overlap_act.size(), unit_scale, n, "\"b_overlap_sum\": [", "]", jsonl);
-			tmp_1 = Print_Series(data.throughput_avr_phase, data.phase_overlap_act.size(), unit_scale, n, "\"b_overlap_avr\": [", "]", jsonl);
-			tmp_2 = Print_Series(data.n_overlap_act, data.phase_overlap_act.size(), 1, n, "\"n_overlap\": [", "]", jsonl);
+			Print_Series(out, data.throughput_sum_phase.get(), data.overlap_act.Size(), unit_scale, n, "\"b_overlap_sum\": [", "]", jsonl);
+			Print_Series(out, data.throughput_avr_phase.get(), data.overlap_act.Size(), unit_scale, n, "\"b_overlap_avr\": [", "]", jsonl);
+			Print_Series(out, data.n_overlap_act.get(), data.overlap_act.Size(), 1, n, "\"n_overlap\": [", "]", jsonl);
 		}
-		out.append(tmp_0);
-		out.append(tmp_1);
-		out.append(tmp_2);
 #endif
 
 #if ALL_SAMPLES > 1 && DO_CALC > 0
-		std::string tmp_4;
 		if (req)
-			tmp_4 = Print_Series(&(data.phase_time_req[0]), data.phase_time_req.size(), 1, n, "\"t_overlap\": [", "]", jsonl);
+			Print_Series(out, data.overlap_req.time.data(), data.overlap_req.time.size(), 1, n, "\"t_overlap\": [", "]", jsonl);
 		else
-			tmp_4 = Print_Series(&(data.phase_time_act[0]), data.phase_time_act.size(), 1, n, "\"t_overlap\": [", "]", jsonl);
-		out.append(tmp_4);
+			Print_Series(out, data.overlap_act.time.data(), data.overlap_act.time.size(), 1, n, "\"t_overlap\": [", "]", jsonl);
 #endif
 
-#if ALL_SAMPLES > 2
-		std::string tmp_5;
-		if (req)
+		if (cfg.all_samples > 2)
 		{
-			tmp_5 = Print_Series(data.all_data, "B_sum", data.agg_phases, unit_scale, n, "\"b_rank_sum\": [", "]", jsonl);
-			// #if SHOW_AVR == 1
-			tmp_5 = tmp_5 + Print_Series(data.all_data, "B_avr", data.agg_phases, unit_scale, n, "\"b_rank_avr\": [", "]", jsonl);
-			// #endif
+			if (req)
+			{
+				Print_Series(out, data.all_data, FIELD_B_SUM, data.agg_phases, unit_scale, n, "\"b_rank_sum\": [", "]", jsonl);
+				// #if SHOW_AVR == 1
+				Print_Series(out, data.all_data, FIELD_B_AVR, data.agg_phases, unit_scale, n, "\"b_rank_avr\": [", "]", jsonl);
+				// #endif
+			}
+			else
+			{
+				Print_Series(out, data.all_data, FIELD_T_AVR, data.agg_phases, unit_scale, n, "\"b_rank_avr\": [", "]", jsonl);
+				// #if SHOW_SUM == 1
+				Print_Series(out, data.all_data, FIELD_T_SUM, data.agg_phases, unit_scale, n, "\"b_rank_sum\": [", "]", jsonl);
+				// #endif
+			}
 		}
-		else
+
+		if (cfg.all_samples > 3)
 		{
-			tmp_5 = Print_Series(data.all_data, "T_avr", data.agg_phases, unit_scale, n, "\"b_rank_avr\": [", "]", jsonl);
-			// #if SHOW_SUM == 1
-			tmp_5 = tmp_5 + Print_Series(data.all_data, "T_sum", data.agg_phases, unit_scale, n, "\"b_rank_sum\": [", "]", jsonl);
-			// #endif
+			if (req)
+			{
+				Print_Series(out, data.all_data, FIELD_T_START, data.agg_phases, 1, n, "\"t_rank_s\": [", "]", jsonl);
+				Print_Series(out, data.all_data, FIELD_T_END_REQ, data.agg_phases, 1, n, "\"t_rank_e\": [", "]", jsonl);
+			}
+			else
+			{
+				Print_Series(out, data.all_data, FIELD_T_START, data.agg_phases, 1, n, "\"t_rank_s\": [", "]", jsonl);
+				Print_Series(out, data.all_data, FIELD_T_END_ACT, data.agg_phases, 1, n, "\"t_rank_e\": [", "]", jsonl);
+			}
 		}
-		out.append(tmp_5);
-// #else
-//                 out.append("\t\t\"b\": []");
-#endif
 
-#if ALL_SAMPLES > 3
-		std::string tmp_6;
-		std::string tmp_7;
-		if (req)
+		if (cfg.all_samples > 4 && !cfg.parallel_output)
 		{
-			tmp_6 = Print_Series(data.all_data, "t_start", data.agg_phases, 1, n, "\"t_rank_s\": [", "]", jsonl);
-			tmp_7 = Print_Series(data.all_data, "t_end_req", data.agg_phases, 1, n, "\"t_rank_e\": [", "]", jsonl);
+			if (req)
+			{
+				Print_Series(out, data.all_b.get(), data.agg_samples_req, unit_scale, n, "\"b_ind\": [", "]", jsonl);
+				Print_Series(out, data.all_t_req_s.get(), data.agg_samples_req, 1, n, "\"t_ind_s\": [", "]", jsonl);
+				Print_Series(out, data.all_t_req_e.get(), data.agg_samples_req, 1, n, "\"t_ind_e\": [", "]", jsonl);
+			}
+			else
+			{
+				Print_Series(out, data.all_t.get(), data.agg_samples_act, unit_scale, n, "\"b_ind\": [", "]", jsonl);
+				Print_Series(out, data.all_t_act_s.get(), data.agg_samples_act, 1, n, "\"t_ind_s\": [", "]", jsonl);
+				Print_Series(out, data.all_t_act_e.get(), data.agg_samples_act, 1, n, "\"t_ind_e\": [", "]", jsonl);
+			}
 		}
+
+		if (cfg.histogram && !req)
+		{
+			Print_Histogram(out, data.hist.size, 1, "\"size_histogram\":", jsonl);
+			Print_Histogram(out, data.hist.latency, 1e-9, "\"latency_histogram\":", jsonl);
+		}
+
+		if (cfg.sketch)
+		{
+			if (req)
+				Print_Percentiles(out, data.sketch_b, unit_scale, "\"b_ind_percentiles\":", jsonl);
+			else
+			{
+				Print_Percentiles(out, data.sketch_t, unit_scale, "\"b_ind_percentiles\":", jsonl);
+				Print_Percentiles(out, data.sketch_l, 1, "\"latency_ind_percentiles\":", jsonl);
+			}
+		}
+
+		if (jsonl == true)
+			out.Append("}}}\n");
 		else
+			out.Append("\n\t\t}\n\t\t},\n\n");
+	}
+
+	//**********************************************************************
+	//*                       4. Format_Columns
+	//**********************************************************************
+	/**
+	 * @brief adds the statistics of a mode as columns of the binary format (see iocolumns_reader.h). The names
+	 * follow the json keys ("<mode>/<key>" and "<mode>/bandwidth/<key>"). The fields of the phases (collect) are
+	 * added once per statistics, i.e., only for the actual mode
+	 *
+	 * @param out [in,out] columns
+	 * @param data [in] statistics of the mode
+	 * @param mode [in] name of the mode
+	 * @param req [in] required (true) or actual (false) values
+	 */
+	void Format_Columns(IOcolumns &out, const statistics &data, std::string mode, bool req)
+	{
+		const io_config &cfg = ioconfig::Get();
+		const core_rank_metrics &rank = (req) ? data.bandwidth.rank_metric.sum : data.throughput.rank_metric.avr;
+		std::string b = mode + "/bandwidth/";
+		mode += "/";
+
+		out.Add(mode + "total_bytes", data.agg_bytes);
+		out.Add(mode + "max_bytes_per_rank", data.max_bytes);
+		out.Add(mode + "max_bytes_per_phase", data.max_bytes_phase);
+		out.Add(mode + "max_io_phases_per_rank", data.max_phases);
+		out.Add(mode + "total_io_phases", data.agg_phases);
+		out.Add(mode + "max_io_ops_in_phase", data.max_ops);
+		out.Add(mode + "max_io_ops_per_rank", data.max_ops_rank);
+		out.Add(mode + "total_io_ops", data.agg_ops);
+#if MEMORY_CAP > 0
+		out.Add(mode + "dropped_samples", (req) ? data.dropped_req : data.dropped_act);
+#endif
+		out.Add(mode + "number_of_ranks", data.procs_io);
+		out.Add(b + "weighted_harmonic_mean", rank.whmean);
+		out.Add(b + "harmonic_mean", rank.hmean);
+		out.Add(b + "arithmetic_mean", rank.amean);
+		out.Add(b + "median", rank.median);
+#if PERCENTILES == 1
+		out.Add(b + "p90", rank.p90);
+		out.Add(b + "p99", rank.p99);
+#endif
+		out.Add(b + "max", rank.max);
+		out.Add(b + "min", rank.min);
+#if DO_CALC > 0
+		const core_app_metrics &app = (req) ? data.bandwidth.app_metric.sum : data.throughput.app_metric.avr;
+		out.Add(b + "app", app.max);
+		out.Add(b + "appH", app.hmean);
+#endif
+#if SHOW_AVR == 1
+		if (req)
 		{
-			tmp_6 = Print_Series(data.all_data, "t_start", data.agg_phases, 1, n, "\"t_rank_s\": [", "]", jsonl);
-			tmp_7 = Print_Series(data.all_data, "t_end_act", data.agg_phases, 1, n, "\"t_rank_e\": [", "]", jsonl);
+			const core_rank_metrics &avr = data.throughput.rank_metric.avr;
+			out.Add(b + "weighted_avr_harmonic_mean", avr.whmean);
+			out.Add(b + "harmonic_avr_mean", avr.hmean);
+			out.Add(b + "arithmetic_avr_mean", avr.amean);
+			out.Add(b + "median_avr", avr.median);
+#if PERCENTILES == 1
+			out.Add(b + "p90_avr", avr.p90);
+			out.Add(b + "p99_avr", avr.p99);
+#endif
+			out.Add(b + "max_avr", avr.max);
+			out.Add(b + "min_avr", avr.min);
+#if DO_CALC > 0
+			out.Add(b + "app_avr", data.throughput.app_metric.avr.max);
+			out.Add(b + "appH_avr", data.throughput.app_metric.avr.hmean);
+#endif
 		}
+#endif
 
-		out.append(tmp_6);
-		out.append(tmp_7);
+#if ALL_SAMPLES > 0 && DO_CALC > 0
+		const io_overlap &overlap = (req) ? data.overlap_req : data.overlap_act;
+		out.Add(b + "b_overlap_sum", (req) ? data.bandwidth_sum_phase.get() : data.throughput_sum_phase.get(), overlap.Size());
+		out.Add(b + "b_overlap_avr", (req) ? data.bandwidth_avr_phase.get() : data.throughput_avr_phase.get(), overlap.Size());
+		out.Add(b + "n_overlap", (req) ? data.n_overlap_req.get() : data.n_overlap_act.get(), overlap.Size());
+#endif
+#if ALL_SAMPLES > 1 && DO_CALC > 0
+		out.Add(b + "t_overlap", overlap.time.data(), overlap.time.size());
 #endif
 
-#if ALL_SAMPLES > 4
-		std::string tmp_8;
-		std::string tmp_9;
-		std::string tmp_10;
-		if (req)
+		// fields of the phases of all ranks
+		if (cfg.all_samples > 2 && !req && data.all_data)
 		{
-			tmp_8 = Print_Series(data.all_b, data.agg_ops, unit_scale, n, "\"b_ind\": [", "]", jsonl);
-			tmp_9 = Print_Series(data.all_t_req_s, data.agg_ops, 1, n, "\"t_ind_s\": [", "]", jsonl);
-			tmp_10 = Print_Series(data.all_t_req_e, data.agg_ops, 1, n, "\"t_ind_e\": [", "]", jsonl);
+			int n = data.agg_phases;
+			long long *bytes = out.Column<long long>(mode + "phase/data", n);
+			int *ops = out.Column<int>(mode + "phase/n_op", n);
+			for (int i = 0; i < n; i++)
+			{
+				bytes[i] = data.all_data[i].data;
+				ops[i] = data.all_data[i].n_op;
+			}
+			for (int f = 0; f < FIELD_NONE; f++)
+			{
+				double collect::*member = collect::Member((collect_field)f);
+				double *column = out.Column<double>(mode + "phase/" + collect::Name((collect_field)f), n);
+				for (int i = 0; i < n; i++)
+					column[i] = data.all_data[i].*member;
+			}
+			if (data.phases_of_ranks)
+				out.Add(mode + "phase/phases_of_ranks", data.phases_of_ranks.get(), data.procs);
 		}
-		else
+
+		if (cfg.all_samples > 4 && !cfg.parallel_output)
 		{
-			tmp_8 = Print_Series(data.all_t, data.agg_ops, unit_scale, n, "\"b_ind\": [", "]", jsonl);
-			tmp_9 = Print_Series(data.all_t_act_s, data.agg_ops, 1, n, "\"t_ind_s\": [", "]", jsonl);
-			tmp_10 = Print_Series(data.all_t_act_e, data.agg_ops, 1, n, "\"t_ind_e\": [", "]", jsonl);
+			if (req)
+			{
+				out.Add(b + "b_ind", data.all_b.get(), data.agg_samples_req);
+				out.Add(b + "t_ind_s", data.all_t_req_s.get(), data.agg_samples_req);
+				out.Add(b + "t_ind_e", data.all_t_req_e.get(), data.agg_samples_req);
+			}
+			else
+			{
+				out.Add(b + "b_ind", data.all_t.get(), data.agg_samples_act);
+				out.Add(b + "t_ind_s", data.all_t_act_s.get(), data.agg_samples_act);
+				out.Add(b + "t_ind_e", data.all_t_act_e.get(), data.agg_samples_act);
+			}
 		}
 
-		out.append(tmp_8);
-		out.append(tmp_9);
-		out.append(tmp_10);
-#endif
+		// all buckets (lower bounds in bytes and seconds)
+		if (cfg.histogram && !req)
+		{
+			long long *size = out.Column<long long>(b + "size_histogram_lower", IOHISTOGRAM_BINS);
+			double *latency = out.Column<double>(b + "latency_histogram_lower", IOHISTOGRAM_BINS);
+			for (int i = 0; i < IOHISTOGRAM_BINS; i++)
+			{
+				size[i] = IOhistogram::Lower(i);
+				latency[i] = IOhistogram::Lower(i) * 1e-9;
+			}
+			out.Add(b + "size_histogram", data.hist.size, IOHISTOGRAM_BINS);
+			out.Add(b + "latency_histogram", data.hist.latency, IOHISTOGRAM_BINS);
+		}
 
-		if (jsonl == true)
-			out.append("}}}\n");
-		else
-			out.append("\n\t\t}\n\t\t},\n\n");
-		return out;
+		if (cfg.sketch)
+		{
+			// values at the quantiles of the column "percentiles"
+			const IOsketch *sketch[2] = {(req) ? &data.sketch_b : &data.sketch_t, (req) ? NULL : &data.sketch_l};
+			const char *name[2] = {"b_ind_percentiles", "latency_ind_percentiles"};
+			for (int k = 0; k < 2 && sketch[k]; k++)
+			{
+				double *q = out.Column<double>(b + name[k], SKETCH_N_PERCENTILES);
+				for (int i = 0; i < SKETCH_N_PERCENTILES; i++)
+					q[i] = sketch[k]->Quantile(sketch_percentiles[i]);
+			}
+		}
+	}
+
+	//**********************************************************************
+	//*                       5. Format_Samples
+	//**********************************************************************
+	/**
+	 * @brief adds the individual I/O operations of this rank as rank columns (see IOcolumns::Write_All). The
+	 * names match the columns of \e Format_Columns with ALL_SAMPLES > 4 (b_ind, t_ind_s and t_ind_e). Every rank has to
+	 * call this function for the same modes in the same order
+	 *
+	 * @param out [in,out] columns
+	 * @param samples [in] samples of this rank (actual or required)
+	 * @param mode [in] name of the mode
+	 */
+	void Format_Samples(IOcolumns &out, const IOsamples &samples, std::string mode)
+	{
+		std::string b = mode + "/bandwidth/";
+		size_t n = samples.Size();
+		samples.Pack(SAMPLE_B, out.Rank_Column<double>(b + "b_ind", n));
+		samples.Pack(SAMPLE_T_S, out.Rank_Column<double>(b + "t_ind_s", n));
+		samples.Pack(SAMPLE_T_E, out.Rank_Column<double>(b + "t_ind_e", n));
+	}
+
+	//**********************************************************************
+	//*                       6. Delta
+	//**********************************************************************
+	/**
+	 * @brief appends a flush to the incremental online output (DELTA_OUTPUT). Every mode gets a line with the
+	 * phases and samples of the interval and the running metrics over all flushes, followed by the times of the
+	 * interval. The size of a flush only depends on the I/O of its interval
+	 *
+	 * @param processes [in] number of ranks
+	 * @param read_sync [in] statistics of the interval (read_async, write_sync and write_async likewise)
+	 * @param io_time [in] time metrics of the interval
+	 * @param running [in] metrics over all flushes (including this one)
+	 */
+	void Delta(int processes, const statistics &read_sync, const statistics &read_async, const statistics &write_sync, const statistics &write_async, const iotime &io_time, const IOrunning &running)
+	{
+		static bool first_time = true;
+		IOwriter file(std::to_string(processes) + ".delta.jsonl", !first_time);
+		first_time = false;
+
+		const statistics *data[IO_RUNNING_MODES] = {&read_sync, &read_async, &read_async, &write_async, &write_async, &write_sync};
+		for (int m = 0; m < IO_RUNNING_MODES; m++)
+			Format_Delta(file, *data[m], running, m);
+		file.Append(io_time.Print_Json(true));
+	}
+
+	//**********************************************************************
+	//*                       7. Format_Delta
+	//**********************************************************************
+	/**
+	 * @brief writes a line of the incremental output: the counts, series, histograms and percentiles of the
+	 * interval (same keys as \e Format_Json) and the running metrics of the mode ("running")
+	 *
+	 * @param out [in,out] writer
+	 * @param data [in] statistics of the interval
+	 * @param running [in] metrics over all flushes
+	 * @param m [in] mode (see io_running_names)
+	 */
+	void Format_Delta(IOwriter &out, const statistics &data, const IOrunning &running, int m)
+	{
+		const io_config &cfg = ioconfig::Get();
+		bool req = io_running_req[m];
+		const io_running_mode &total = running.Mode(m);
+		out.Format("\t{\"%s\":{\"chunk\": %i, \"io_phases\": %i, \"io_ops\": %lli, \"bytes\": %.2e, \"number_of_ranks\": %i",
+				   io_running_names[m], running.Chunk() - 1, data.agg_phases, data.agg_ops, (double)data.agg_bytes, data.procs_io);
+
+		if (cfg.all_samples > 2)
+		{
+			if (req)
+			{
+				Print_Series(out, data.all_data, FIELD_B_SUM, data.agg_phases, 1, 1, "\"b_rank_sum\": [", "]", true);
+				Print_Series(out, data.all_data, FIELD_B_AVR, data.agg_phases, 1, 1, "\"b_rank_avr\": [", "]", true);
+			}
+			else
+			{
+				Print_Series(out, data.all_data, FIELD_T_AVR, data.agg_phases, 1, 1, "\"b_rank_avr\": [", "]", true);
+				Print_Series(out, data.all_data, FIELD_T_SUM, data.agg_phases, 1, 1, "\"b_rank_sum\": [", "]", true);
+			}
+		}
+		if (cfg.all_samples > 3)
+		{
+			Print_Series(out, data.all_data, FIELD_T_START, data.agg_phases, 1, 1, "\"t_rank_s\": [", "]", true);
+			Print_Series(out, data.all_data, req ? FIELD_T_END_REQ : FIELD_T_END_ACT, data.agg_phases, 1, 1, "\"t_rank_e\": [", "]", true);
+		}
+		if (cfg.all_samples > 4 && !cfg.parallel_output)
+		{
+			if (req)
+			{
+				Print_Series(out, data.all_b.get(), data.agg_samples_req, 1, 1, "\"b_ind\": [", "]", true);
+				Print_Series(out, data.all_t_req_s.get(), data.agg_samples_req, 1, 1, "\"t_ind_s\": [", "]", true);
+				Print_Series(out, data.all_t_req_e.get(), data.agg_samples_req, 1, 1, "\"t_ind_e\": [", "]", true);
+			}
+			else
+			{
+				Print_Series(out, data.all_t.get(), data.agg_samples_act, 1, 1, "\"b_ind\": [", "]", true);
+				Print_Series(out, data.all_t_act_s.get(), data.agg_samples_act, 1, 1, "\"t_ind_s\": [", "]", true);
+				Print_Series(out, data.all_t_act_e.get(), data.agg_samples_act, 1, 1, "\"t_ind_e\": [", "]", true);
+			}
+		}
+		if (cfg.histogram && !req)
+		{
+			Print_Histogram(out, data.hist.size, 1, "\"size_histogram\":", true);
+			Print_Histogram(out, data.hist.latency, 1e-9, "\"latency_histogram\":", true);
+		}
+		if (cfg.sketch)
+		{
+			Print_Percentiles(out, req ? data.sketch_b : data.sketch_t, 1, "\"b_ind_percentiles\":", true);
+			if (!req)
+				Print_Percentiles(out, data.sketch_l, 1, "\"latency_ind_percentiles\":", true);
+		}
+
+		//? running metrics
+		core_rank_metrics r;
+		running.Metrics(m, r);
+		out.Format(", \"running\": {\"chunks\": %i, \"total_io_phases\": %lli, \"total_io_ops\": %lli, \"total_bytes\": %.2e",
+				   running.Chunk(), total.n_phases, total.ops, (double)total.bytes);
+		out.Format(", \"bandwidth\": {\"weighted_harmonic_mean\": %.2e, \"harmonic_mean\": %.2e, \"arithmetic_mean\": %.2e", r.whmean, r.hmean, r.amean);
+		out.Format(", \"median\": %.2e, \"p90\": %.2e, \"p99\": %.2e, \"max\": %.2e, \"min\": %.2e}", r.median, r.p90, r.p99, r.max, r.min);
+		if (cfg.histogram && !req)
+		{
+			Print_Histogram(out, total.hist.size, 1, "\"size_histogram\":", true);
+			Print_Histogram(out, total.hist.latency, 1e-9, "\"latency_histogram\":", true);
+		}
+		if (cfg.sketch)
+		{
+			Print_Percentiles(out, total.sketch_ind, 1, "\"b_ind_percentiles\":", true);
+			if (!req)
+				Print_Percentiles(out, total.sketch_l, 1, "\"latency_ind_percentiles\":", true);
+		}
+		out.Append("}}}\n");
 	}
 
 	//! ----------------------- Phase Calculation ------------------------------
@@ -595,147 +928,186 @@ namespace ioprint
 	//*                       1. Print_Series
 	//**********************************************************************
 
+	/**
+	 * @brief prints a series of values as a json array. Values are written with the shortest representation that
+	 * reads back to the same double (see IOwriter::Number)
+	 *
+	 * @param out [in,out] writer
+	 * @param ptr [in] values
+	 * @param loops [in] number of values
+	 * @param unit_scale [in] scale of the values
+	 * @param n [in] values per line (json only)
+	 * @param start [in] name of the array including the opening bracket
+	 * @param end [in] closing bracket
+	 * @param jsonl [in] print in jsonl format
+	 */
 	template <class T>
-	std::string Print_Series(T ptr, int loops, double unit_scale, int n, std::string start, std::string end, bool jsonl)
+	void Print_Series(IOwriter &out, T ptr, int loops, double unit_scale, int n, const char *start, const char *end, bool jsonl)
 	{
-		std::string s;
-		std::string out;
-		out.append(",");
+		out.Append(",");
 		if (jsonl == false)
-			out.append("\n\t\t");
-		out.append(start);
+			out.Append("\n\t\t");
+		out.Append(start);
 		for (int i = 0; i < loops; i++)
 		{
 			if (i % n == 0 && jsonl == false)
-				out.append("\n\t\t\t");
+				out.Append("\n\t\t\t");
 
-			s = isnan(*(ptr + i)) ? "NaN" : std::to_string(*(ptr + i) * unit_scale);
-
-			if (i == loops - 1)
-				out.append(" " + s);
-			else
-				out.append(" " + s + ",");
+			out.Append(" ", 1);
+			out.Number(*(ptr + i) * unit_scale);
+			if (i != loops - 1)
+				out.Append(",", 1);
 		}
-		out.append(end);
-		return out;
+		out.Append(end);
 	}
-	template std::string Print_Series<int *>(int *, int, double, int, std::string, std::string, bool);
-	template std::string Print_Series<double *>(double *, int, double, int, std::string, std::string, bool);
+	template void Print_Series<int *>(IOwriter &, int *, int, double, int, const char *, const char *, bool);
+	template void Print_Series<double *>(IOwriter &, double *, int, double, int, const char *, const char *, bool);
 
 	//**********************************************************************
 	//*                       2. Print_Series (overload)
 	//**********************************************************************
 
-	std::string Print_Series(collect *all_data, std::string field, int loops, double unit_scale, int n, std::string start, std::string end, bool jsonl)
+	void Print_Series(IOwriter &out, collect *all_data, collect_field field, int loops, double unit_scale, int n, const char *start, const char *end, bool jsonl)
 	{
+		double collect::*member = collect::Member(field);
 
-		std::string s;
-		std::string out;
-		out.append(",");
+		out.Append(",");
 		if (jsonl == false)
-			out.append("\n\t\t");
-		out.append(start);
+			out.Append("\n\t\t");
+		out.Append(start);
 		for (int i = 0; i < loops; i++)
 		{
 			if (i % n == 0 && jsonl == false)
-				out.append("\n\t\t\t");
+				out.Append("\n\t\t\t");
 
-			s = isnan(all_data[i].get(field)) ? "NaN" : std::to_string(all_data[i].get(field) * unit_scale);
+			out.Append(" ", 1);
+			out.Number((member == NULL) ? 0 : all_data[i].*member * unit_scale); // unknown field: 0 (see collect::get)
+			if (i != loops - 1)
+				out.Append(",", 1);
+		}
+		out.Append(end);
+	}
 
-			if (i == loops - 1)
-				out.append(" " + s);
+	//**********************************************************************
+	//*                       3. Print_Percentiles
+	//**********************************************************************
+	/**
+	 * @brief prints the percentile table of a sketch (see SKETCH_N_PERCENTILES in iosketch.h)
+	 *
+	 * @param out [in,out] writer
+	 * @param sketch [in] sketch merged over all ranks
+	 * @param unit_scale [in] scale of the values
+	 * @param start [in] name of the table
+	 * @param jsonl [in] print in jsonl format
+	 */
+	void Print_Percentiles(IOwriter &out, const IOsketch &sketch, double unit_scale, const char *start, bool jsonl)
+	{
+		out.Append(",");
+		if (jsonl == false)
+			out.Append("\n\t\t");
+		out.Format("%s {\"n\": %lli, \"min\": %.2e, \"max\": %.2e", start, sketch.Count(), sketch.Count() ? sketch.Min() * unit_scale : 0, sketch.Count() ? sketch.Max() * unit_scale : 0);
+		for (int i = 0; i < SKETCH_N_PERCENTILES; i++)
+			out.Format(", \"%s\": %.2e", sketch_percentile_names[i], sketch.Quantile(sketch_percentiles[i]) * unit_scale);
+		out.Append("}");
+	}
+
+	//**********************************************************************
+	//*                       4. Print_Histogram
+	//**********************************************************************
+	/**
+	 * @brief prints the non-empty buckets of a histogram (see IOhistogram) as [lower bound, count] pairs
+	 *
+	 * @param out [in,out] writer
+	 * @param count [in] counts of the buckets
+	 * @param unit_scale [in] scale of the lower bounds
+	 * @param start [in] name of the histogram
+	 * @param jsonl [in] print in jsonl format
+	 */
+	void Print_Histogram(IOwriter &out, const long long *count, double unit_scale, const char *start, bool jsonl)
+	{
+		out.Append(",");
+		if (jsonl == false)
+			out.Append("\n\t\t");
+		out.Append(start);
+		out.Append(" [");
+		bool first = true;
+		for (int i = 0; i < IOHISTOGRAM_BINS; i++)
+		{
+			if (count[i] == 0)
+				continue;
+			if (unit_scale == 1) // exact integer bounds (bytes)
+				out.Format("%s[%llu, %lli]", first ? "" : ", ", (unsigned long long)IOhistogram::Lower(i), count[i]);
 			else
-				out.append(" " + s + ",");
+				out.Format("%s[%.3e, %lli]", first ? "" : ", ", IOhistogram::Lower(i) * unit_scale, count[i]);
+			first = false;
 		}
-		out.append(end);
-		return out;
+		out.Append("]");
 	}
 
-	void Binary(int processes, statistics read_sync, statistics read_async, statistics write_sync, statistics write_async, iotime io_time)
+	/**
+	 * @brief writes the statistics in the binary format selected with FILE_FORMAT (one file or message per call).
+	 * The columnar format (1) is always available, msgpack and ZMQ (2 and 3) only if compiled in (see ioconfig.h)
+	 *
+	 * @param processes [in] number of ranks
+	 * @param io_time [in] time metrics
+	 * @param publisher [in] persistent ZMQ socket (only used with FILE_FORMAT 3)
+	 */
+	void Binary(int processes, const statistics &read_sync, const statistics &read_async, const statistics &write_sync, const statistics &write_async, const iotime &io_time, [[maybe_unused]] IOpublisher *publisher)
 	{
 
 		static int chunk = 0;
-#if FILE_FORMAT == 2 || FILE_FORMAT == 3 // MSGPack & ZMQ
-		msgpack::sbuffer buffer;
-		// Pack
-		msgpack::pack(buffer, read_async);
-		msgpack::pack(buffer, read_sync);
-		msgpack::pack(buffer, write_async);
-		msgpack::pack(buffer, write_sync);
-		msgpack::pack(buffer, io_time);
-#endif
-
-#if FILE_FORMAT == 1 // Plain binary
-		// Generate a large string
-		std::string print = Format_Json(read_sync, "read_sync", false, true);
-		print.append(Format_Json(read_async, "read_async_t", false, true));
-		print.append(Format_Json(read_async, "read_async_b", true, true));
-		print.append(Format_Json(write_async, "write_async_t", false, true));
-		print.append(Format_Json(write_async, "write_async_b", true, true));
-		print.append(Format_Json(write_sync, "write_sync", false, true));
-		print.append(io_time.Print_Json(true));
-
-		std::string name = std::to_string(processes) + ".bin" + "_chunk_" + std::to_string(chunk);
-		auto flag = std::ios_base::binary;
-		std::ofstream file(name, flag);
-		if (file.is_open())
+		if (ioconfig::Get().file_format == 1) // Plain binary
 		{
-			file.write(print.c_str(), print.size());
-			file.close();
+			// columnar binary file per chunk (see iocolumns_reader.h)
+			IOcolumns columns;
+			columns.Add(std::string("percentiles"), sketch_percentiles, SKETCH_N_PERCENTILES);
+			Format_Columns(columns, read_sync, "read_sync", false);
+			Format_Columns(columns, read_async, "read_async_t", false);
+			Format_Columns(columns, read_async, "read_async_b", true);
+			Format_Columns(columns, write_async, "write_async_t", false);
+			Format_Columns(columns, write_async, "write_async_b", true);
+			Format_Columns(columns, write_sync, "write_sync", false);
+			io_time.Columns(columns);
+			columns.Write(std::to_string(processes) + ".bin" + "_chunk_" + std::to_string(chunk));
 		}
+#if FILE_FORMAT == 2 || FILE_FORMAT == 3 // MSGPack & ZMQ
+		else
+		{
+			msgpack::sbuffer buffer;
+			// Pack
+			msgpack::pack(buffer, read_async);
+			msgpack::pack(buffer, read_sync);
+			msgpack::pack(buffer, write_async);
+			msgpack::pack(buffer, write_sync);
+			msgpack::pack(buffer, io_time);
 
-#elif FILE_FORMAT == 2 // MSGPACK
+#if FILE_FORMAT == 2 // MSGPACK
+			//? 1) One file:
+			std::string name = std::to_string(processes) + ".msgpack";
+			static bool first_time = true;
+			auto flag = std::ios_base::binary | std::ios_base::app;
+			if (first_time)
+			{
+				flag = std::ios_base::binary;
+				first_time = false;
+			}
+			//? 2) Several files
+			// std::string name = std::to_string(processes) + ".msgpack" + "_chunk_" + std::to_string(chunk) ;
+			// auto flag = std::ios_base::binary;
+			std::ofstream file(name, flag);
 
-		//? 1) One file:
-		std::string name = std::to_string(processes) + ".msgpack";
-		static bool first_time = true;
-		auto flag = std::ios_base::binary | std::ios_base::app;
-		if (first_time)
-		{
-			flag = std::ios_base::binary;
-			first_time = false;
+			// Write the serialized data to the file
+			file.write(buffer.data(), buffer.size());
+			file.close();
+
+#else // ZMQ
+			// the persistent socket of IOtrace takes over the buffer (see iopublisher.h)
+			if (publisher)
+				publisher->Send(buffer);
+			else
+				printf("IOpublisher: no publisher, summary %i not sent\n", chunk);
+#endif
 		}
-		//? 2) Several files
-		// std::string name = std::to_string(processes) + ".msgpack" + "_chunk_" + std::to_string(chunk) ;
-		// auto flag = std::ios_base::binary;
-		std::ofstream file(name, flag);
-
-		// Write the serialized data to the file
-		file.write(buffer.data(), buffer.size());
-		file.close();
-
-#elif FILE_FORMAT == 3 // ZMQ
-		zmq::context_t context(1);
-		static std::string port = "tcp://127.0.0.1:5555";
-		// zmq::socket_t socket(context, ZMQ_PUSH);
-		// static bool first_time = true;
-		// if (first_time)
-		// {
-		// 	std::ifstream myfile("ftio_port");
-		// 	if (myfile.good() && myfile.is_open())
-		// 	{
-		// 		while (getline(myfile, port))
-		// 		{
-		// 			std::cout << port << '\n';
-		// 		}
-		// 		myfile.close();
-		// 	}
-		// 	first_time = false;
-		// }
-		// socket.bind(port);
-		// zmq::message_t message(buffer.size());
-		// memcpy(message.data(), buffer.data(), buffer.size());
-		// socket.send(message, zmq::send_flags::none);
-
-		// prepare message
-		zmq::message_t message(buffer.size());
-		memcpy(message.data(), buffer.data(), buffer.size());
-		
-		// send message
-		zmq::socket_t sender(context, ZMQ_PUSH);
-		sender.connect(port);
-		sender.send(message, zmq::send_flags::none);
-		printf("Sending over port %s",port.c_str());
 #endif
 
 		chunk++;
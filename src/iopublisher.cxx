@@ -0,0 +1,103 @@
+#include "iopublisher.h"
+
+/**
+ * @file iopublisher.cxx
+ * @brief Contains definitions of methods from the \e IOpublisher class.
+ */
+
+#if FILE_FORMAT > 2
+#include <stdio.h>
+#include <stdlib.h>
+#include "ioconfig.h"
+
+// called by ZMQ once the message was sent (the data was allocated by msgpack::sbuffer)
+static void Free_Buffer(void *data, void *)
+{
+	free(data);
+}
+
+//! ------------------------------ Socket ---------------------------------
+//************************************************************************************
+//*                               1. Connect
+//************************************************************************************
+/**
+ * @brief creates the PUSH socket and connects it. An already connected socket is closed first
+ *
+ * @param endpoint [in] tcp://, ipc:// or inproc:// endpoint the receiver binds to
+ * @param hwm [in] maximal number of queued messages
+ * @return true if the socket was connected
+ */
+bool IOpublisher::Connect(const std::string &endpoint, int hwm)
+{
+	Close();
+	try
+	{
+		socket = zmq::socket_t(context, zmq::socket_type::push);
+		socket.set(zmq::sockopt::sndhwm, hwm);
+		socket.set(zmq::sockopt::linger, PUBLISHER_LINGER);
+		socket.connect(endpoint);
+	}
+	catch (const zmq::error_t &e)
+	{
+		printf("IOpublisher: could not connect to %s (%s)\n", endpoint.c_str(), e.what());
+		socket.close();
+		return false;
+	}
+	this->endpoint = endpoint;
+	connected = true;
+	return true;
+}
+
+//************************************************************************************
+//*                               2. Send
+//************************************************************************************
+/**
+ * @brief sends a buffer without copying. ZMQ takes over the memory of the buffer, which is empty afterwards.
+ * If the queue is full, the message is dropped instead of blocking
+ *
+ * @param buffer [in,out] packed summary
+ * @return true if the message was queued, false if it was dropped
+ */
+bool IOpublisher::Send(msgpack::sbuffer &buffer)
+{
+	if (!connected && !Connect(ioconfig::Get().publisher_endpoint))
+	{
+		buffer.clear();
+		dropped++;
+		return false;
+	}
+
+	size_t size = buffer.size();
+	zmq::message_t message(buffer.release(), size, Free_Buffer);
+	zmq::send_result_t result;
+	try
+	{
+		result = socket.send(message, zmq::send_flags::dontwait);
+	}
+	catch (const zmq::error_t &)
+	{
+		result = {};
+	}
+	// not sent: the message still owns the data and frees it
+	if (!result)
+	{
+		dropped++;
+		return false;
+	}
+	sent++;
+	return true;
+}
+
+//************************************************************************************
+//*                               3. Close
+//************************************************************************************
+/**
+ * @brief closes the socket. The context is kept, so the publisher can connect again
+ */
+void IOpublisher::Close(void)
+{
+	if (connected)
+		socket.close();
+	connected = false;
+}
+#endif
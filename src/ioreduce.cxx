@@ -0,0 +1,222 @@
+#include "ioreduce.h"
+
+/**
+ * @file ioreduce.cxx
+ * @brief Contains definitions of methods from the \e ioreduce namespace.
+ */
+
+namespace ioreduce
+{
+	//! ----------------------- Partials ------------------------------
+	//**********************************************************************
+	//*                       1. Init
+	//**********************************************************************
+	/**
+	 * @brief sets a partial to the neutral element of \e Combine
+	 *
+	 * @param p [out] partial
+	 */
+	void Init(rank_partial &p)
+	{
+		p.inv = 0;
+		p.w_inv = 0;
+		p.sum = 0;
+		p.min = std::numeric_limits<double>::max();
+		p.max = 0;
+		p.agg_max = 0;
+		p.bytes = 0;
+		p.n = 0;
+	}
+
+	//**********************************************************************
+	//*                       2. Add
+	//**********************************************************************
+	/**
+	 * @brief adds a value to a partial. NaN values (removed phases) are skipped
+	 *
+	 * @param p [in,out] partial
+	 * @param x [in] value (bandwidth or throughput of a phase)
+	 * @param bytes [in] bytes transferred during the phase
+	 */
+	void Add(rank_partial &p, double x, long long bytes)
+	{
+		if (isnan(x))
+			return;
+
+		p.n++;
+		if (x != 0)
+		{
+			p.inv += 1 / x;
+			p.w_inv += bytes / x;
+		}
+		p.sum += x;
+		p.bytes += bytes;
+		p.min = (p.min > x) ? x : p.min;
+		p.max = (x > p.max) ? x : p.max;
+	}
+
+	//**********************************************************************
+	//*                       3. Merge
+	//**********************************************************************
+	/**
+	 * @brief adds the values of a partial to another one (e.g., the partials of two ranks or of two intervals)
+	 *
+	 * @param p [in,out] partial
+	 * @param other [in] partial that is added
+	 */
+	void Merge(rank_partial &p, const rank_partial &other)
+	{
+		p.inv += other.inv;
+		p.w_inv += other.w_inv;
+		p.sum += other.sum;
+		p.min = (other.min < p.min) ? other.min : p.min;
+		p.max = (other.max > p.max) ? other.max : p.max;
+		p.agg_max += other.agg_max;
+		p.bytes += other.bytes;
+		p.n += other.n;
+	}
+
+	//! ----------------------- Communication ------------------------------
+	/**
+	 * @brief MPI user operation combining partials
+	 */
+	static void Combine(void *in, void *inout, int *len, MPI_Datatype *)
+	{
+		rank_partial *a = (rank_partial *)in;
+		rank_partial *b = (rank_partial *)inout;
+		for (int i = 0; i < *len; i++)
+			Merge(b[i], a[i]);
+	}
+
+	//**********************************************************************
+	//*                       1. Allreduce
+	//**********************************************************************
+	/**
+	 * @brief combines the partials of all ranks. The result is available on every rank, as the
+	 * median selection needs the number of values
+	 *
+	 * @param local [in] partials of the current rank
+	 * @param out [out] combined partials
+	 * @param n [in] number of partials (fields)
+	 * @param IO_WORLD [in] communicator
+	 * @return int MPI error code
+	 */
+	int Allreduce(const rank_partial *local, rank_partial *out, int n, MPI_Comm IO_WORLD)
+	{
+		rank_partial tmp;
+		Init(tmp);
+		int length[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+		MPI_Aint dis[8];
+		MPI_Aint base_address;
+		MPI_Get_address(&tmp, &base_address);
+		MPI_Get_address(&tmp.inv, &dis[0]);
+		MPI_Get_address(&tmp.w_inv, &dis[1]);
+		MPI_Get_address(&tmp.sum, &dis[2]);
+		MPI_Get_address(&tmp.min, &dis[3]);
+		MPI_Get_address(&tmp.max, &dis[4]);
+		MPI_Get_address(&tmp.agg_max, &dis[5]);
+		MPI_Get_address(&tmp.bytes, &dis[6]);
+		MPI_Get_address(&tmp.n, &dis[7]);
+		for (int i = 0; i < 8; i++)
+			dis[i] = MPI_Aint_diff(dis[i], base_address);
+
+		MPI_Datatype type[8] = {MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE, MPI_LONG_LONG, MPI_LONG_LONG};
+		MPI_Datatype tmp_type, REDUCE_partial;
+		MPI_Type_create_struct(8, length, dis, type, &tmp_type);
+		MPI_Type_create_resized(tmp_type, 0, sizeof(rank_partial), &REDUCE_partial);
+		MPI_Type_commit(&REDUCE_partial);
+		MPI_Type_free(&tmp_type);
+
+		MPI_Op op;
+		MPI_Op_create(Combine, 1, &op);
+		int err = MPI_Allreduce(local, out, n, REDUCE_partial, op, IO_WORLD);
+
+		MPI_Op_free(&op);
+		MPI_Type_free(&REDUCE_partial);
+		return err;
+	}
+
+	//! ----------------------- Selection ------------------------------
+	/**
+	 * @brief maps a double to an unsigned integer with the same order
+	 */
+	static uint64_t Key(double x)
+	{
+		uint64_t u;
+		memcpy(&u, &x, sizeof(u));
+		return (u >> 63) ? ~u : u | (1ULL << 63);
+	}
+
+	static double Value(uint64_t key)
+	{
+		uint64_t u = (key >> 63) ? key & ~(1ULL << 63) : ~key;
+		double x;
+		memcpy(&x, &u, sizeof(x));
+		return x;
+	}
+
+	//**********************************************************************
+	//*                       2. Select
+	//**********************************************************************
+	/**
+	 * @brief finds the \e k-th smallest value (0 based) of distributed arrays. Every rank holds a sorted part of
+	 * each array. The search bisects the (order-preserving) bit pattern of the values and only exchanges the number
+	 * of values below the pivot, so it takes at most 64 rounds of a single MPI_Allreduce regardless of the number
+	 * of ranks or values. All queries are resolved together. Collective, the result is available on every rank
+	 *
+	 * @param sorted [in] sorted local arrays (NaN free)
+	 * @param of [in] array searched by each query (several queries can share an array)
+	 * @param k [in] rank of the searched value for each query (must be smaller than the global number of values)
+	 * @param out [out] k-th smallest value for each query
+	 * @param n [in] number of queries
+	 * @param IO_WORLD [in] communicator
+	 * @return int MPI error code
+	 */
+	int Select(const std::vector<double> *sorted, const int *of, const long long *k, double *out, int n, MPI_Comm IO_WORLD)
+	{
+		int n_arrays = (n > 0) ? *std::max_element(of, of + n) + 1 : 0;
+		std::vector<std::vector<uint64_t>> keys(n_arrays);
+		std::vector<uint64_t> lo(n, 0);
+		std::vector<uint64_t> hi(n, UINT64_MAX);
+		std::vector<long long> count(n);
+		std::vector<long long> count_all(n);
+		for (int a = 0; a < n_arrays; a++)
+		{
+			keys[a].reserve(sorted[a].size());
+			for (size_t i = 0; i < sorted[a].size(); i++)
+				keys[a].push_back(Key(sorted[a][i]));
+		}
+
+		int err = MPI_SUCCESS;
+		bool done = false;
+		while (!done && err == MPI_SUCCESS)
+		{
+			// number of local values at or below the middle of each interval
+			for (int q = 0; q < n; q++)
+			{
+				uint64_t mid = lo[q] + (hi[q] - lo[q]) / 2;
+				count[q] = std::upper_bound(keys[of[q]].begin(), keys[of[q]].end(), mid) - keys[of[q]].begin();
+			}
+			err = MPI_Allreduce(count.data(), count_all.data(), n, MPI_LONG_LONG, MPI_SUM, IO_WORLD);
+
+			// keep the half containing the k-th value
+			done = true;
+			for (int q = 0; q < n; q++)
+			{
+				if (lo[q] == hi[q])
+					continue;
+				uint64_t mid = lo[q] + (hi[q] - lo[q]) / 2;
+				if (count_all[q] > k[q])
+					hi[q] = mid;
+				else
+					lo[q] = mid + 1;
+				if (lo[q] != hi[q])
+					done = false;
+			}
+		}
+
+		for (int q = 0; q < n; q++)
+			out[q] = Value(lo[q]);
+		return err;
+	}
+}
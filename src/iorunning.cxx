@@ -0,0 +1,103 @@
+#include "iorunning.h"
+
+/**
+ * @file iorunning.cxx
+ * @brief Contains definitions of methods from the \e IOrunning class.
+ */
+
+IOrunning::IOrunning(void) : chunk(0)
+{
+	for (int m = 0; m < IO_RUNNING_MODES; m++)
+	{
+		ioreduce::Init(mode[m].phases);
+		mode[m].bytes = 0;
+		mode[m].ops = 0;
+		mode[m].n_phases = 0;
+	}
+}
+
+//! ------------------------------ Accumulation ---------------------------------
+//************************************************************************************
+//*                               1. Update
+//************************************************************************************
+/**
+ * @brief adds an interval. Every rank summarizes its new phases in a partial and a sketch per mode, which are
+ * combined with one MPI_Allreduce and one sketch reduction and merged into the accumulators on rank 0. The totals,
+ * the sketches of the individual operations and the histograms are taken from the statistics of the interval. Collective
+ *
+ * @param local [in] new phases of the current rank per mode (see io_running_names)
+ * @param s [in] statistics of the interval per mode (reduced on rank 0)
+ * @param rank [in] current rank
+ * @param IO_WORLD [in] communicator
+ */
+void IOrunning::Update(const std::vector<collect> *const *local, const statistics *const *s, int rank, MPI_Comm IO_WORLD)
+{
+	rank_partial partial[IO_RUNNING_MODES];
+	rank_partial all[IO_RUNNING_MODES];
+	std::vector<IOsketch> sketch(IO_RUNNING_MODES);
+	std::vector<IOsketch> merged(IO_RUNNING_MODES);
+	const IOsketch *in[IO_RUNNING_MODES];
+	IOsketch *out[IO_RUNNING_MODES];
+	for (int m = 0; m < IO_RUNNING_MODES; m++)
+	{
+		double collect::*member = collect::Member(io_running_req[m] ? FIELD_B_SUM : FIELD_T_AVR);
+		ioreduce::Init(partial[m]);
+		for (const collect &c : *local[m])
+		{
+			ioreduce::Add(partial[m], c.*member, c.data);
+			sketch[m].Add(c.*member);
+		}
+		in[m] = &sketch[m];
+		out[m] = &merged[m];
+	}
+	ioreduce::Allreduce(partial, all, IO_RUNNING_MODES, IO_WORLD);
+	IOsketch::Reduce(in, out, IO_RUNNING_MODES, IO_WORLD);
+	chunk++;
+	if (rank != 0)
+		return;
+
+	const io_config &cfg = ioconfig::Get();
+	for (int m = 0; m < IO_RUNNING_MODES; m++)
+	{
+		ioreduce::Merge(mode[m].phases, all[m]);
+		mode[m].sketch.Merge(merged[m]);
+		if (cfg.sketch)
+		{
+			mode[m].sketch_ind.Merge(io_running_req[m] ? s[m]->sketch_b : s[m]->sketch_t);
+			if (!io_running_req[m])
+				mode[m].sketch_l.Merge(s[m]->sketch_l);
+		}
+		if (cfg.histogram && !io_running_req[m])
+			for (int i = 0; i < IOHISTOGRAM_BINS; i++)
+			{
+				mode[m].hist.size[i] += s[m]->hist.size[i];
+				mode[m].hist.latency[i] += s[m]->hist.latency[i];
+			}
+		mode[m].bytes += s[m]->agg_bytes;
+		mode[m].ops += s[m]->agg_ops;
+		mode[m].n_phases += s[m]->agg_phases;
+	}
+}
+
+//************************************************************************************
+//*                               2. Metrics
+//************************************************************************************
+/**
+ * @brief metrics of a mode over all intervals (as \e statistics::Set_Rank_Metrics). The median and the
+ * percentiles come from the sketch of the phase values. Only valid on rank 0
+ *
+ * @param m [in] mode (see io_running_names)
+ * @param out [out] metrics
+ */
+void IOrunning::Metrics(int m, core_rank_metrics &out) const
+{
+	const rank_partial &p = mode[m].phases;
+	out.hmean = (p.inv == 0) ? 0 : p.n / p.inv;
+	out.amean = (p.n == 0) ? 0 : p.sum / p.n;
+	out.whmean = (p.w_inv == 0) ? 0 : p.bytes / p.w_inv;
+	out.median = mode[m].sketch.Quantile(0.5);
+	out.p90 = mode[m].sketch.Quantile(0.9);
+	out.p99 = mode[m].sketch.Quantile(0.99);
+	out.max = p.max;
+	out.min = (p.n == 0) ? 0 : p.min;
+}
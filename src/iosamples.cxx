@@ -0,0 +1,212 @@
+#include "iosamples.h"
+#include "iogather.h"
+#include <utility>
+
+/**
+ * @file iosamples.cxx
+ * @brief Contains definitions of methods from the \e IOsamples class.
+ */
+
+IOsamples::IOsamples(void)
+{
+	block_n = IOSAMPLES_BLOCK;
+	max_blocks = 0;
+	n_samples = 0;
+	dropped = 0;
+}
+
+IOsamples::~IOsamples(void)
+{
+	Clear();
+}
+
+//! ------------------------------ Recording -------------------------------
+//************************************************************************************
+//*                               1. Cap
+//************************************************************************************
+/**
+ * @brief limits the number of samples. The cap is split into at least four blocks (if possible), so that
+ * recycling the oldest block keeps at least 3/4 of the cap. Must be called before the first \e Add
+ *
+ * @param cap [in] maximal number of samples (0: unlimited)
+ */
+void IOsamples::Cap(size_t cap)
+{
+	if (cap == 0)
+	{
+		block_n = IOSAMPLES_BLOCK;
+		max_blocks = 0;
+		return;
+	}
+
+	block_n = (cap / 4 > 0) ? cap / 4 : 1;
+	if (block_n > IOSAMPLES_BLOCK)
+		block_n = IOSAMPLES_BLOCK;
+	max_blocks = cap / block_n;
+}
+
+//************************************************************************************
+//*                               2. Add
+//************************************************************************************
+/**
+ * @brief appends a sample. If the last block is full, a new block is linked or, once the cap is
+ * reached, the oldest block is reused
+ *
+ * @param b [in] bandwidth of the operation
+ * @param ts [in] start time
+ * @param te [in] end time
+ * @param phase [in] phase of the operation
+ */
+void IOsamples::Add(double b, double ts, double te, int phase)
+{
+	if (blocks.empty() || blocks.back()->n == block_n)
+	{
+		if (max_blocks > 0 && blocks.size() == max_blocks)
+		{
+			io_sample_block *oldest = blocks.front();
+			blocks.pop_front();
+			dropped += oldest->n;
+			n_samples -= oldest->n;
+			oldest->n = 0;
+			blocks.push_back(oldest);
+		}
+		else
+			blocks.push_back(New_Block());
+	}
+
+	io_sample_block *block = blocks.back();
+	block->t_s[block->n] = ts;
+	block->t_e[block->n] = te;
+	block->b[block->n] = b;
+	block->phase[block->n] = phase;
+	block->n++;
+	n_samples++;
+}
+
+//************************************************************************************
+//*                               3. Clear
+//************************************************************************************
+void IOsamples::Clear(void)
+{
+	for (size_t i = 0; i < blocks.size(); i++)
+		Free_Block(blocks[i]);
+	blocks.clear();
+	n_samples = 0;
+	dropped = 0;
+}
+
+//************************************************************************************
+//*                               4. Swap
+//************************************************************************************
+/**
+ * @brief exchanges the samples with another arena (no copy). Both arenas must have the same cap
+ *
+ * @param other [in,out] arena to swap with
+ */
+void IOsamples::Swap(IOsamples &other)
+{
+	blocks.swap(other.blocks);
+	std::swap(n_samples, other.n_samples);
+	std::swap(dropped, other.dropped);
+}
+
+//! ------------------------------ Communication -------------------------------
+//************************************************************************************
+//*                               1. Pack
+//************************************************************************************
+/**
+ * @brief copies a field of the samples block by block into a contiguous array (oldest sample first)
+ *
+ * @param field [in] field to copy
+ * @param out [out] array of \e Size() doubles or ints depending on \e field
+ */
+void IOsamples::Pack(io_sample_field field, void *out) const
+{
+	size_t size = (field == SAMPLE_PHASE) ? sizeof(int) : sizeof(double);
+	size_t offset = 0;
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		memcpy((char *)out + offset, Field(blocks[i], field), size * blocks[i]->n);
+		offset += size * blocks[i]->n;
+	}
+}
+
+//************************************************************************************
+//*                               2. Gather
+//************************************************************************************
+/**
+ * @brief gathers a field of the samples of all ranks on rank 0 (see IOgather). The blocks are sent in place:
+ * they are described by a struct datatype with the addresses relative to the first block, so they are not
+ * copied into a contiguous buffer first
+ *
+ * @param field [in] field to gather
+ * @param buff_all_values [out] receive buffer on rank 0 (double or int depending on \e field)
+ * @param arr_all_n [in] number of samples of each rank (only needed on rank 0)
+ * @param IO_WORLD [in] communicator
+ */
+void IOsamples::Gather(io_sample_field field, void *buff_all_values, int *arr_all_n, MPI_Comm IO_WORLD) const
+{
+	MPI_Datatype base = (field == SAMPLE_PHASE) ? MPI_INT : MPI_DOUBLE;
+	int n_blocks = blocks.size();
+	if (n_blocks == 0)
+	{
+		IOgather::Get(IO_WORLD).Gatherv(NULL, 0, base, buff_all_values, arr_all_n);
+		return;
+	}
+
+	int *lengths = (int *)malloc(sizeof(int) * n_blocks);
+	MPI_Aint *displacement = (MPI_Aint *)malloc(sizeof(MPI_Aint) * n_blocks);
+	MPI_Datatype *types = (MPI_Datatype *)malloc(sizeof(MPI_Datatype) * n_blocks);
+	const void *first = Field(blocks[0], field);
+	MPI_Aint address_first;
+	MPI_Get_address(first, &address_first);
+	for (int i = 0; i < n_blocks; i++)
+	{
+		MPI_Aint address;
+		MPI_Get_address(Field(blocks[i], field), &address);
+		displacement[i] = MPI_Aint_diff(address, address_first);
+		lengths[i] = blocks[i]->n;
+		types[i] = base;
+	}
+
+	MPI_Datatype type;
+	MPI_Type_create_struct(n_blocks, lengths, displacement, types, &type);
+	MPI_Type_commit(&type);
+	IOgather::Get(IO_WORLD).Gatherv(first, 1, type, (int)n_samples, buff_all_values, arr_all_n, base);
+
+	MPI_Type_free(&type);
+	free(types);
+	free(displacement);
+	free(lengths);
+}
+
+//! ------------------------------ Helpers -------------------------------
+io_sample_block *IOsamples::New_Block(void)
+{
+	io_sample_block *block = (io_sample_block *)malloc(sizeof(io_sample_block));
+	char *data = (char *)malloc(block_n * Sample_Size());
+	block->t_s = (double *)data;
+	block->t_e = block->t_s + block_n;
+	block->b = block->t_e + block_n;
+	block->phase = (int *)(block->b + block_n);
+	block->n = 0;
+	return block;
+}
+
+// array of a field in a block
+const void *IOsamples::Field(const io_sample_block *block, io_sample_field field)
+{
+	if (field == SAMPLE_T_S)
+		return block->t_s;
+	else if (field == SAMPLE_T_E)
+		return block->t_e;
+	else if (field == SAMPLE_B)
+		return block->b;
+	return block->phase;
+}
+
+void IOsamples::Free_Block(io_sample_block *block)
+{
+	free(block->t_s);
+	free(block);
+}
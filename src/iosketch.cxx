@@ -0,0 +1,175 @@
+#include "iosketch.h"
+
+/**
+ * @file iosketch.cxx
+ * @brief Contains definitions of methods from the \e IOsketch class.
+ */
+
+/**
+ * @brief creates an empty sketch
+ *
+ * @param min_value [in] lower end of the first bucket (e.g., 1 B/s for bandwidths or 1 ns for latencies)
+ */
+IOsketch::IOsketch(double min_value) : bins(SKETCH_BINS, 0), min_value(min_value)
+{
+	log_gamma = log((1 + SKETCH_ALPHA) / (1 - SKETCH_ALPHA));
+	n = 0;
+	min = INFINITY;
+	max = -INFINITY;
+	sum = 0;
+}
+
+//! ------------------------------ Recording -------------------------------
+//************************************************************************************
+//*                               1. Add
+//************************************************************************************
+/**
+ * @brief counts a value in its bucket. NaN and infinite values (e.g., zero duration) are skipped
+ *
+ * @param x [in] value
+ */
+void IOsketch::Add(double x)
+{
+	if (!isfinite(x))
+		return;
+
+	int i = 0;
+	if (x > min_value)
+	{
+		i = (int)ceil(log(x / min_value) / log_gamma);
+		i = (i < SKETCH_BINS) ? i : SKETCH_BINS - 1;
+	}
+	bins[i]++;
+	n++;
+	sum += x;
+	min = (x < min) ? x : min;
+	max = (x > max) ? x : max;
+}
+
+//************************************************************************************
+//*                               2. Clear
+//************************************************************************************
+void IOsketch::Clear(void)
+{
+	std::fill(bins.begin(), bins.end(), 0);
+	n = 0;
+	min = INFINITY;
+	max = -INFINITY;
+	sum = 0;
+}
+
+//************************************************************************************
+//*                               3. Quantile
+//************************************************************************************
+/**
+ * @brief returns the q-quantile. The value is the middle (in relative terms) of the bucket containing the
+ * value of rank q*(n-1), limited to the exact minimum and maximum
+ *
+ * @param q [in] quantile between 0 and 1
+ * @return double q-quantile (0 for an empty sketch)
+ */
+double IOsketch::Quantile(double q) const
+{
+	if (n == 0)
+		return 0;
+
+	double rank = q * (n - 1);
+	long long count = 0;
+	int i = 0;
+	for (; i < SKETCH_BINS - 1; i++)
+	{
+		count += bins[i];
+		if (count > rank)
+			break;
+	}
+
+	double value = (i == 0) ? min_value : 2 * min_value * exp(i * log_gamma) / (1 + exp(log_gamma));
+	value = (value < min) ? min : value;
+	value = (value > max) ? max : value;
+	return value;
+}
+
+//************************************************************************************
+//*                               4. Merge
+//************************************************************************************
+/**
+ * @brief adds the counts, sum and extrema of another sketch. An empty sketch takes over the buckets of the other
+ * one, otherwise both have to start at the same minimum
+ *
+ * @param other [in] sketch that is added
+ */
+void IOsketch::Merge(const IOsketch &other)
+{
+	if (other.n == 0)
+		return;
+	if (n == 0)
+	{
+		*this = other;
+		return;
+	}
+
+	for (int i = 0; i < SKETCH_BINS; i++)
+		bins[i] += other.bins[i];
+	n += other.n;
+	sum += other.sum;
+	min = (other.min < min) ? other.min : min;
+	max = (other.max > max) ? other.max : max;
+}
+
+//! ------------------------------ Communication -------------------------------
+//************************************************************************************
+//*                               1. Reduce
+//************************************************************************************
+/**
+ * @brief merges the sketches of all ranks on rank 0. All sketches are combined together with one
+ * MPI_Reduce for the counts and two for the sums and extrema. Collective
+ *
+ * @param in [in] sketches of the current rank
+ * @param out [out] merged sketches (only set on rank 0)
+ * @param n_sketch [in] number of sketches
+ * @param IO_WORLD [in] communicator
+ */
+void IOsketch::Reduce(const IOsketch *const *in, IOsketch *const *out, int n_sketch, MPI_Comm IO_WORLD)
+{
+	int rank;
+	MPI_Comm_rank(IO_WORLD, &rank);
+
+	std::vector<long long> count((size_t)n_sketch * SKETCH_BINS);
+	std::vector<double> sum(n_sketch);
+	std::vector<double> ext(2 * n_sketch); // -min and max, so both are reduced with MPI_MAX
+	for (int k = 0; k < n_sketch; k++)
+	{
+		std::copy(in[k]->bins.begin(), in[k]->bins.end(), count.begin() + (size_t)k * SKETCH_BINS);
+		sum[k] = in[k]->sum;
+		ext[2 * k] = -in[k]->min;
+		ext[2 * k + 1] = in[k]->max;
+	}
+
+	if (rank == 0)
+	{
+		MPI_Reduce(MPI_IN_PLACE, count.data(), count.size(), MPI_LONG_LONG, MPI_SUM, 0, IO_WORLD);
+		MPI_Reduce(MPI_IN_PLACE, sum.data(), n_sketch, MPI_DOUBLE, MPI_SUM, 0, IO_WORLD);
+		MPI_Reduce(MPI_IN_PLACE, ext.data(), 2 * n_sketch, MPI_DOUBLE, MPI_MAX, 0, IO_WORLD);
+	}
+	else
+	{
+		MPI_Reduce(count.data(), NULL, count.size(), MPI_LONG_LONG, MPI_SUM, 0, IO_WORLD);
+		MPI_Reduce(sum.data(), NULL, n_sketch, MPI_DOUBLE, MPI_SUM, 0, IO_WORLD);
+		MPI_Reduce(ext.data(), NULL, 2 * n_sketch, MPI_DOUBLE, MPI_MAX, 0, IO_WORLD);
+		return;
+	}
+
+	for (int k = 0; k < n_sketch; k++)
+	{
+		IOsketch &s = *out[k];
+		s.min_value = in[k]->min_value;
+		s.log_gamma = in[k]->log_gamma;
+		std::copy(count.begin() + (size_t)k * SKETCH_BINS, count.begin() + (size_t)(k + 1) * SKETCH_BINS, s.bins.begin());
+		s.n = 0;
+		for (int i = 0; i < SKETCH_BINS; i++)
+			s.n += s.bins[i];
+		s.sum = sum[k];
+		s.min = -ext[2 * k];
+		s.max = ext[2 * k + 1];
+	}
+}
@@ -0,0 +1,140 @@
+#include "iotelemetry.h"
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @file iotelemetry.cxx
+ * @brief Contains definitions of methods from the \e IOtelemetry class.
+ */
+
+//! ------------------------------ Segment ---------------------------------
+//************************************************************************************
+//*                               1. Create
+//************************************************************************************
+/**
+ * @brief creates the segment of the node and marks all slots as unused. Called by the first local rank before the
+ * others attach. An existing segment with the same name is never replaced, as it may belong to another job
+ *
+ * @param name [in] name of the segment (shm_open, see \e io_telemetry_name)
+ * @param n_slots [in] number of local ranks
+ * @return true if the segment was created
+ */
+bool IOtelemetry::Create(const std::string &name, int n_slots)
+{
+	size_t bytes = sizeof(io_telemetry_header) + n_slots * sizeof(io_telemetry_slot);
+	int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+	if (fd < 0 && errno == EEXIST)
+	{
+		printf("IOtelemetry: %s exists (another job or a crashed run). Remove /dev/shm%s or set TMIO_TELEMETRY_NAME\n", name.c_str(), name.c_str());
+		return false;
+	}
+	if (fd < 0 || ftruncate(fd, bytes) != 0)
+	{
+		printf("IOtelemetry: could not create %s\n", name.c_str());
+		if (fd >= 0)
+		{
+			close(fd);
+			shm_unlink(name.c_str());
+		}
+		return false;
+	}
+	void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED)
+	{
+		shm_unlink(name.c_str());
+		return false;
+	}
+
+	// the new segment is zeroed: only the header and the unused ranks have to be set
+	io_telemetry_header *h = (io_telemetry_header *)p;
+	h->version = IO_TELEMETRY_VERSION;
+	h->n_slots = n_slots;
+	h->slot_size = sizeof(io_telemetry_slot);
+	h->size = bytes;
+	io_telemetry_slot *s = (io_telemetry_slot *)((char *)p + sizeof(io_telemetry_header));
+	for (int i = 0; i < n_slots; i++)
+		s[i].state.rank = -1;
+	std::atomic_thread_fence(std::memory_order_release);
+	memcpy(h->magic, IO_TELEMETRY_MAGIC, 8);
+
+	munmap(p, bytes);
+	owner = true;
+	this->name = name;
+	return true;
+}
+
+//************************************************************************************
+//*                               2. Attach
+//************************************************************************************
+/**
+ * @brief maps the segment and claims a slot. Nothing is published if the segment is missing or too small
+ *
+ * @param name [in] name of the segment
+ * @param i [in] slot (local rank)
+ * @param rank [in] rank in MPI_COMM_WORLD
+ * @param now [in] current trace time (seconds since the start of the trace)
+ * @return true if the slot was claimed
+ */
+bool IOtelemetry::Attach(const std::string &name, int i, int rank, double now)
+{
+	int fd = shm_open(name.c_str(), O_RDWR, 0);
+	struct stat st;
+	if (fd < 0 || fstat(fd, &st) != 0)
+	{
+		printf("IOtelemetry: rank %i could not open %s\n", rank, name.c_str());
+		if (fd >= 0)
+			close(fd);
+		return false;
+	}
+	void *p = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED)
+		return false;
+	base = (char *)p;
+	size = st.st_size;
+
+	io_telemetry_header *h = (io_telemetry_header *)base;
+	if (memcmp(h->magic, IO_TELEMETRY_MAGIC, 8) != 0 || h->slot_size != sizeof(io_telemetry_slot) || i >= (int)h->n_slots)
+	{
+		printf("IOtelemetry: rank %i found no slot in %s\n", rank, name.c_str());
+		Close();
+		return false;
+	}
+
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	slot = (io_telemetry_slot *)(base + sizeof(io_telemetry_header)) + i;
+	seq = slot->seq.load(std::memory_order_relaxed) & ~1ULL;
+	Begin(0, now);
+	slot->state.rank = rank;
+	slot->state.pid = getpid();
+	slot->state.t_epoch = ts.tv_sec + ts.tv_nsec * 1e-9 - now;
+	for (int m = 0; m < IO_TELEMETRY_MODES; m++)
+	{
+		slot->state.mode[m].b_last = NAN;
+		slot->state.mode[m].t_last = NAN;
+	}
+	End();
+	this->name = name;
+	return true;
+}
+
+//************************************************************************************
+//*                               3. Close
+//************************************************************************************
+/**
+ * @brief unmaps the segment. The rank that created it also removes it (readers that mapped it keep their mapping)
+ */
+void IOtelemetry::Close(void)
+{
+	if (base)
+		munmap(base, size);
+	if (owner)
+		shm_unlink(name.c_str());
+	slot = NULL;
+	base = NULL;
+	size = 0;
+	owner = false;
+}
@@ -0,0 +1,161 @@
+#include "iothread.h"
+
+/**
+ * @file iothread.cxx
+ * @brief Contains definitions of methods from the \e IOthread class.
+ * @details The chunk list is a single producer single consumer queue: only the owning thread calls
+ * \e Push, only the thread holding the drain lock of \e IOtrace calls \e Peek and \e Pop. A chunk is
+ * published record by record through \e n and linked through \e next once it is full. The producer
+ * never touches a chunk again after linking its successor, so the consumer can free it.
+ */
+
+IOthread::IOthread(void)
+{
+	t_sync_write_start = 0;
+	t_sync_read_start = 0;
+	size_sync_write = 0;
+	size_sync_read = 0;
+	offset_sync_write = 0;
+	offset_sync_read = 0;
+	t_overhead = 0;
+	pending = 0;
+	next = NULL;
+
+	low.store(INFINITY, std::memory_order_relaxed);
+	t_last = 0;
+	in_flight = false;
+	tail = new io_chunk();
+	tail_n = 0;
+	head = tail;
+	head_n = 0;
+	overhead.store(0, std::memory_order_relaxed);
+	overhead_taken = 0;
+}
+
+IOthread::~IOthread(void)
+{
+	while (head != NULL)
+	{
+		io_chunk *tmp = head->next.load(std::memory_order_acquire);
+		delete head;
+		head = tmp;
+	}
+}
+
+//! ------------------------------ Producer -------------------------------
+//************************************************************************************
+//*                               1. Enter
+//************************************************************************************
+/**
+ * @brief starts a traced call. The time of the last record is published as low-watermark with a sequentially
+ * consistent store before the clock is read, so a drain that does not see it took its cut before the time stamp
+ * of the call (see \e IOtrace::Drain). A call that is already in flight (sync call between Start and End)
+ * keeps its low-watermark
+ *
+ * @return true if the call holds the low-watermark now and its time stamp has to be passed to \e Stamp
+ */
+bool IOthread::Enter(void)
+{
+	if (in_flight)
+		return false;
+	in_flight = true;
+	low.store(t_last, std::memory_order_seq_cst);
+	return true;
+}
+
+//************************************************************************************
+//*                               2. Stamp
+//************************************************************************************
+/**
+ * @brief raises the low-watermark to the time stamp of the call in flight
+ *
+ * @param t [in] time stamp of the call
+ */
+void IOthread::Stamp(double t)
+{
+	low.store(t, std::memory_order_release);
+}
+
+//************************************************************************************
+//*                               3. Push
+//************************************************************************************
+/**
+ * @brief appends a record to the chunk list. A new chunk is linked once the current one is full. The record is
+ * published before the low-watermark is cleared, so a drain that sees the cleared low-watermark also sees the record
+ *
+ * @param r [in] record to append
+ */
+void IOthread::Push(const io_record &r)
+{
+	if (tail_n == IOTHREAD_CHUNK)
+	{
+		io_chunk *chunk = new io_chunk();
+		tail->next.store(chunk, std::memory_order_release);
+		tail = chunk;
+		tail_n = 0;
+	}
+	tail->records[tail_n] = r;
+	tail->n.store(++tail_n, std::memory_order_release);
+	t_last = r.t;
+	in_flight = false;
+	low.store(INFINITY, std::memory_order_release);
+}
+
+//************************************************************************************
+//*                               4. Add_Overhead
+//************************************************************************************
+void IOthread::Add_Overhead(double t)
+{
+	overhead.store(overhead.load(std::memory_order_relaxed) + t, std::memory_order_relaxed);
+}
+
+//! ------------------------------ Consumer -------------------------------
+//************************************************************************************
+//*                               1. Peek
+//************************************************************************************
+/**
+ * @brief returns the oldest record that was not consumed yet
+ *
+ * @return const io_record* record or NULL if no published record is left
+ */
+const io_record *IOthread::Peek(void)
+{
+	while (true)
+	{
+		if (head_n < head->n.load(std::memory_order_acquire))
+			return &head->records[head_n];
+
+		if (head_n < IOTHREAD_CHUNK)
+			return NULL;
+
+		io_chunk *chunk = head->next.load(std::memory_order_acquire);
+		if (chunk == NULL)
+			return NULL;
+
+		delete head;
+		head = chunk;
+		head_n = 0;
+	}
+}
+
+//************************************************************************************
+//*                               2. Pop
+//************************************************************************************
+void IOthread::Pop(void)
+{
+	head_n++;
+}
+
+//************************************************************************************
+//*                               3. Take_Overhead
+//************************************************************************************
+/**
+ * @brief returns the overhead the thread accumulated since the last call
+ */
+double IOthread::Take_Overhead(void)
+{
+	double total = overhead.load(std::memory_order_relaxed);
+	double delta = total - overhead_taken;
+	overhead_taken = total;
+	return delta;
+}
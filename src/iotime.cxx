@@ -16,7 +16,7 @@ iotime::~iotime(void)
  * @details -
  *
  * @param t array contating (1) total application time (aggregated), (2) lib I/O overhead at
- * end of application, and (3) lib I/O overhead time (aggregated) during runtime of application controlled with \e OVERHEAD flag (see ioflags.h)
+ * end of application, and (3) lib I/O overhead time (aggregated) during runtime of application (0 without OVERHEAD, see ioconfig.h)
  * @param t_rank_0 ellapsed time of rank 0
  * @param sr statistics object representing synchnous read
  * @param ara statistics object representing asynchnous read (throughput)
@@ -24,17 +24,14 @@ iotime::~iotime(void)
  * @param sw statistics object representing synchnous write
  * @param awa statistics object representing asynchnous write (throughput)
  * @param awr statistics object representing asynchnous write (bandwidth)
+ * @param t_clock [in,optional] max clock offset and max estimated error over all ranks (see CLOCK_SYNC)
  */
-iotime::iotime(double *t, double *t_rank_0, statistics sr, statistics ar, statistics sw, statistics aw)
+iotime::iotime(double *t, double *t_rank_0, const statistics &sr, const statistics &ar, const statistics &sw, const statistics &aw, double *t_clock)
 {
 	//? overhead
 	//?---------------
 	delta_t_overhead_post_runtime = t[1];
-#if OVERHEAD == 1
 	delta_t_overhead_peri_runtime = t[2];
-#else
-	delta_t_overhead_peri_runtime = 0;
-#endif
 	delta_t_overhead = delta_t_overhead_post_runtime + delta_t_overhead_peri_runtime;
 #if DFT == 1
 	delta_t_overhead_dft = sr.dft_time + sw.dft_time + ar.dft_time + aw.dft_time; // dft overhead is part of the total overhead
@@ -64,6 +61,9 @@ iotime::iotime(double *t, double *t_rank_0, statistics sr, statistics ar, statis
 	delta_t_rank0_app = deta_t_rank0_vec[0] - deta_t_rank0_vec[1];
 	delta_t_rank0_overhead_post_runtime = deta_t_rank0_vec[2];
 	delta_t_rank0_overhead_peri_runtime = deta_t_rank0_vec[1];
+	// clock alignment
+	t_clock_offset = t_clock ? t_clock[0] : 0;
+	t_clock_error = t_clock ? t_clock[1] : 0;
 }
 
 /**
@@ -71,16 +71,18 @@ iotime::iotime(double *t, double *t_rank_0, statistics sr, statistics ar, statis
  *
  * @param file [in] file to which to print to
  */
-void iotime::print(std::ofstream &file)
+void iotime::print(std::ofstream &file) const
 {
 
-	int values = 21;
-#if OVERHEAD == 1
-	values += 2;
+	const bool overhead = ioconfig::Get().overhead;
+	int values = 22;
+	if (overhead)
+	{
+		values += 2;
 #if DFT == 1
-	values += 1;
-#endif
+		values += 1;
 #endif
+	}
 
 	char out[values][150];
 	double tmp = 0;
@@ -92,16 +94,17 @@ void iotime::print(std::ofstream &file)
 	sprintf(out[counter++], "%s|->%s overhead during runtime        = %f sec \t-> from ellapsed time %s%.2f %%%s\n", BLUE, BLACK, delta_t_rank0_overhead_peri_runtime, Color_Percent(100 * delta_t_rank0_overhead_peri_runtime / (delta_t_rank0)), 100 * delta_t_rank0_overhead_peri_runtime / (delta_t_rank0), BLACK);
 	sprintf(out[counter++], "%s'->%s overhead post runtime          = %f sec \t-> from ellapsed time %s%.2f %%%s\n\n", BLUE, BLACK, delta_t_rank0_overhead_post_runtime, Color_Percent(100 * delta_t_rank0_overhead_post_runtime / (delta_t_rank0)), 100 * delta_t_rank0_overhead_post_runtime / (delta_t_rank0), BLACK);
 	sprintf(out[counter++], "%stotal run time%s                     = %f sec\n", BLUE, BLACK, total);
-#if OVERHEAD == 1
-	sprintf(out[counter++], "%s|->%s lib overhead time%s              = %f sec \t-> from run time %s%.2f %%%s\n", BLUE, RED, BLACK, delta_t_overhead, Color_Percent(100 * delta_t_overhead / total), 100 * delta_t_overhead / total, BLACK);
-	sprintf(out[counter++], "%s|%s     |->%s during runtime           = %f sec \t-> from overhead %s%.2f %%%s\n", BLUE, RED, BLACK, delta_t_overhead_peri_runtime, Color_Percent(100 * delta_t_overhead_peri_runtime / delta_t_overhead), 100 * delta_t_overhead_peri_runtime / delta_t_overhead, BLACK);
-	sprintf(out[counter++], "%s|%s     '->%s post runtime             = %f sec \t-> from overhead %s%.2f %%%s\n", BLUE, RED, BLACK, delta_t_overhead_post_runtime, Color_Percent(100 * delta_t_overhead_post_runtime / delta_t_overhead), 100 * delta_t_overhead_post_runtime / delta_t_overhead, BLACK);
+	if (overhead)
+	{
+		sprintf(out[counter++], "%s|->%s lib overhead time%s              = %f sec \t-> from run time %s%.2f %%%s\n", BLUE, RED, BLACK, delta_t_overhead, Color_Percent(100 * delta_t_overhead / total), 100 * delta_t_overhead / total, BLACK);
+		sprintf(out[counter++], "%s|%s     |->%s during runtime           = %f sec \t-> from overhead %s%.2f %%%s\n", BLUE, RED, BLACK, delta_t_overhead_peri_runtime, Color_Percent(100 * delta_t_overhead_peri_runtime / delta_t_overhead), 100 * delta_t_overhead_peri_runtime / delta_t_overhead, BLACK);
+		sprintf(out[counter++], "%s|%s     '->%s post runtime             = %f sec \t-> from overhead %s%.2f %%%s\n", BLUE, RED, BLACK, delta_t_overhead_post_runtime, Color_Percent(100 * delta_t_overhead_post_runtime / delta_t_overhead), 100 * delta_t_overhead_post_runtime / delta_t_overhead, BLACK);
 #if DFT == 1
-	sprintf(out[counter++], "%s|%s         '->%s dft overhead         = %f sec \t-> from overhead %s%.2f %%%s\n", BLUE, RED, BLACK, delta_t_overhead_dft, Color_Percent(100 * delta_t_overhead_dft / delta_t_overhead), 100 * delta_t_overhead_dft / delta_t_overhead, BLACK);
-#endif
-#else
-	sprintf(out[counter++], "%s|->%s lib overhead time              = %f sec \t-> from run time %s%.2f %%%s\n", BLUE, BLACK, delta_t_overhead, Color_Percent(100 * delta_t_overhead / total), 100 * delta_t_overhead / total, BLACK);
+		sprintf(out[counter++], "%s|%s         '->%s dft overhead         = %f sec \t-> from overhead %s%.2f %%%s\n", BLUE, RED, BLACK, delta_t_overhead_dft, Color_Percent(100 * delta_t_overhead_dft / delta_t_overhead), 100 * delta_t_overhead_dft / delta_t_overhead, BLACK);
 #endif
+	}
+	else
+		sprintf(out[counter++], "%s|->%s lib overhead time              = %f sec \t-> from run time %s%.2f %%%s\n", BLUE, BLACK, delta_t_overhead, Color_Percent(100 * delta_t_overhead / total), 100 * delta_t_overhead / total, BLACK);
 	sprintf(out[counter++], "%s|\n'->%s app time%s                       = %f sec \t-> from run time %s%.2f %%%s\n", BLUE, GREEN, BLACK, delta_t_agg, Color_Percent(100 - 100 * delta_t_agg / total), 100 * delta_t_agg / total, BLACK);
 	tmp = delta_t_agg - delta_t_agg_io;
 	sprintf(out[counter++], "%s    |->%s total compute/comm. time   = %f sec \t-> from app time %s%.2f %%%s\n", GREEN, BLACK, tmp, Color_Percent(100 - 100 * tmp / delta_t_agg), 100 * tmp / delta_t_agg, BLACK);
@@ -122,6 +125,7 @@ void iotime::print(std::ofstream &file)
 	sprintf(out[counter++], "%s             |->%s approx. wait time = %s%f%s sec \t-> from app time %s%.2f %%%s\n", CYAN, BLACK, (tmp > 0) ? RED : GREEN, tmp, BLACK, Color_Percent(100 * tmp / delta_t_agg), 100 * tmp / delta_t_agg, BLACK);
 	tmp = delta_t_aw_lost;
 	sprintf(out[counter++], "%s             '->%s real wait time    = %s%f%s sec \t-> from app time %s%.2f %%%s\n\n", CYAN, BLACK, (tmp > 0) ? RED : GREEN, tmp, BLACK, Color_Percent(100 * tmp / delta_t_agg), 100 * tmp / delta_t_agg, BLACK);
+	sprintf(out[counter++], "clock offset (max)                 = %e sec \t-> estimated error %e sec\n\n", t_clock_offset, t_clock_error);
 
 	// std::cout << "counter: " << counter << "  --  values: " << values << std::endl;
 	for (int i = 0; i < values; i++)
@@ -131,9 +135,9 @@ void iotime::print(std::ofstream &file)
 	}
 }
 
-std::string iotime::Print_Json(bool jsonl)
+std::string iotime::Print_Json(bool jsonl) const
 {
-	int len = 19;
+	int len = 21;
 	char buff[len][65];
 	std::string out;
 	char line_start[3] = {'\0', '\0', '\0'};
@@ -164,12 +168,14 @@ std::string iotime::Print_Json(bool jsonl)
 	sprintf(buff[14], "%s\"delta_t_rank0\": %.2e,%s", line_start, delta_t_rank0, line_end);
 	sprintf(buff[15], "%s\"delta_t_rank0_app\": %.2e,%s", line_start, delta_t_rank0_app, line_end);
 	sprintf(buff[16], "%s\"delta_t_rank0_overhead_post_runtime\": %.2e,%s", line_start, delta_t_rank0_overhead_post_runtime, line_end);
-	sprintf(buff[17], "%s\"delta_t_rank0_overhead_peri_runtime\": %.2e%s", line_start, delta_t_rank0_overhead_peri_runtime, line_end);
+	sprintf(buff[17], "%s\"delta_t_rank0_overhead_peri_runtime\": %.2e,%s", line_start, delta_t_rank0_overhead_peri_runtime, line_end);
+	sprintf(buff[18], "%s\"t_clock_offset\": %.2e,%s", line_start, t_clock_offset, line_end);
+	sprintf(buff[19], "%s\"t_clock_error\": %.2e%s", line_start, t_clock_error, line_end);
 
 	if (jsonl == true)
-		sprintf(buff[18], "}}\n");
+		sprintf(buff[20], "}}\n");
 	else
-		sprintf(buff[18], "\t\t}\n");
+		sprintf(buff[20], "\t\t}\n");
 
 	for (int i = 0; i < len; i++)
 		out.append(buff[i]);
@@ -177,7 +183,35 @@ std::string iotime::Print_Json(bool jsonl)
 	return out;
 }
 
-const char *iotime::Color_Percent(double percentage)
+/**
+ * @brief adds the times as scalar columns "io_time/<name>" (same names as \e Print_Json)
+ *
+ * @param out [in,out] columns of the binary file
+ */
+void iotime::Columns(IOcolumns &out) const
+{
+	out.Add(name + "/delta_t_agg", delta_t_agg);
+	out.Add(name + "/delta_t_agg_io", delta_t_agg_io);
+	out.Add(name + "/delta_t_sr", delta_t_sr);
+	out.Add(name + "/delta_t_ara", delta_t_ara);
+	out.Add(name + "/delta_t_arr", delta_t_arr);
+	out.Add(name + "/delta_t_ar_lost", delta_t_ar_lost);
+	out.Add(name + "/delta_t_sw", delta_t_sw);
+	out.Add(name + "/delta_t_awa", delta_t_awa);
+	out.Add(name + "/delta_t_awr", delta_t_awr);
+	out.Add(name + "/delta_t_aw_lost", delta_t_aw_lost);
+	out.Add(name + "/delta_t_overhead", delta_t_overhead);
+	out.Add(name + "/delta_t_overhead_post_runtime", delta_t_overhead_post_runtime);
+	out.Add(name + "/delta_t_overhead_peri_runtime", delta_t_overhead_peri_runtime);
+	out.Add(name + "/delta_t_rank0", delta_t_rank0);
+	out.Add(name + "/delta_t_rank0_app", delta_t_rank0_app);
+	out.Add(name + "/delta_t_rank0_overhead_post_runtime", delta_t_rank0_overhead_post_runtime);
+	out.Add(name + "/delta_t_rank0_overhead_peri_runtime", delta_t_rank0_overhead_peri_runtime);
+	out.Add(name + "/t_clock_offset", t_clock_offset);
+	out.Add(name + "/t_clock_error", t_clock_error);
+}
+
+const char *iotime::Color_Percent(double percentage) const
 {
 	// generates colored output
 
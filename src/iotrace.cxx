@@ -21,23 +21,25 @@ IOtrace::IOtrace(void)
     open = 0;
 
     t_async_write_start = std::numeric_limits<double>::quiet_NaN();
-    t_sync_write_start  = std::numeric_limits<double>::quiet_NaN();
     t_async_read_start  = std::numeric_limits<double>::quiet_NaN();
-    t_sync_read_start   = std::numeric_limits<double>::quiet_NaN();
+    t_sync_write_end    = std::numeric_limits<double>::quiet_NaN();
+    t_sync_read_end     = std::numeric_limits<double>::quiet_NaN();
 
     size_async_write = 0;
-    size_sync_write  = 0;
     size_async_read  = 0;
-    size_sync_read   = 0;
 }
 
 /**
  * @brief sets the attribute rank to the current MPI rank
+ * @param multiple [in,optional] true if MPI_THREAD_MULTIPLE was provided. Calls are then recorded per thread
  */
-void IOtrace::Init(void)
+void IOtrace::Init(bool multiple)
 {
+    thread_multiple = multiple;
 
-    t_0 = MPI_Wtime();
+    // map the trace clock to MPI_Wtime
+    clock.Calibrate();
+    t_0 = clock.Now();
     t_summary = t_0;
     //? create copy of communicator
     MPI_Comm_dup(MPI_COMM_WORLD, &IO_WORLD);
@@ -51,12 +53,66 @@ void IOtrace::Init(void)
     MPI_Comm_rank(IO_WORLD, &rank);
     MPI_Comm_size(IO_WORLD, &processes);
 
+    //? runtime settings (TMIO_* variables, see ioconfig.h). Needed by Mode to select the recorders
+    ioconfig::Load(IO_WORLD);
+    const io_config &cfg = ioconfig::Get();
+    overhead_start = cfg.overhead ? &IOtrace::Overhead_Start_Traced<true> : &IOtrace::Overhead_Start_Traced<false>;
+    overhead_end = cfg.overhead ? &IOtrace::Overhead_End_Traced<true> : &IOtrace::Overhead_End_Traced<false>;
+
+#if CLOCK_SYNC > 0
+    //? align the relative time of this rank to the one of rank 0
+    clock_offset = clock.Offset(t_0, rank, processes, IO_WORLD, clock_error);
+    t_0 -= clock_offset;
+#endif
+
     //? init tracers for the 4 modes:
     p_aw->Mode(rank, 1);    // async write
     p_ar->Mode(rank, 0);    // async read
     p_sw->Mode(rank, 1, 0); // sync write
     p_sr->Mode(rank, 0, 0); // sync read
 
+    //? one telemetry segment per node: the first local rank creates it, every rank publishes in its own slot
+    if (cfg.telemetry)
+    {
+        MPI_Comm node;
+        int local = 0;
+        int n_local = 1;
+        MPI_Comm_split_type(IO_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node);
+        MPI_Comm_rank(node, &local);
+        MPI_Comm_size(node, &n_local);
+        int created = (local == 0) ? telemetry.Create(cfg.telemetry_name, n_local) : 0;
+        MPI_Bcast(&created, 1, MPI_INT, 0, node);
+        if (created && telemetry.Attach(cfg.telemetry_name, local, rank, clock.Now() - t_0))
+        {
+            p_aw->telemetry = &telemetry;
+            p_ar->telemetry = &telemetry;
+            p_sw->telemetry = &telemetry;
+            p_sr->telemetry = &telemetry;
+        }
+        MPI_Comm_free(&node);
+    }
+
+    //? flush communicator and thread
+    FLUSH_WORLD = IO_WORLD;
+#if ASYNC_FLUSH == 1
+    back_aw.Mode(rank, 1);
+    back_ar.Mode(rank, 0);
+    back_sw.Mode(rank, 1, 0);
+    back_sr.Mode(rank, 0, 0);
+    int level = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&level);
+    int provided = (level == MPI_THREAD_MULTIPLE);
+    MPI_Allreduce(MPI_IN_PLACE, &provided, 1, MPI_INT, MPI_LAND, IO_WORLD);
+    if (provided)
+    {
+        // the background flush has its own communicator, so its collectives never mix with the ones of Summary
+        MPI_Comm_dup(IO_WORLD, &FLUSH_WORLD);
+        worker.Start();
+    }
+    else if (rank == 0)
+        printf("%sWarning: MPI_THREAD_MULTIPLE is not provided. ASYNC_FLUSH is disabled, summaries are flushed synchronously%s\n", RED, BLACK);
+#endif
+
 	#if defined BW_LIMIT || defined CUSTOM_MPI
 		bw_limit.Init(rank, processes, p_aw, p_ar, p_sw, p_sr);
 	#endif 
@@ -67,6 +123,15 @@ void IOtrace::Init(void)
 	#if defined BW_LIMIT || defined CUSTOM_MPI
 		info = bw_limit.Info();
 	#endif
+	#if FILE_FORMAT > 2
+		// one socket for all summaries
+		if (cfg.file_format == 3)
+		{
+			publisher = new IOpublisher();
+			if (publisher->Connect(cfg.publisher_endpoint))
+				info += "Publish : " + publisher->Endpoint() + "\n";
+		}
+	#endif
         printf("\n===========================\n"
 		"        TMIO Settings      \n"
 		"===========================\n"
@@ -74,30 +139,52 @@ void IOtrace::Init(void)
 		"Calc    : %i\n"
 		"Samples : %i\n"
 		"%s\n"
-		"%s===========================\n\n", TEST, DO_CALC, ALL_SAMPLES, iohf::Get_File_Format(FILE_FORMAT).c_str(), info.c_str());
+		"%s"
+		"%s\n"
+		"%s===========================\n\n", TEST, DO_CALC, cfg.all_samples, iohf::Get_File_Format(cfg.file_format).c_str(), ioconfig::Info().c_str(), clock.Info().c_str(), info.c_str());
 	}
 #if IOTRACE_VERBOSE >= 1
-    printf("%s > rank %i / %i %s> I/O tracer initiated %s\n", caller, rank, processes - 1, BLUE, BLACK);
+    printf("%s > rank %i / %i %s> I/O tracer initiated (thread multiple: %i) %s\n", caller, rank, processes - 1, BLUE, thread_multiple, BLACK);
 #endif
 }
 
 /**
  * @brief displays a summary of the results to the out stream.
  *  @param finalize: if true, summary is called through MPI_finalize -> remove all unended data
+ * @details closes the interval on the calling thread and passes the data to \e Flush. With ASYNC_FLUSH, an online
+ * summary only swaps the data into the second buffers and hands the flush over to the worker thread
  */
 void IOtrace::Summary(void)
 {
     //iohf::Function_Debug(__PRETTY_FUNCTION__);
-    delta_t_app = delta_t_app + (MPI_Wtime() - t_summary);
+    double t_request = clock.Now();
+    delta_t_app = delta_t_app + (t_request - t_summary);
+
+    // re-estimate the trace clock against MPI_Wtime
+    clock.Calibrate();
+
+#if CLOCK_SYNC == 2
+    // re-estimate the offset to rank 0. The residual is applied to the next interval and reported as error
+    double residual = clock.Offset(t_0, rank, processes, IO_WORLD, clock_error);
+    clock_error += fabs(residual);
+    clock_offset += residual;
+    t_0 -= residual;
+#endif
     // printf("%s > rank %i > generating I/O summary start %f \n", caller, rank,delta_t_app);
 
     Time_Info("Summary > Started at");
 #if IOTRACE_VERBOSE >= 1
     // if (rank == 0)
-    // printf("%s > rank %i %s> Elapsed time: %e s %s\n", caller, rank, GREEN, MPI_Wtime() - t_0, BLACK);
+    // printf("%s > rank %i %s> Elapsed time: %e s %s\n", caller, rank, GREEN, clock.Now() - t_0, BLACK);
     printf("%s > rank %i > generating I/O summary \n", caller, rank);
+    printf("%s > rank %i %s> trace clock deviated by %e s from MPI_Wtime %s\n", caller, rank, BLUE, clock.Drift(), BLACK);
 #endif
 
+    // replay the records of all threads and collect their overhead. Waits for a drain started by another thread
+    while (draining.exchange(true, std::memory_order_acquire))
+        std::this_thread::yield();
+    Drain();
+
     // close phases if flie close was skipped
     if (p_sw->phase || p_sr->phase)
     {
@@ -107,23 +194,98 @@ void IOtrace::Summary(void)
             printf("%sWarning: File was not closed. Close file to obtained accurate information for sync I/O operations%s\n ", RED, BLACK);
     }
 
-#if ONLINE == 0 // consider individual requests
-    p_aw->Bandwidth_In_Phase_Offline();
-    p_ar->Bandwidth_In_Phase_Offline();
-    p_sw->Bandwidth_In_Phase_Offline();
-    p_sr->Bandwidth_In_Phase_Offline();
-#endif
+    if (!finalize)
+        online_file_generation = true;
+    io_interval interval = {delta_t_app, delta_t_io_overhead, t_request, -1, clock_offset, clock_error, finalize, online_file_generation};
+
+    if (worker.Running() && !finalize)
+    {
+        //? asynchronous: the previous flush released the second buffers
+        worker.Wait();
+        back_aw.Swap_IO(aw);
+        back_ar.Swap_IO(ar);
+        back_sw.Swap_IO(sw);
+        back_sr.Swap_IO(sr);
+        interval.t_blocked = clock.Now() - t_request;
+        worker.Run([this, interval]()
+                   {
+                       Flush(&back_aw, &back_ar, &back_sw, &back_sr, interval);
+                       back_aw.Clear_IO();
+                       back_ar.Clear_IO();
+                       back_sw.Clear_IO();
+                       back_sr.Clear_IO();
+                   });
+    }
+    else
+    {
+        //? synchronous (and always at MPI_Finalize, after the last background flush)
+        worker.Stop();
+        Flush(p_aw, p_ar, p_sw, p_sr, interval);
+        if (!finalize)
+        {
+            p_sw->Clear_IO();
+            p_sr->Clear_IO();
+            p_aw->Clear_IO();
+            p_ar->Clear_IO();
+        }
+    }
+
+    if (finalize)
+    {
+        p_aw->telemetry = NULL;
+        p_ar->telemetry = NULL;
+        p_sw->telemetry = NULL;
+        p_sr->telemetry = NULL;
+        telemetry.Close();
+        Free_Threads();
+        IOgather::Free();
+        // the worker was stopped before the last flush, so no thread uses the communicators anymore
+        if (FLUSH_WORLD != IO_WORLD)
+            MPI_Comm_free(&FLUSH_WORLD);
+        MPI_Comm_free(&IO_WORLD);
+        FLUSH_WORLD = MPI_COMM_NULL;
+    }
+
+    if (!finalize){
+        t_summary = clock.Now();
+        delta_t_app = 0;
+        delta_t_io_overhead = 0;
+
+        #if defined BW_LIMIT || defined CUSTOM_MPI
+        bw_limit.Reset();
+        #endif
+    }
+    draining.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief gathers the data of an interval from all ranks, computes the statistics and writes the output.
+ * Collective over FLUSH_WORLD. Runs on the worker thread with ASYNC_FLUSH, so it only uses the data passed to it
+ *
+ * @param d_aw [in,out] async write data of the interval (d_ar, d_sw and d_sr: async read, sync write and sync read)
+ * @param interval [in] times and flags of the interval
+ */
+void IOtrace::Flush(IOdata *d_aw, IOdata *d_ar, IOdata *d_sw, IOdata *d_sr, const io_interval &interval)
+{
+    const io_config &cfg = ioconfig::Get();
+    if (!cfg.online) // consider individual requests
+    {
+        d_aw->Bandwidth_In_Phase_Offline();
+        d_ar->Bandwidth_In_Phase_Offline();
+        d_sw->Bandwidth_In_Phase_Offline();
+        d_sr->Bandwidth_In_Phase_Offline();
+    }
 
     // number of I/O operations each rank performed ({async write, async read, sync write, sync read})
     n_struct n = {
-				(int)p_aw->phase_data.size(),
-				(int)p_ar->phase_data.size(),
-                (int)p_sw->phase_data.size(),
-                (int)p_sr->phase_data.size()
+				(int)d_aw->phase_data.size(),
+				(int)d_ar->phase_data.size(),
+                (int)d_sw->phase_data.size(),
+                (int)d_sr->phase_data.size()
 				};
 
     // Gather all n from all ranks
-    n_struct *all_n = ioanalysis::Gather_N_OP(n, rank, processes, IO_WORLD);
+    n_struct *all_n = ioanalysis::Gather_N_OP(n, rank, processes, FLUSH_WORLD);
 
 #if IOTRACE_VERBOSE >= 2
     printf("%s > rank %i > generating I/O summary %s>> n.aw %i, n.ar %i, n.sw %i, n.sr %i, %s\n", caller, rank, GREEN, n.aw, n.ar, n.sw, n.sr, BLACK);
@@ -136,147 +298,227 @@ void IOtrace::Summary(void)
     ioanalysis::Sum_N(all_n, n_phase, rank, processes);
 
     // Extracts arrays contating number of phases from all_n
-    int *all_n_aw = ioanalysis::Get_N_From_ALL_N(p_aw, all_n, rank, processes);
-    int *all_n_ar = ioanalysis::Get_N_From_ALL_N(p_ar, all_n, rank, processes);
-    int *all_n_sw = ioanalysis::Get_N_From_ALL_N(p_sw, all_n, rank, processes);
-    int *all_n_sr = ioanalysis::Get_N_From_ALL_N(p_sr, all_n, rank, processes);
-
-    // get all data
-    collect *all_aw = ioanalysis::Gather_Collect(p_aw, all_n_aw, rank, processes, IO_WORLD, finalize);
-    collect *all_ar = ioanalysis::Gather_Collect(p_ar, all_n_ar, rank, processes, IO_WORLD, finalize);
-    collect *all_sw = ioanalysis::Gather_Collect(p_sw, all_n_sw, rank, processes, IO_WORLD, finalize);
-    collect *all_sr = ioanalysis::Gather_Collect(p_sr, all_n_sr, rank, processes, IO_WORLD, finalize);
+    int *all_n_aw = ioanalysis::Get_N_From_ALL_N(d_aw, all_n, rank, processes);
+    int *all_n_ar = ioanalysis::Get_N_From_ALL_N(d_ar, all_n, rank, processes);
+    int *all_n_sw = ioanalysis::Get_N_From_ALL_N(d_sw, all_n, rank, processes);
+    int *all_n_sr = ioanalysis::Get_N_From_ALL_N(d_sr, all_n, rank, processes);
+
+    // get all data (only needed on rank 0 for printing the phases of the ranks or for the overlap calculation)
+    collect *all_aw = NULL;
+    collect *all_ar = NULL;
+    collect *all_sw = NULL;
+    collect *all_sr = NULL;
+    if (cfg.all_samples > 2 || DO_CALC > 0 || cfg.file_format > 1)
+    {
+        all_aw = ioanalysis::Gather_Collect(d_aw, all_n_aw, rank, processes, FLUSH_WORLD);
+        all_ar = ioanalysis::Gather_Collect(d_ar, all_n_ar, rank, processes, FLUSH_WORLD);
+        all_sw = ioanalysis::Gather_Collect(d_sw, all_n_sw, rank, processes, FLUSH_WORLD);
+        all_sr = ioanalysis::Gather_Collect(d_sr, all_n_sr, rank, processes, FLUSH_WORLD);
+    }
 
 // Communication test
 #if IOTRACE_VERBOSE > 0
     int flag = 0;
     if (rank != 0)
-        MPI_Recv(&flag, 1, MPI_INT, rank - 1, 100, IO_WORLD, MPI_STATUS_IGNORE);
+        MPI_Recv(&flag, 1, MPI_INT, rank - 1, 100, FLUSH_WORLD, MPI_STATUS_IGNORE);
 
     fflush(stdout);
 
     if (rank < processes - 1)
-        MPI_Send(&flag, 1, MPI_INT, rank + 1, 100, IO_WORLD);
+        MPI_Send(&flag, 1, MPI_INT, rank + 1, 100, FLUSH_WORLD);
 #endif
     //-----------------------------------
     Time_Info("Gather collect done >");
 
 
+    // the statistics objects own the gathered arrays from here on
     statistics s_aw(all_aw, all_n_aw, rank, processes, true, true);
     statistics s_ar(all_ar, all_n_ar, rank, processes, false, true);
     statistics s_sw(all_sw, all_n_sw, rank, processes, true);
     statistics s_sr(all_sr, all_n_sr, rank, processes, false);
+
+    // phase, byte and time info over all ranks
+    s_aw.Reduce_Phase_Info(d_aw->phase_data, rank, FLUSH_WORLD);
+    s_ar.Reduce_Phase_Info(d_ar->phase_data, rank, FLUSH_WORLD);
+    s_sw.Reduce_Phase_Info(d_sw->phase_data, rank, FLUSH_WORLD);
+    s_sr.Reduce_Phase_Info(d_sr->phase_data, rank, FLUSH_WORLD);
     Time_Info("statistics init done >");
 
 
+#if MEMORY_CAP > 0
+    // number of samples dropped over all ranks
+    long long dropped[8] = {d_aw->samples_act.Dropped(), d_aw->samples_req.Dropped(), d_ar->samples_act.Dropped(), d_ar->samples_req.Dropped(),
+                            d_sw->samples_act.Dropped(), d_sw->samples_req.Dropped(), d_sr->samples_act.Dropped(), d_sr->samples_req.Dropped()};
+    long long all_dropped[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    MPI_Reduce(dropped, all_dropped, 8, MPI_LONG_LONG, MPI_SUM, 0, FLUSH_WORLD);
+    s_aw.dropped_act = all_dropped[0];
+    s_aw.dropped_req = all_dropped[1];
+    s_ar.dropped_act = all_dropped[2];
+    s_ar.dropped_req = all_dropped[3];
+    s_sw.dropped_act = all_dropped[4];
+    s_sw.dropped_req = all_dropped[5];
+    s_sr.dropped_act = all_dropped[6];
+    s_sr.dropped_req = all_dropped[7];
+    long long total_dropped = 0;
+    for (int i = 0; i < 8; i++)
+        total_dropped += all_dropped[i];
+    if (rank == 0 && total_dropped > 0)
+        printf("%sWarning: memory cap of %i bytes per rank reached. %lli samples of individual I/O operations were dropped%s\n", RED, MEMORY_CAP, total_dropped, BLACK);
+#endif
+
+    // distributions of the individual I/O operations over all ranks
+    if (cfg.sketch)
+    {
+        const IOsketch *sketch_in[12] = {&d_aw->sketch_b, &d_aw->sketch_t, &d_aw->sketch_l, &d_ar->sketch_b, &d_ar->sketch_t, &d_ar->sketch_l,
+                                         &d_sw->sketch_b, &d_sw->sketch_t, &d_sw->sketch_l, &d_sr->sketch_b, &d_sr->sketch_t, &d_sr->sketch_l};
+        IOsketch *sketch_out[12] = {&s_aw.sketch_b, &s_aw.sketch_t, &s_aw.sketch_l, &s_ar.sketch_b, &s_ar.sketch_t, &s_ar.sketch_l,
+                                    &s_sw.sketch_b, &s_sw.sketch_t, &s_sw.sketch_l, &s_sr.sketch_b, &s_sr.sketch_t, &s_sr.sketch_l};
+        IOsketch::Reduce(sketch_in, sketch_out, 12, FLUSH_WORLD);
+    }
+
+    // request size and latency histograms over all ranks
+    if (cfg.histogram)
+    {
+        const IOhistogram *hist_in[4] = {&d_aw->hist, &d_ar->hist, &d_sw->hist, &d_sr->hist};
+        IOhistogram *hist_out[4] = {&s_aw.hist, &s_ar.hist, &s_sw.hist, &s_sr.hist};
+        IOhistogram::Reduce(hist_in, hist_out, 4, FLUSH_WORLD);
+    }
+
 	// Gather metrics at thread level (b_ind,t_ind,..)
-    #if ALL_SAMPLES > 4
-    s_aw.Gather_Ind_Bandwidth(rank, processes, p_aw->bandwidth_act, p_aw->bandwidth_req, p_aw->t_act_s, p_aw->t_act_e, p_aw->t_req_s, p_aw->t_req_e, IO_WORLD);    
-    s_ar.Gather_Ind_Bandwidth(rank, processes, p_ar->bandwidth_act, p_ar->bandwidth_req, p_ar->t_act_s, p_ar->t_act_e, p_ar->t_req_s, p_ar->t_req_e, IO_WORLD);    
-    s_sw.Gather_Ind_Bandwidth(rank, processes, p_sw->bandwidth_act, p_sw->bandwidth_req, p_sw->t_act_s, p_sw->t_act_e, p_sw->t_req_s, p_sw->t_req_e, IO_WORLD);    
-    s_sr.Gather_Ind_Bandwidth(rank, processes, p_sr->bandwidth_act, p_sr->bandwidth_req, p_sr->t_act_s, p_sr->t_act_e, p_sr->t_req_s, p_sr->t_req_e, IO_WORLD);
-    #endif
+    if (cfg.all_samples > 4 && !cfg.parallel_output)
+    {
+        s_aw.Gather_Ind_Bandwidth(rank, processes, d_aw->samples_act, d_aw->samples_req, FLUSH_WORLD);    
+        s_ar.Gather_Ind_Bandwidth(rank, processes, d_ar->samples_act, d_ar->samples_req, FLUSH_WORLD);    
+        s_sw.Gather_Ind_Bandwidth(rank, processes, d_sw->samples_act, d_sw->samples_req, FLUSH_WORLD);    
+        s_sr.Gather_Ind_Bandwidth(rank, processes, d_sr->samples_act, d_sr->samples_req, FLUSH_WORLD);
+    }
     Time_Info("Rank_Bandwidth calculation done >");
 
     
+    // the incremental online output only needs the phases and samples of the interval and the running metrics
+    bool delta = cfg.delta_output && interval.online;
+
     // calculate statistics
-    if (rank == 0)
+    if (rank == 0 && !delta)
     {
 #if IOTRACE_VERBOSE >= 1
         printf("%s > rank %i > generating I/O summary %s> calculating statistics \n %s", caller, rank, BLUE, BLACK);
 #endif
 
-#if DO_CALC > 0 // Calculate overlapping bandwidth + rank and application metrics
+#if DO_CALC > 0 // Calculate overlapping bandwidth + application metrics
         s_aw.Compute();
         s_ar.Compute();
         s_sw.Compute();
         s_sr.Compute();
-#else //compute only rank statistics
-    if (finalize && !online_file_generation){
-        s_aw.Compute_Rank_Metrics();
-        s_ar.Compute_Rank_Metrics();
-        s_sw.Compute_Rank_Metrics();
-        s_sr.Compute_Rank_Metrics();
-        }
 #endif
     }
+
+    // rank metrics are computed by all ranks
+#if DO_CALC > 0
+    bool rank_metrics = true;
+#else
+    bool rank_metrics = interval.finalize && !interval.online;
+#endif
+    if (rank_metrics && !delta)
+    {
+        s_aw.Compute_Rank_Metrics(d_aw->phase_data, rank, FLUSH_WORLD);
+        s_ar.Compute_Rank_Metrics(d_ar->phase_data, rank, FLUSH_WORLD);
+        s_sw.Compute_Rank_Metrics(d_sw->phase_data, rank, FLUSH_WORLD);
+        s_sr.Compute_Rank_Metrics(d_sr->phase_data, rank, FLUSH_WORLD);
+    }
+    if (delta)
+    {
+        // same order as io_running_names
+        const std::vector<collect> *local[IO_RUNNING_MODES] = {&d_sr->phase_data, &d_ar->phase_data, &d_ar->phase_data, &d_aw->phase_data, &d_aw->phase_data, &d_sw->phase_data};
+        const statistics *s[IO_RUNNING_MODES] = {&s_sr, &s_ar, &s_ar, &s_aw, &s_aw, &s_sw};
+        running.Update(local, s, rank, FLUSH_WORLD);
+    }
+
+    // remove unneeded elements
+    if (interval.finalize)
+    {
+        d_aw->phase_data.clear();
+        d_ar->phase_data.clear();
+        d_sw->phase_data.clear();
+        d_sr->phase_data.clear();
+    }
     Time_Info("Statistics compute done >");
 
     
-    // printf("%s > rank %i > generating I/O summary end  %f \n", caller, rank,MPI_Wtime() - t_0);
+    // printf("%s > rank %i > generating I/O summary end  %f \n", caller, rank,clock.Now() - t_0);
 
     //? Overhead calculation
     //?-------------------------
     //std::cout<< "Rank "<<rank <<  " stucked before overhead\n";
-    double *time = Overhead_Calculation();
+    double *time = Overhead_Calculation(interval);
     //std::cout<< "Rank "<<rank << " stucked after overhead\n";
 
+    // max clock offset and error over all ranks
+    double clock_rank[2] = {fabs(interval.clock_offset), interval.clock_error};
+    double clock_all[2] = {0, 0};
+    MPI_Reduce(clock_rank, clock_all, 2, MPI_DOUBLE, MPI_MAX, 0, FLUSH_WORLD);
+
     //? Print
     //?-------------------------
     if (rank == 0)
     {
 
-        // if (finalize){
+        // if (interval.finalize){
 #if IOTRACE_VERBOSE >= 1
         printf("%s > rank %i > generating I/O summary %s> printing file %s\n", caller, rank, BLUE, BLACK);
 #endif
 
-        double time_rank0[3] = {delta_t_app, delta_t_io_overhead, (MPI_Wtime() - t_summary) - delta_t_app};
+        double time_rank0[3] = {interval.t_app, interval.t_overhead, interval.Post(clock.Now())};
 
-        iotime io_time(time, time_rank0, s_sr, s_ar, s_sw, s_aw);
-        if (finalize){
+        iotime io_time(time, time_rank0, s_sr, s_ar, s_sw, s_aw, clock_all);
+        if (interval.finalize){
             ioprint::Summary(processes, s_sr, s_ar, s_sw, s_aw, io_time);
-            if(online_file_generation == false)
-                #if FILE_FORMAT >= 1
-					ioprint::Binary(processes, s_sr, s_ar, s_sw, s_aw, io_time); 
-				#else
+            if(interval.online == false)
+            {
+                if (cfg.file_format >= 1)
+					ioprint::Binary(processes, s_sr, s_ar, s_sw, s_aw, io_time, publisher); 
+				else
 					ioprint::Json(processes, s_sr, s_ar, s_sw, s_aw, io_time); 
-				#endif
+            }
         }
-        else
-            online_file_generation = true;
 
-        if(online_file_generation == true){
-			#if FILE_FORMAT >= 1
-				ioprint::Binary(processes, s_sr, s_ar, s_sw, s_aw, io_time); 
-			#else
+        if(interval.online == true){
+			if (cfg.file_format >= 1)
+				ioprint::Binary(processes, s_sr, s_ar, s_sw, s_aw, io_time, publisher); 
+			else if (delta)
+				ioprint::Delta(processes, s_sr, s_ar, s_sw, s_aw, io_time, running);
+			else
 				ioprint::Jsonl(processes, s_sr, s_ar, s_sw, s_aw, io_time); 
-			#endif
-			
 		}
 
+#if FILE_FORMAT > 2
+        if (interval.finalize && publisher)
+        {
+            printf("%s > rank %i > ZMQ: %lli summaries sent, %lli dropped (%s)\n", caller, rank, publisher->Sent(), publisher->Dropped(), publisher->Endpoint().c_str());
+            delete publisher;
+            publisher = NULL;
+        }
+#endif
         Time_Info("Printing done >");
-        s_aw.Clean();
-        s_ar.Clean();
-        s_sw.Clean();
-        s_sr.Clean();
-        free(all_n_aw);
-        free(all_n_ar);
-        free(all_n_sw);
-        free(all_n_sr);
         free(all_n);
-        free(all_aw);
-        free(all_ar);
-        free(all_sw);
-        free(all_sr);
         free(time);
     }
-    if (!finalize){
-        t_summary =  MPI_Wtime() - t_0;
-        delta_t_app = 0;
-        delta_t_io_overhead = 0;    
-
-        p_sw->Clear_IO();
-        p_sr->Clear_IO();
-        p_aw->Clear_IO();
-        p_ar->Clear_IO();
-
-        #if defined BW_LIMIT || defined CUSTOM_MPI
-        bw_limit.Reset();
-        #endif
 
-        }
-    // printf("%s > rank %i > generating I/O summary end 2 %f \n", caller, rank,MPI_Wtime() - t_0);
+    // every rank writes its individual operations into a shared file (rank 0 adds the index)
+    if (cfg.all_samples > 4 && cfg.parallel_output)
+    {
+        static int chunk = 0;
+        IOcolumns samples;
+        ioprint::Format_Samples(samples, d_sr->samples_act, "read_sync");
+        ioprint::Format_Samples(samples, d_ar->samples_act, "read_async_t");
+        ioprint::Format_Samples(samples, d_ar->samples_req, "read_async_b");
+        ioprint::Format_Samples(samples, d_aw->samples_act, "write_async_t");
+        ioprint::Format_Samples(samples, d_aw->samples_req, "write_async_b");
+        ioprint::Format_Samples(samples, d_sw->samples_act, "write_sync");
+        samples.Write_All(std::to_string(processes) + ".samples_chunk_" + std::to_string(chunk++), FLUSH_WORLD);
+        Time_Info("Parallel output done >");
+    }
+    // printf("%s > rank %i > generating I/O summary end 2 %f \n", caller, rank,clock.Now() - t_0);
 
 }
 
@@ -294,26 +536,22 @@ void IOtrace::Summary(void)
 void IOtrace::Write_Async_Start(int count, MPI_Datatype datatype, MPI_Request *request, MPI_Offset offset)
 {
     // get write timestamp
-    async_write_time.push_back(Overhead_Start(MPI_Wtime() - t_0));
+    double t = Overhead_Start(Stamp());
 
     // determnine write size
+    int data_size_write;
     MPI_Type_size(datatype, &data_size_write);
-    async_write_size.push_back(count * data_size_write);
-
-    // phase start if first request. Add phase data and offset
-    p_aw->Phase_Start(async_write_requests.empty(), async_write_time.back(), async_write_size.back(), offset);
+    long long size = (long long)count * data_size_write;
 
-    // save request flag and set request counter (required and actual to one)
-	async_write_requests.push_back(AsyncRequest(request));
-    async_write_queue_req.push_back(1);
-    async_write_queue_act.push_back(1);
+    // phase start if first request, save request and set request counter (see Apply)
+    Record(io_record{t, t, size, offset, AsyncRequest::Ptr_Key(request), AsyncRequest::Handle_Key(*request), WRITE_ASYNC_START});
 
 #if IOTRACE_VERBOSE >= 1
     static long int counter = 1;
-    printf("%s > rank %i > #%li will asnyc write %i x %i = %lli bytes \n", caller, rank, counter++, count, data_size_write, async_write_size.back());
+    printf("%s > rank %i > #%li will asnyc write %i x %i = %lli bytes \n", caller, rank, counter++, count, data_size_write, size);
 #endif
 #if IOTRACE_VERBOSE >= 2
-    printf("%s > rank %i %s>> started asnyc write @ %f s %s\n", caller, rank, GREEN, async_write_time.back(), BLACK);
+    printf("%s > rank %i %s>> started asnyc write @ %f s %s\n", caller, rank, GREEN, t, BLACK);
 #endif
 #if IOTRACE_VERBOSE >= 3
     printf("%s > rank %i %s>>> has offset %lli %s\n", caller, rank, YELLOW, offset, BLACK);
@@ -332,29 +570,12 @@ void IOtrace::Write_Async_Start(int count, MPI_Datatype datatype, MPI_Request *r
  */
 void IOtrace::Write_Async_End(MPI_Request *request, int write_status)
 {
-    Overhead_Start(MPI_Wtime() - t_0);
+    // only a completed request is recorded and holds back the drain (see Stamp)
+    double t = Overhead_Start(write_status == 1 ? Stamp() : clock.Now() - t_0);
 
     // actual write ended signilized by flag of MPI_Test or at the end of MPI_Wait. This flag will always be true if the I/O operation ended
     if (write_status == 1)
-    {
-        //  first time the status of the actual write is quarried. Solves the problem of several MPI_Test
-        if (Check_Request_Write(request, &t_async_write_start, &size_async_write, 2))
-        {
-            // add values to traced data and add phase values if condition is true:
-            // Act_Done: if empty request reutrns 1 (act finished after wait) and if all request are done (= 0, act finished before wait) returns true
-            // p_aw->Phase_End_Act(size_async_write, t_async_write_start, MPI_Wtime() - t_0,(async_write_requests.empty() || (async_write_queue_act.size() == 1 && async_write_queue_act.back() == 0)));
-            p_aw->Phase_End_Act(size_async_write, t_async_write_start, MPI_Wtime() - t_0, Act_Done(0));
-
-#if IOTRACE_VERBOSE >= 2
-            static long int counter = 1;
-            printf("%s > rank %i %s>> Async ended (act ended). Active async write requests %li/%li %s\n", caller, rank, GREEN, async_write_requests.size(),counter++, BLACK);
-            // iohf::Disp(async_write_queue_act, async_write_queue_act.size(), std::string(caller) + " > rank " + std::to_string(rank) + " >> async_write_queue_act ", 1);
-#endif
-#if IOTRACE_VERBOSE >= 3
-            printf("%s > rank %i %s>> write async requests ended at %f %s\n", caller, rank, RED, p_aw->phase_data.back().t_end_act, BLACK);
-#endif
-        }
-    }
+        Record(io_record{t, t, 0, 0, AsyncRequest::Ptr_Key(request), request ? AsyncRequest::Handle_Key(*request) : 0, WRITE_ASYNC_END});
 
 #if IOTRACE_VERBOSE >= 4
     if (write_status == 0)
@@ -374,17 +595,8 @@ void IOtrace::Write_Async_End(MPI_Request *request, int write_status)
  */
 void IOtrace::Write_Async_Required(MPI_Request *request)
 {
-    Overhead_Start(MPI_Wtime() - t_0);
-
-    if (Check_Request_Write(request, &t_async_write_start, &size_async_write, 1))
-    {
-        p_aw->Phase_End_Req(size_async_write, t_async_write_start, MPI_Wtime() - t_0);
-
-#if IOTRACE_VERBOSE >= 2
-	static long int counter = 1;
-	printf("%s > rank %i %s>> Wait reached (Req ended). Active async write requests %li/%li %s\n", caller, rank, GREEN, async_write_requests.size(),counter++, BLACK);
-#endif
-    }
+    double t = Overhead_Start(Stamp());
+    Record(io_record{t, t, 0, 0, AsyncRequest::Ptr_Key(request), request ? AsyncRequest::Handle_Key(*request) : 0, WRITE_ASYNC_REQUIRED});
     Overhead_End();
 }
 
@@ -402,26 +614,22 @@ void IOtrace::Write_Async_Required(MPI_Request *request)
 void IOtrace::Read_Async_Start(int count, MPI_Datatype datatype, MPI_Request *request, MPI_Offset offset)
 {
     // get read timestamp
-    async_read_time.push_back(Overhead_Start(MPI_Wtime() - t_0));
+    double t = Overhead_Start(Stamp());
 
     // determnine read size
+    int data_size_read;
     MPI_Type_size(datatype, &data_size_read);
-    async_read_size.push_back(count * data_size_read);
-
-    // phase start if first request. Add phase data and offset
-    p_ar->Phase_Start(async_read_requests.empty(), async_read_time.back(), async_read_size.back(), offset);
+    long long size = (long long)count * data_size_read;
 
-    // save request flag and set request counter (required and actual to one)
-    async_read_requests.push_back(AsyncRequest(request));
-	async_read_queue_req.push_back(1);
-    async_read_queue_act.push_back(1);
+    // phase start if first request, save request and set request counter (see Apply)
+    Record(io_record{t, t, size, offset, AsyncRequest::Ptr_Key(request), AsyncRequest::Handle_Key(*request), READ_ASYNC_START});
 
 #if IOTRACE_VERBOSE >= 1
     static long int counter = 1;
-    printf("%s > rank %i > #%li will asnyc read %i x %i = %lli bytes \n", caller, rank, counter++, count, data_size_read, async_read_size.back());
+    printf("%s > rank %i > #%li will asnyc read %i x %i = %lli bytes \n", caller, rank, counter++, count, data_size_read, size);
 #endif
 #if IOTRACE_VERBOSE >= 2
-    printf("%s > rank %i %s>> started asnyc read @ %f s %s\n", caller, rank, GREEN, async_read_time.back(), BLACK);
+    printf("%s > rank %i %s>> started asnyc read @ %f s %s\n", caller, rank, GREEN, t, BLACK);
 #endif
 #if IOTRACE_VERBOSE >= 3
     printf("%s > rank %i %s>>> has offset %lli %s\n", caller, rank, YELLOW, offset, BLACK);
@@ -440,28 +648,11 @@ void IOtrace::Read_Async_Start(int count, MPI_Datatype datatype, MPI_Request *re
  */
 void IOtrace::Read_Async_End(MPI_Request *request, int read_status)
 {
+    // only a completed request is recorded and holds back the drain (see Stamp)
+    double t = Overhead_Start(read_status == 1 ? Stamp() : clock.Now() - t_0);
 
-    Overhead_Start(MPI_Wtime() - t_0);
-
-    if (read_status == 1)
-    { // read ended
-        if (Check_Request_Read(request, &t_async_read_start, &size_async_read, 2))
-        {
-            // add values to traced data and add phase values if condition is true
-            // p_ar->Phase_End_Act(size_async_read, t_async_read_start, MPI_Wtime() - t_0, (async_read_requests.empty() || (async_read_queue_act.size() == 1 && async_read_queue_act.back() == 0)));
-            // Act_Done: if empty request reutrns 1 (act finished after wait) and if all request are done (= 0, act finished before wait) returns true
-            p_ar->Phase_End_Act(size_async_read, t_async_read_start, MPI_Wtime() - t_0, Act_Done(1));
-            // std::cout << "Act_Done return" << Act_Done(1) << std::endl;
-
-#if IOTRACE_VERBOSE >= 2
-            printf("%s > rank %i %s>> active read async requests %li %s\n", caller, rank, GREEN, async_read_requests.size(), BLACK);
-            iohf::Disp(async_read_queue_act, async_read_queue_act.size(), std::string(caller) + " > rank " + std::to_string(rank) + " >> async_read_queue_act ", 1);
-#endif
-#if IOTRACE_VERBOSE >= 3
-            printf("%s > rank %i %s>> read async requests ended at %f %s\n", caller, rank, RED, p_ar->phase_data.back().t_end_act, BLACK);
-#endif
-        }
-    }
+    if (read_status == 1) // read ended
+        Record(io_record{t, t, 0, 0, AsyncRequest::Ptr_Key(request), request ? AsyncRequest::Handle_Key(*request) : 0, READ_ASYNC_END});
 
 #if IOTRACE_VERBOSE >= 4
     if (read_status == 0)
@@ -481,17 +672,8 @@ void IOtrace::Read_Async_End(MPI_Request *request, int read_status)
  */
 void IOtrace::Read_Async_Required(MPI_Request *request)
 {
-    Overhead_Start(MPI_Wtime() - t_0);
-
-    if (Check_Request_Read(request, &t_async_read_start, &size_async_read, 1))
-    {
-        p_ar->Phase_End_Req(size_async_read, t_async_read_start, MPI_Wtime() - t_0);
-
-#if IOTRACE_VERBOSE >= 2
-	static long int counter = 1;
-	printf("%s > rank %i %s>> Wait reached. Active async read requests %li/%li %s\n", caller, rank, GREEN, async_read_requests.size(),counter++, BLACK);
-#endif
-    }
+    double t = Overhead_Start(Stamp());
+    Record(io_record{t, t, 0, 0, AsyncRequest::Ptr_Key(request), request ? AsyncRequest::Handle_Key(*request) : 0, READ_ASYNC_REQUIRED});
     Overhead_End();
 }
 
@@ -500,32 +682,30 @@ void IOtrace::Read_Async_Required(MPI_Request *request)
 //*                               1. Write_Sync_Start
 //************************************************************************************
 /**
- * @brief starts tracing the sync write call. Takes timestamp of function call
+ * @brief starts tracing the sync write call. Takes timestamp of function call.
+ * The call is kept in the thread state (see IOthread) and recorded at \e Write_Sync_End
  * @param count   : counting variable from write operations. number of variables of type datarype to write
  * @param datatype: data type of the variables to write
  * @param offset   [in,optional] offset of the I/O operation
  */
 void IOtrace::Write_Sync_Start(int count, MPI_Datatype datatype, MPI_Offset offset)
 {
+    IOthread *local = Local();
 
     // get write timestamp
-    t_sync_write_start = Overhead_Start(MPI_Wtime() - t_0);
+    local->t_sync_write_start = Overhead_Start(Stamp());
 
     // determnine write size
+    int data_size_write;
     MPI_Type_size(datatype, &data_size_write);
-    size_sync_write = count * data_size_write; // in B
-
-#if SYNC_MODE == 1
-    p_sw->Phase_Start(p_sw->flag && !(p_sw->phase), t_sync_write_start, size_sync_write, offset);
-#else
-    p_sw->Phase_Start(true, t_sync_write_start, size_sync_write, offset);
-#endif
+    local->size_sync_write = (long long)count * data_size_write; // in B
+    local->offset_sync_write = offset;
 
 #if IOTRACE_VERBOSE >= 1
     printf("%s > rank %i > will write %i x %i bytes \n", caller, rank, count, data_size_write);
 #endif
 #if IOTRACE_VERBOSE >= 2
-    printf("%s > rank %i %s>> started sync write @ %f s %s\n", caller, rank, GREEN, t_sync_write_start, BLACK);
+    printf("%s > rank %i %s>> started sync write @ %f s %s\n", caller, rank, GREEN, local->t_sync_write_start, BLACK);
 #endif
 #if IOTRACE_VERBOSE >= 3
     printf("%s > rank %i %s>>> has offset %lli %s\n", caller, rank, YELLOW, offset, BLACK);
@@ -541,14 +721,13 @@ void IOtrace::Write_Sync_Start(int count, MPI_Datatype datatype, MPI_Offset offs
  */
 void IOtrace::Write_Sync_End(void)
 {
-    t_sync_write_end = Overhead_Start(MPI_Wtime() - t_0);
+    IOthread *local = Local();
+    double t = Overhead_Start(Stamp());
 
-    p_sw->Add_Io(0, size_sync_write, t_sync_write_start, t_sync_write_end);
-#if SYNC_MODE == 0
-    p_sw->Phase_End_Sync(t_sync_write_end);
+    Record(io_record{local->t_sync_write_start, t, local->size_sync_write, local->offset_sync_write, 0, 0, WRITE_SYNC});
 #if IOTRACE_VERBOSE >= 2
-    printf("%s > rank %i %s>> ended   sync write @ %f s %s\n", caller, rank, GREEN, t_sync_write_end, BLACK);
-#endif
+    if (ioconfig::Get().sync_mode == 0)
+        printf("%s > rank %i %s>> ended   sync write @ %f s %s\n", caller, rank, GREEN, t, BLACK);
 #endif
 
     Overhead_End();
@@ -559,31 +738,30 @@ void IOtrace::Write_Sync_End(void)
 //*                               1. Read_Sync_Start
 //************************************************************************************
 /**
- * @brief starts tracing the sync read call. Takes timestamp of function call
+ * @brief starts tracing the sync read call. Takes timestamp of function call.
+ * The call is kept in the thread state (see IOthread) and recorded at \e Read_Sync_End
  * @param count    [in] counting variable from read operations. number of variables of type datarype to read
  * @param datatype [in] data type of the variables to read
  * @param offset   [in,optional] offset of the I/O operation
  */
 void IOtrace::Read_Sync_Start(int count, MPI_Datatype datatype, MPI_Offset offset)
 {
+    IOthread *local = Local();
+
     // get read timestamp
-    t_sync_read_start = Overhead_Start(MPI_Wtime() - t_0);
+    local->t_sync_read_start = Overhead_Start(Stamp());
 
     // determnine read size
+    int data_size_read;
     MPI_Type_size(datatype, &data_size_read);
-    size_sync_read = count * data_size_read; // in B
-
-#if SYNC_MODE == 1
-    p_sr->Phase_Start(p_sr->flag && !(p_sr->phase), t_sync_read_start, size_sync_read, offset);
-#else
-    p_sr->Phase_Start(true, t_sync_read_start, size_sync_read, offset);
-#endif
+    local->size_sync_read = (long long)count * data_size_read; // in B
+    local->offset_sync_read = offset;
 
 #if IOTRACE_VERBOSE >= 1
     printf("%s > rank %i > will read %i x %i bytes \n", caller, rank, count, data_size_read);
 #endif
 #if IOTRACE_VERBOSE >= 2
-    printf("%s > rank %i %s>> started sync read @ %.2f s %s\n", caller, rank, GREEN, t_sync_read_start, BLACK);
+    printf("%s > rank %i %s>> started sync read @ %.2f s %s\n", caller, rank, GREEN, local->t_sync_read_start, BLACK);
 #endif
 #if IOTRACE_VERBOSE >= 3
     printf("%s > rank %i %s>>> has offset %lli %s\n", caller, rank, YELLOW, offset, BLACK);
@@ -600,18 +778,15 @@ void IOtrace::Read_Sync_Start(int count, MPI_Datatype datatype, MPI_Offset offse
  */
 void IOtrace::Read_Sync_End(void)
 {
-    t_sync_read_end = Overhead_Start(MPI_Wtime() - t_0);
-
-    p_sr->Add_Io(0, size_sync_read, t_sync_read_start, t_sync_read_end);
+    IOthread *local = Local();
+    double t = Overhead_Start(Stamp());
 
-#if SYNC_MODE == 0
-    p_sr->Phase_End_Sync(t_sync_read_end);
+    Record(io_record{local->t_sync_read_start, t, local->size_sync_read, local->offset_sync_read, 0, 0, READ_SYNC});
 #if IOTRACE_VERBOSE >= 2
-    printf("%s > rank %i %s>> ended   sync read @ %f s %s\n", caller, rank, GREEN, t_sync_read_end, BLACK);
-#endif
+    if (ioconfig::Get().sync_mode == 0)
+        printf("%s > rank %i %s>> ended   sync read @ %f s %s\n", caller, rank, GREEN, t, BLACK);
 #endif
 
-
     Overhead_End();
 }
 
@@ -621,38 +796,284 @@ void IOtrace::Read_Sync_End(void)
 //************************************************************************************
 void IOtrace::Open(void)
 {
-    open = 1;
+    double t = Stamp();
+    Record(io_record{t, t, 0, 0, 0, 0, FILE_OPEN});
+}
+
+//************************************************************************************
+//*                               2. Close
+//************************************************************************************
+void IOtrace::Close(void)
+{
+    double t = Stamp();
+    Record(io_record{t, t, 0, 0, 0, 0, FILE_CLOSE});
+}
+
+//! ------------------------------ Recording & Replay --------------------------------
+//************************************************************************************
+//*                               1. Stamp
+//************************************************************************************
+/**
+ * @brief takes the time stamp of a traced call that is recorded. With MPI_THREAD_MULTIPLE, the call holds back
+ * the drain from its time stamp until its record is pushed (low-watermark, see IOthread::Enter). A sync call holds
+ * it from \e *_Sync_Start, as its record carries the start time but is only pushed at \e *_Sync_End
+ * @return double time since t_0
+ */
+double IOtrace::Stamp(void)
+{
+    if (!thread_multiple)
+        return clock.Now() - t_0;
+
+    IOthread *local = Local();
+    bool enter = local->Enter();
+    double t = clock.Now() - t_0;
+    if (enter)
+        local->Stamp(t);
+    return t;
+}
+
+//************************************************************************************
+//*                               2. Record
+//************************************************************************************
+/**
+ * @brief passes a traced call on. With MPI_THREAD_MULTIPLE the record is appended to the buffer of the
+ * calling thread. Every THREAD_DRAIN records, the thread replays the buffers of all threads (see \e Drain), so
+ * the buffers stay bounded and the live data (telemetry, bandwidth limit) stays current without a summary.
+ * The replay is skipped if another thread is already replaying or \e Summary uses the data.
+ * Otherwise the record is applied immediately.
+ * @param r [in] record of the traced call
+ */
+void IOtrace::Record(const io_record &r)
+{
+    if (!thread_multiple)
+    {
+        Apply(r);
+        return;
+    }
+
+    IOthread *local = Local();
+    local->Push(r);
+    if (++local->pending >= THREAD_DRAIN)
+    {
+        local->pending = 0;
+        if (!draining.exchange(true, std::memory_order_acquire))
+        {
+            Drain();
+            draining.store(false, std::memory_order_release);
+        }
+    }
+}
+
+//************************************************************************************
+//*                               3. Apply
+//************************************************************************************
+/**
+ * @brief applies a record to the traced data (phases, requests queues and file status).
+ * Only called by a single thread at a time (the traced thread or the thread calling \e Summary)
+ * @param r [in] record of the traced call
+ */
+void IOtrace::Apply(const io_record &r)
+{
+    switch (r.kind)
+    {
+    case WRITE_ASYNC_START:
+        // phase start if first request. Add phase data and offset
+        p_aw->Phase_Start(async_write_queue.Empty(), r.t, r.size, r.offset);
+
+        // save request flag and set request counter (required and actual to one)
+        async_write_queue.Push(r.ptr_key, r.handle_key, r.t, r.size);
+        async_write_act_open++;
+        break;
+
+    case WRITE_ASYNC_REQUIRED:
+        if (Check_Request_Write(r.ptr_key, r.handle_key, &t_async_write_start, &size_async_write, 1))
+        {
+            p_aw->Phase_End_Req(size_async_write, t_async_write_start, r.t);
+#if IOTRACE_VERBOSE >= 2
+            printf("%s > rank %i %s>> Wait reached (Req ended). Active async write requests %i %s\n", caller, rank, GREEN, async_write_queue.Size(), BLACK);
+#endif
+        }
+        break;
+
+    case WRITE_ASYNC_END:
+        //  first time the status of the actual write is quarried. Solves the problem of several MPI_Test
+        if (Check_Request_Write(r.ptr_key, r.handle_key, &t_async_write_start, &size_async_write, 2))
+        {
+            // add values to traced data and add phase values if condition is true:
+            // Act_Done: if empty request reutrns 1 (act finished after wait) and if all request are done (= 0, act finished before wait) returns true
+            p_aw->Phase_End_Act(size_async_write, t_async_write_start, r.t, Act_Done(0));
+#if IOTRACE_VERBOSE >= 2
+            printf("%s > rank %i %s>> Async ended (act ended). Active async write requests %i %s\n", caller, rank, GREEN, async_write_queue.Size(), BLACK);
+#endif
+#if IOTRACE_VERBOSE >= 3
+            printf("%s > rank %i %s>> write async requests ended at %f %s\n", caller, rank, RED, p_aw->phase_data.back().t_end_act, BLACK);
+#endif
+        }
+        break;
+
+    case WRITE_SYNC:
+        // phase per operation or per file (SYNC_MODE, see IOdata::Record_Sync)
+        t_sync_write_end = r.t_end;
+        p_sw->Add_Sync(r.size, r.t, r.t_end, r.offset);
+        break;
+
+    case READ_ASYNC_START:
+        // phase start if first request. Add phase data and offset
+        p_ar->Phase_Start(async_read_queue.Empty(), r.t, r.size, r.offset);
+
+        // save request flag and set request counter (required and actual to one)
+        async_read_queue.Push(r.ptr_key, r.handle_key, r.t, r.size);
+        async_read_act_open++;
+        break;
+
+    case READ_ASYNC_REQUIRED:
+        if (Check_Request_Read(r.ptr_key, r.handle_key, &t_async_read_start, &size_async_read, 1))
+        {
+            p_ar->Phase_End_Req(size_async_read, t_async_read_start, r.t);
+#if IOTRACE_VERBOSE >= 2
+            printf("%s > rank %i %s>> Wait reached. Active async read requests %i %s\n", caller, rank, GREEN, async_read_queue.Size(), BLACK);
+#endif
+        }
+        break;
 
-#if SYNC_MODE == 1
-    p_sw->flag = true;
-    p_sr->flag = true;
+    case READ_ASYNC_END:
+        if (Check_Request_Read(r.ptr_key, r.handle_key, &t_async_read_start, &size_async_read, 2))
+        {
+            // add values to traced data and add phase values if condition is true
+            // Act_Done: if empty request reutrns 1 (act finished after wait) and if all request are done (= 0, act finished before wait) returns true
+            p_ar->Phase_End_Act(size_async_read, t_async_read_start, r.t, Act_Done(1));
+#if IOTRACE_VERBOSE >= 2
+            printf("%s > rank %i %s>> active read async requests %i %s\n", caller, rank, GREEN, async_read_queue.Size(), BLACK);
 #endif
+#if IOTRACE_VERBOSE >= 3
+            printf("%s > rank %i %s>> read async requests ended at %f %s\n", caller, rank, RED, p_ar->phase_data.back().t_end_act, BLACK);
+#endif
+        }
+        break;
+
+    case READ_SYNC:
+        // phase per operation or per file (SYNC_MODE, see IOdata::Record_Sync)
+        t_sync_read_end = r.t_end;
+        p_sr->Add_Sync(r.size, r.t, r.t_end, r.offset);
+        break;
 
+    case FILE_OPEN:
+        open = 1;
 #if IOTRACE_VERBOSE >= 2
-    printf("%s > rank %i %s>> opened the file %s\n", caller, rank, GREEN, BLACK);
+        printf("%s > rank %i %s>> opened the file %s\n", caller, rank, GREEN, BLACK);
 #endif
+        break;
 
+    case FILE_CLOSE:
+        if (open == 1)
+        {
+            open = 0;
+            // only a phase per file (SYNC_MODE 1) is still open
+            p_sw->Phase_End_Sync(t_sync_write_end);
+            p_sr->Phase_End_Sync(t_sync_read_end);
+#if IOTRACE_VERBOSE >= 2
+            printf("%s > rank %i %s>> closed the file %s\n", caller, rank, GREEN, BLACK);
+#endif
+        }
+        break;
+    }
 }
 
 //************************************************************************************
-//*                               2. Close
+//*                               4. Drain
 //************************************************************************************
-void IOtrace::Close(void)
+/**
+ * @brief merges the buffers of all threads by time and applies the records. The merge stops at the lowest
+ * low-watermark of the threads (see \e Stamp), as a call in flight may still push a record with an earlier time
+ * stamp than the records of the other threads, and at the start of the drain. The remaining records are left for
+ * the next drain. The overhead of the threads is collected as well.
+ * Only called while \e draining is held (see \e Record and \e Summary)
+ */
+void IOtrace::Drain(void)
 {
+    delta_t_io_overhead += single_thread.Take_Overhead();
+    if (!thread_multiple)
+        return;
+
+    // the cut is taken before the low-watermarks are read: a call that publishes its low-watermark later
+    // takes its time stamp after the cut
+    double t_cut = clock.Now() - t_0;
+    std::vector<IOthread *> list;
+    for (IOthread *th = threads.load(std::memory_order_acquire); th != NULL; th = th->next)
+    {
+        list.push_back(th);
+        t_cut = std::min(t_cut, th->Low());
+        delta_t_io_overhead += th->Take_Overhead();
+    }
 
-    if (open == 1)
+    // k-way merge: the records of each thread are already ordered by time
+    long long n_records = 0;
+    while (true)
     {
-        open = 0;
-#if SYNC_MODE == 1
-        p_sw->Phase_End_Sync(t_sync_write_end);
-        p_sr->Phase_End_Sync(t_sync_read_end);
-#endif
-#if IOTRACE_VERBOSE >= 2
-        printf("%s > rank %i %s>> closed the file %s\n", caller, rank, GREEN, BLACK);
+        IOthread *min_th = NULL;
+        const io_record *min_r = NULL;
+        for (unsigned int i = 0; i < list.size(); i++)
+        {
+            const io_record *r = list[i]->Peek();
+            if (r != NULL && r->t < t_cut && (min_r == NULL || r->t < min_r->t))
+            {
+                min_th = list[i];
+                min_r = r;
+            }
+        }
+        if (min_th == NULL)
+            break;
+
+        Apply(*min_r);
+        min_th->Pop();
+        n_records++;
+    }
+
+#if IOTRACE_VERBOSE >= 1
+    printf("%s > rank %i > replayed %lli records from %i threads \n", caller, rank, n_records, (int)list.size());
 #endif
+}
+
+//************************************************************************************
+//*                               5. Local
+//************************************************************************************
+/**
+ * @brief returns the buffer of the calling thread. With MPI_THREAD_MULTIPLE, a buffer is created at the
+ * first call of a thread and pushed lock-free onto \e threads. Otherwise, a single buffer is used.
+ */
+IOthread *IOtrace::Local(void)
+{
+    if (!thread_multiple)
+        return &single_thread;
 
+    static thread_local IOthread *local = NULL;
+    if (local == NULL)
+    {
+        local = new IOthread();
+        local->next = threads.load(std::memory_order_relaxed);
+        while (!threads.compare_exchange_weak(local->next, local, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+    return local;
+}
+
+//************************************************************************************
+//*                               6. Free_Threads
+//************************************************************************************
+/**
+ * @brief frees the buffers of all threads at MPI_Finalize, after the last drain. Later calls (not allowed by MPI)
+ * fall back to the single buffer
+ */
+void IOtrace::Free_Threads(void)
+{
+    thread_multiple = false;
+    IOthread *th = threads.exchange(NULL, std::memory_order_acq_rel);
+    while (th != NULL)
+    {
+        IOthread *next = th->next;
+        delete th;
+        th = next;
     }
-    
 }
 
 //! ------------------------------ Queue & Core functions ----------------------------
@@ -661,58 +1082,46 @@ void IOtrace::Close(void)
 //************************************************************************************
 /**
  * @brief handles async write requests.Checks if the requests (req and act) for the bandwidth and throughput ended.
- * bandwidth requests are saved in the vector \e async_write_queue_req
- * throughput requests are saved in the vector \e async_write_queue_act.
+ * The requests are stored in \e async_write_queue (see AsyncQueue), which finds them in O(1)
+ * over the request pointer or handle. Each entry has a counter for the required and the actual end.
  * The actual and the required I/O are allowed each to quary this status only once.
  * after that false is returned (solves problem with several MPI_Test/Wait)
- * if both I/O (req and actual) finished, the request is deleted.
- * @param request [in] pointer of the current reuqest to check
+ * if both I/O (req and actual) finished, the request is retired from the queue.
+ * @param ptr_key [in] pointer key of the current reuqest to check (see AsyncRequest)
+ * @param handle_key [in] handle key of the current reuqest to check (see AsyncRequest)
  * @param start_time [out] start time of the request
  * @param size [out] number of \e bytes transfered in
  * @param mode [in]  1 -> required |  2 -> actual
  * @return \e true for the first time the async I/O operation ended.
  */
-bool IOtrace::
-    Check_Request_Write(MPI_Request *request, double *start_time, long long *size, int mode)
+bool IOtrace::Check_Request_Write(uint64_t ptr_key, uint64_t handle_key, double *start_time, long long *size, int mode)
 {
-	if (!async_write_requests.empty())
-    {
-        for (unsigned int i = 0; i < async_write_requests.size(); i++)
+    async_entry *entry = async_write_queue.Find(ptr_key, handle_key);
+    if (entry == NULL)
+        return false;
+
+    if (mode == 1){
+        if (entry->queue_req == 0)
+            return false;
+        else
+            --entry->queue_req; // required queue
+    }
+    else if (mode == 2){
+        if (entry->queue_act == 0)
+            return false;
+        else
         {
-			// std ::cout << "check says: " <<(iohf::check_request(request, async_write_requests[i])) << std::endl;
-            //std ::cout << "Mode " << mode << " Open request: " << async_write_requests.size() << std::endl;
-            //if (async_write_requests[i].check_request(request) || (*request == MPI_REQUEST_NULL && async_write_requests.size() == 1))
-            if (async_write_requests[i].check_request(request))
-            {
-                if (mode == 1){
-                    if (async_write_queue_req[i] == 0)
-                        return false;
-                    else
-                        --async_write_queue_req[i]; // required queue
-                }
-                else if (mode == 2){
-                    if (async_write_queue_act[i] == 0)
-                        return false;
-                    else
-                        --async_write_queue_act[i]; // actual queue
-                }
-                *start_time = async_write_time[i];
-                *size = async_write_size[i];
-
-                if (async_write_queue_req[i] == 0 && async_write_queue_act[i] == 0) // finished request > delete from queue
-                {
-                    async_write_time.erase(async_write_time.begin() + i);
-                    async_write_size.erase(async_write_size.begin() + i);
-                    async_write_requests.erase(async_write_requests.begin() + i);
-                    async_write_queue_req.erase(async_write_queue_req.begin() + i);
-                    async_write_queue_act.erase(async_write_queue_act.begin() + i);
-                }
-
-                return true;
-            }
+            --entry->queue_act; // actual queue
+            --async_write_act_open;
         }
     }
-    return false;
+    *start_time = entry->time;
+    *size = entry->size;
+
+    if (entry->queue_req == 0 && entry->queue_act == 0) // finished request > delete from queue
+        async_write_queue.Retire(entry);
+
+    return true;
 }
 
 //************************************************************************************
@@ -720,54 +1129,46 @@ bool IOtrace::
 //************************************************************************************
 /**
  * @brief handles async read requests. Checks if the requests (req and act) for the bandwidth and throughput ended.
- * bandwidth requests are saved in the vector \e async_write_queue_req
- * throughput requests are saved in the vector \e async_write_queue_act.
+ * The requests are stored in \e async_read_queue (see AsyncQueue), which finds them in O(1)
+ * over the request pointer or handle. Each entry has a counter for the required and the actual end.
  * The actual and the required I/O are allowed each to quary this status only once.
  * after that false is returned (solves problem with several MPI_Test/Wait)
- * if both I/O (req and actual) finished, the request is deleted.
- * @param request [in] pointer of the current reuqest to check
+ * if both I/O (req and actual) finished, the request is retired from the queue.
+ * @param ptr_key [in] pointer key of the current reuqest to check (see AsyncRequest)
+ * @param handle_key [in] handle key of the current reuqest to check (see AsyncRequest)
  * @param start_time [out] start time of the request
  * @param size [out] number of \e bytes transfered in
  * @param mode [in]  1 -> required |  2 -> actual
  * @return \e true for the first time the async I/O operation ended.
  */
-bool IOtrace::Check_Request_Read(MPI_Request *request, double *start_time, long long *size, int mode)
+bool IOtrace::Check_Request_Read(uint64_t ptr_key, uint64_t handle_key, double *start_time, long long *size, int mode)
 {
-    if (!async_read_requests.empty())
-    {
-        for (unsigned int i = 0; i < async_read_requests.size(); i++)
+    async_entry *entry = async_read_queue.Find(ptr_key, handle_key);
+    if (entry == NULL)
+        return false;
+
+    if (mode == 1){
+        if (entry->queue_req == 0)
+            return false;
+        else
+            --entry->queue_req; // required queue
+    }
+    if (mode == 2){
+        if (entry->queue_act == 0)
+            return false;
+        else
         {
-            //if (async_read_requests[i].check_request(request) || (*request == MPI_REQUEST_NULL && async_read_requests.size() == 1))
-            if (async_read_requests[i].check_request(request))
-            {
-                if (mode == 1){
-                    if (async_read_queue_req[i] == 0)
-                        return false;
-                    else
-                        --async_read_queue_req[i]; // required queue
-                }
-                if (mode == 2){
-                    if (async_read_queue_act[i] == 0)
-                        return false;
-                    else
-                        --async_read_queue_act[i]; // actual queue
-                }
-                *start_time = async_read_time[i];
-                *size = async_read_size[i];
-
-                if (async_read_queue_req[i] == 0 && async_read_queue_act[i] == 0) // finished request > delete from queue
-                {
-                    async_read_time.erase(async_read_time.begin() + i);
-                    async_read_size.erase(async_read_size.begin() + i);
-                    async_read_requests.erase(async_read_requests.begin() + i);
-                    async_read_queue_req.erase(async_read_queue_req.begin() + i);
-                    async_read_queue_act.erase(async_read_queue_act.begin() + i);
-                }
-                return true;
-            }
+            --entry->queue_act; // actual queue
+            --async_read_act_open;
         }
     }
-    return false;
+    *start_time = entry->time;
+    *size = entry->size;
+
+    if (entry->queue_req == 0 && entry->queue_act == 0) // finished request > delete from queue
+        async_read_queue.Retire(entry);
+
+    return true;
 }
 
 //************************************************************************************
@@ -775,33 +1176,17 @@ bool IOtrace::Check_Request_Read(MPI_Request *request, double *start_time, long
 //************************************************************************************
 /**
  * @brief checks if all actual requests write or read (see \e mode) ended.
- * bandwidth requests are saved in the vector \e async_write_queue_req
- * @param mode [in]  1 -> write |  2 -> read
+ * The number of open actual requests is counted in \e Write/Read_Async_Start and
+ * \e Check_Request_Write/Read, so no scan over the queue is needed.
+ * @param mode [in]  0 -> write |  1 -> read
  * @return \e false if requests read/write (see mode) are active. Else true.
  */
 bool IOtrace::Act_Done(int mode)
 {
-    bool flag = true;
-
-    if (mode == 0)
-    { // write
-        for (unsigned int i = 0; i < async_write_queue_act.size(); i++)
-        {
-            if (async_write_queue_act[i] != 0)
-                flag = false;
-        }
-    }
-
-    else
-    { // read
-        for (unsigned int i = 0; i < async_read_queue_act.size(); i++)
-        {
-            if (async_read_queue_act[i] != 0)
-                flag = false;
-        }
-    }
-
-    return flag;
+    if (mode == 0) // write
+        return async_write_act_open == 0;
+    else // read
+        return async_read_act_open == 0;
 }
 
 //************************************************************************************
@@ -830,12 +1215,7 @@ int IOtrace::Get_Relevant_Ranks(MPI_File fh)
 //************************************************************************************
 double IOtrace::Overhead_Start(double t)
 {
-
-#if OVERHEAD == 1
-    t_overhead = t;
-#endif
-
-    return t;
+    return (this->*overhead_start)(t);
 }
 
 //************************************************************************************
@@ -843,11 +1223,30 @@ double IOtrace::Overhead_Start(double t)
 //************************************************************************************
 void IOtrace::Overhead_End(void)
 {
+    (this->*overhead_end)();
+}
 
-#if OVERHEAD == 1
-    delta_t_io_overhead += MPI_Wtime() - t_0 - t_overhead;
-#endif
-}; 
+/**
+ * @brief overhead tracing of a traced call, selected at \e Init for the runtime setting (TMIO_OVERHEAD). Without
+ * it, the calls neither store the start nor read the clock at the end
+ */
+template <bool on>
+double IOtrace::Overhead_Start_Traced(double t)
+{
+    if (on)
+        Local()->t_overhead = t;
+    return t;
+}
+
+template <bool on>
+void IOtrace::Overhead_End_Traced(void)
+{
+    if (on)
+    {
+        IOthread *local = Local();
+        local->Add_Overhead(clock.Now() - t_0 - local->t_overhead);
+    }
+}
 
 //************************************************************************************
 //*                               7. Overhead_Calculation
@@ -856,9 +1255,10 @@ void IOtrace::Overhead_End(void)
  * @brief calculates the overhead time. iF flag \OVERHEAD is provided, overhead time
  * during the runtime of the application is calculated in addion to the overhead at the end of the application
  * @details the returned vector contains [application_runtime, overhead_runtime, overhead_post_runtimme]
+ * @param interval [in] times of the interval (see io_interval)
  * @return double*
  */
-double *IOtrace::Overhead_Calculation(void)
+double *IOtrace::Overhead_Calculation(const io_interval &interval)
 {
 //iohf::Function_Debug(__PRETTY_FUNCTION__);
 #if IOTRACE_VERBOSE >= 1
@@ -867,37 +1267,25 @@ double *IOtrace::Overhead_Calculation(void)
 
     double *time_array = NULL;
 
-    int n_time = 2;
-#if OVERHEAD == 1
-    n_time = 3;
-#endif
-
+    // the overhead during the application runtime is 0 without TMIO_OVERHEAD
+    int n_time = 3;
     double tmp_time[n_time];
-    tmp_time[0] = delta_t_app; // application runtime
+    tmp_time[0] = interval.t_app; // application runtime
+    tmp_time[2] = interval.t_overhead; // overhead during applicaiton runtime
 
-#if OVERHEAD == 1
-    tmp_time[2] = delta_t_io_overhead; // overhead during applicaiton runtime
-#endif
-
-    // tmp_time[1] = (MPI_Wtime() - t_0) - delta_t_app; // overhead after application finishes
-    tmp_time[1] = (MPI_Wtime() - t_summary) - delta_t_app; // overhead after application finishes
+    // tmp_time[1] = (clock.Now() - t_0) - delta_t_app; // overhead after application finishes
+    tmp_time[1] = interval.Post(clock.Now()); // overhead after application finishes (with ASYNC_FLUSH: hand over to the flush thread)
 
     if (rank == 0)
         time_array = (double *)malloc(sizeof(double) * n_time);
 
-    MPI_Reduce(tmp_time, time_array, n_time, MPI_DOUBLE, MPI_SUM, 0, IO_WORLD);
+    MPI_Reduce(tmp_time, time_array, n_time, MPI_DOUBLE, MPI_SUM, 0, FLUSH_WORLD);
     
     
 #if IOTRACE_VERBOSE >= 2
-#if OVERHEAD == 1
     printf("%s > rank %i > generating I/O summary %s>> values are: [%e %e %e] \n %s", caller, rank, GREEN, tmp_time[0], tmp_time[1], tmp_time[2], BLACK);
     if (rank == 0)
         printf("%s > rank %i > generating I/O summary %s>> Aggregated values are: [%e %e %e] \n %s", caller, rank, GREEN, time_array[0], time_array[1], time_array[2], BLACK);
-#else
-    printf("%s > rank %i > generating I/O summary %s>> values are: [%e %e] \n %s", caller, rank, GREEN, tmp_time[0], tmp_time[1], BLACK);
-    if (rank == 0)
-        printf("%s > rank %i > generating I/O summary %s>> Aggregated values are: [%e %e] \n %s", caller, rank, GREEN, time_array[0], time_array[1], BLACK);
-#endif
 #endif
 
     return time_array;
@@ -906,11 +1294,11 @@ double *IOtrace::Overhead_Calculation(void)
 void IOtrace::Time_Info(std::string s){
 #if IOTRACE_VERBOSE > 2
     if (rank == 0){
-        // static double t_passed = MPI_Wtime() - t_0;
-        static double t_passed = MPI_Wtime() - t_summary;
-        printf("%s > rank %i %s> IOtrace > %s time: %.4e s --> passed time %.4f s %s\n", caller, rank, YELLOW,s.c_str(),MPI_Wtime() - t_0, (MPI_Wtime() - t_0) - t_passed,BLACK);
-        // t_passed = MPI_Wtime() - t_0;
-        t_passed = MPI_Wtime() - t_summary;
+        // static double t_passed = clock.Now() - t_0;
+        static double t_passed = clock.Now() - t_summary;
+        printf("%s > rank %i %s> IOtrace > %s time: %.4e s --> passed time %.4f s %s\n", caller, rank, YELLOW,s.c_str(),clock.Now() - t_0, (clock.Now() - t_0) - t_passed,BLACK);
+        // t_passed = clock.Now() - t_0;
+        t_passed = clock.Now() - t_summary;
     }
 #endif
 }
@@ -937,6 +1325,54 @@ void IOtrace::Set(std::string flag, bool value)
 }
 
 
+//! ------------------------------ Get values -------------------------------
+//************************************************************************************
+//*                               1. Count
+//************************************************************************************
+/**
+ * @brief returns the phases and operations recorded in the current interval, after replaying the
+ * buffers of all threads. Used by the tests (see threaded_io in test.cxx)
+ *
+ * @param mode [in] "aw", "ar", "sw" or "sr"
+ * @param phases [out] number of phases
+ * @param ops [out] number of I/O operations in these phases
+ */
+void IOtrace::Count(std::string mode, long long &phases, long long &ops)
+{
+    while (draining.exchange(true, std::memory_order_acquire))
+        std::this_thread::yield();
+    Drain();
+
+    IOdata *d = (mode == "aw") ? p_aw : (mode == "ar") ? p_ar : (mode == "sw") ? p_sw : p_sr;
+    phases = d->phase_data.size();
+    ops = 0;
+    for (unsigned int i = 0; i < d->phase_data.size(); i++)
+        ops += d->phase_data[i].n_op;
+    draining.store(false, std::memory_order_release);
+}
+
+//************************************************************************************
+//*                               2. Phases
+//************************************************************************************
+/**
+ * @brief returns a copy of the phases recorded in the current interval, after replaying the buffers of all
+ * threads. Used by the tests (see threaded_io in test.cxx)
+ *
+ * @param mode [in] "aw", "ar", "sw" or "sr"
+ * @param phases [out] phases in the order they were started
+ */
+void IOtrace::Phases(std::string mode, std::vector<collect> &phases)
+{
+    while (draining.exchange(true, std::memory_order_acquire))
+        std::this_thread::yield();
+    Drain();
+
+    IOdata *d = (mode == "aw") ? p_aw : (mode == "ar") ? p_ar : (mode == "sw") ? p_sw : p_sr;
+    phases = d->phase_data;
+    draining.store(false, std::memory_order_release);
+}
+
+
 //! ---------------------- Bw limit with Custom MPI implementaiton -------------------
 //************************************************************************************
 //*                               Bw_limit
@@ -945,7 +1381,7 @@ void IOtrace::Set(std::string flag, bool value)
 #ifdef BW_LIMIT
 void IOtrace::Apply_Limit(void)
 {
-    Overhead_Start(MPI_Wtime() - t_0);
+    Overhead_Start(clock.Now() - t_0);
     bw_limit.Limit_Async();
     Overhead_End();
 }
@@ -958,7 +1394,7 @@ void IOtrace::Apply_Limit(void)
 //************************************************************************************
 #ifdef CUSTOM_MPI
 void IOtrace::Replace_Test(void){
-    Overhead_Start(MPI_Wtime() - t_0);
+    Overhead_Start(clock.Now() - t_0);
     bw_limit.Set_Throughput();
     Overhead_End();
 }
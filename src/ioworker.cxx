@@ -0,0 +1,85 @@
+#include "ioworker.h"
+
+/**
+ * @file ioworker.cxx
+ * @brief Contains definitions of methods from the \e IOworker class.
+ */
+
+//! ------------------------------ Control ---------------------------------
+//************************************************************************************
+//*                               1. Start
+//************************************************************************************
+void IOworker::Start(void)
+{
+	if (thread.joinable())
+		return;
+	stop = false;
+	thread = std::thread(&IOworker::Loop, this);
+}
+
+//************************************************************************************
+//*                               2. Run
+//************************************************************************************
+/**
+ * @brief waits until the previous job finished and hands over the next one. Runs the job on the calling
+ * thread if the worker was not started
+ *
+ * @param next [in] job to run
+ */
+void IOworker::Run(std::function<void(void)> next)
+{
+	if (!thread.joinable())
+	{
+		next();
+		return;
+	}
+	std::unique_lock<std::mutex> lock(mutex);
+	cv.wait(lock, [this] { return !busy; });
+	job = std::move(next);
+	busy = true;
+	cv.notify_all();
+}
+
+//************************************************************************************
+//*                               3. Wait
+//************************************************************************************
+void IOworker::Wait(void)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	cv.wait(lock, [this] { return !busy; });
+}
+
+//************************************************************************************
+//*                               4. Stop
+//************************************************************************************
+void IOworker::Stop(void)
+{
+	if (!thread.joinable())
+		return;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		cv.wait(lock, [this] { return !busy; });
+		stop = true;
+		cv.notify_all();
+	}
+	thread.join();
+}
+
+//! ------------------------------ Thread ----------------------------------
+// runs the jobs until stopped
+void IOworker::Loop(void)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		cv.wait(lock, [this] { return busy || stop; });
+		if (!busy)
+			return;
+		std::function<void(void)> current = std::move(job);
+		lock.unlock();
+		current();
+		lock.lock();
+		busy = false;
+		cv.notify_all();
+	}
+}
@@ -0,0 +1,161 @@
+#include "iowriter.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <math.h>
+#include <charconv>
+
+/**
+ * @file iowriter.cxx
+ * @brief Contains definitions of methods from the \e IOwriter class.
+ */
+
+/**
+ * @brief opens a file for writing
+ *
+ * @param name [in] name of the file
+ * @param append [in] append to the file instead of truncating it
+ */
+IOwriter::IOwriter(const std::string &name, bool append) : used(0), capacity(WRITER_BUFFER), str(NULL)
+{
+	buffer = (char *)malloc(capacity);
+	file = fopen(name.c_str(), append ? "ab" : "wb");
+	if (file == NULL)
+		printf("IOwriter: could not open %s\n", name.c_str());
+}
+
+/**
+ * @brief appends the output to a string (flushed by \e Flush and the destructor)
+ *
+ * @param out [in,out] string the output is appended to
+ */
+IOwriter::IOwriter(std::string *out) : used(0), capacity(WRITER_BUFFER), file(NULL), str(out)
+{
+	buffer = (char *)malloc(capacity);
+}
+
+IOwriter::~IOwriter()
+{
+	Flush();
+	if (file)
+		fclose(file);
+	free(buffer);
+}
+
+//! ------------------------------ Writing ---------------------------------
+//************************************************************************************
+//*                               1. Append
+//************************************************************************************
+/**
+ * @brief copies text to the buffer. Text larger than the buffer is written directly
+ *
+ * @param s [in] text
+ * @param len [in] length of the text
+ */
+void IOwriter::Append(const char *s, size_t len)
+{
+	if (len > capacity - used)
+	{
+		Flush();
+		if (len >= capacity)
+		{
+			if (file)
+				fwrite(s, 1, len, file);
+			else if (str)
+				str->append(s, len);
+			return;
+		}
+	}
+	memcpy(buffer + used, s, len);
+	used += len;
+}
+
+//************************************************************************************
+//*                               2. Format
+//************************************************************************************
+/**
+ * @brief printf style formatting straight into the buffer
+ *
+ * @param format [in] format string
+ */
+void IOwriter::Format(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int len = vsnprintf(buffer + used, capacity - used, format, args);
+	va_end(args);
+	if (len < 0)
+		return;
+	if ((size_t)len < capacity - used)
+	{
+		used += len;
+		return;
+	}
+
+	// did not fit: format again after flushing (or into a temporary buffer if larger than the buffer)
+	Flush();
+	va_start(args, format);
+	if ((size_t)len < capacity)
+	{
+		vsnprintf(buffer, capacity, format, args);
+		used = len;
+	}
+	else
+	{
+		char *tmp = (char *)malloc(len + 1);
+		vsnprintf(tmp, len + 1, format, args);
+		Append(tmp, len);
+		free(tmp);
+	}
+	va_end(args);
+}
+
+//************************************************************************************
+//*                               3. Number
+//************************************************************************************
+/**
+ * @brief writes the shortest representation of a double that reads back to the same value
+ *
+ * @param x [in] value (NaN is written as "NaN")
+ */
+void IOwriter::Number(double x)
+{
+	if (isnan(x))
+	{
+		Append("NaN", 3);
+		return;
+	}
+	Reserve(32);
+	used = std::to_chars(buffer + used, buffer + capacity, x).ptr - buffer;
+}
+
+//************************************************************************************
+//*                               4. Integer
+//************************************************************************************
+void IOwriter::Integer(long long x)
+{
+	Reserve(24);
+	used = std::to_chars(buffer + used, buffer + capacity, x).ptr - buffer;
+}
+
+//************************************************************************************
+//*                               5. Flush
+//************************************************************************************
+/**
+ * @brief writes the buffer to the file (or appends it to the string) in one block
+ */
+void IOwriter::Flush(void)
+{
+	if (used == 0)
+		return;
+	if (file)
+		fwrite(buffer, 1, used, file);
+	else if (str)
+		str->append(buffer, used);
+	used = 0;
+}
+
+void IOwriter::Reserve(size_t len)
+{
+	if (len > capacity - used)
+		Flush();
+}
@@ -11,111 +11,83 @@ statistics::statistics(void)
 	max_bytes = 0;
 	agg_bytes = 0;
 	max_bytes_phase = 0;
+	time_act = 0;
+	time_req = 0;
+	time_lost = 0;
 }
 
 statistics::statistics(collect *c, int *n, int rank, int procs, bool w_or_r, bool flag_req)
 {
 
 	this->flag_req = flag_req;
-	if (rank == 0)
-	{
-		// assign collect object
-		all_data = c;
-		this->w_or_r = w_or_r;
+	this->w_or_r = w_or_r;
+	this->procs = procs; // all ranks
 
-		this->procs = procs;	  // all ranks
-		procs_io = 0; // ranks that did I/O
+	// assign collect object (rank 0, NULL if only metrics are needed)
+	all_data = c;
+	phases_of_ranks = n;
 
 #if DFT >= 1
-		dft_time = 0;
+	dft_time = 0;
 #endif
 
-		phases_of_ranks = n;
-		max_phases = 0; // maximum phases over ranks
-		agg_phases = 0; // total number of phases
-
-		max_ops = 0;	  // maximum number of I/O operations in  all  phases
-		max_ops_rank = 0; // maximum number of I/O operations for all ranks
-		long long tmp_max_ops_rank = 0;
-		agg_ops = 0; // aggregated number of I/O operations
-
-		max_bytes = 0; // maximum bytes transfered by a ranks
-		long long tmp_max_bytes = 0;
-		max_bytes_phase = 0; // maximum bytes transfered during phase
-		agg_bytes = 0;		  // aggregated bytes for entire application
-
-		int counter = 0;
-		for (int i = 0; i < procs; i++)
-		{
-
-			// find ranks that did I/O
-			if (phases_of_ranks[i] > 0)
-				procs_io++;
-
-			// maximum phases over ranks
-			if (phases_of_ranks[i] > max_phases)
-				max_phases = phases_of_ranks[i];
-
-			// aggregated over all ranks
-			agg_phases += phases_of_ranks[i];
-
-			tmp_max_ops_rank = 0;
-			tmp_max_bytes = 0;
-			for (int j = 0; j < phases_of_ranks[i]; j++)
-			{
-				tmp_max_ops_rank += all_data[counter].n_op;
-				if (tmp_max_ops_rank > max_ops_rank)
-					max_ops_rank = tmp_max_ops_rank;
-
-				tmp_max_bytes += all_data[counter].data;
-				if (tmp_max_bytes > max_bytes)
-					max_bytes = tmp_max_bytes;
-
-				if (all_data[counter].n_op > max_ops)
-					max_ops = all_data[counter].n_op;
-
-				// maximum bytes over all phases
-				if (all_data[counter].data > max_bytes_phase)
-					max_bytes_phase = all_data[counter].data;
-
-				agg_ops += all_data[counter].n_op;
-				agg_bytes += all_data[counter].data;
-
-				counter++;
-			}
-		}
-	}
+	// filled by Reduce_Phase_Info
+	procs_io = 0;		 // ranks that did I/O
+	max_phases = 0;		 // maximum phases over ranks
+	agg_phases = 0;		 // total number of phases
+	max_ops = 0;		 // maximum number of I/O operations in  all  phases
+	max_ops_rank = 0;	 // maximum number of I/O operations for all ranks
+	agg_ops = 0;		 // aggregated number of I/O operations
+	max_bytes = 0;		 // maximum bytes transfered by a ranks
+	max_bytes_phase = 0; // maximum bytes transfered during phase
+	agg_bytes = 0;		 // aggregated bytes for entire application
+	time_act = 0;
+	time_req = 0;
+	time_lost = 0;
 }
 
 statistics::~statistics()
 {
-	// keep it clean
+	// buffers are freed by io_buffer
 }
 
-void statistics::Clean(void)
+//! ----------------------- Overlap ------------------------------
+/**
+ * @brief number of events after which at least one phase overlaps
+ */
+int io_overlap::Non_Empty(void) const
 {
+	int out = 0;
+	for (size_t i = 0; i < n.size(); i++)
+		if (n[i] > 0)
+			out++;
+	return out;
+}
 
-// free(all_data);
-#if DO_CALC > 0
-	free(throughput_avr_phase);
-	free(throughput_sum_phase);
-	free(n_overlap_act);
-	if (flag_req)
-	{
-		free(bandwidth_avr_phase);
-		free(bandwidth_sum_phase);
-		free(n_overlap_req);
-	}
-#endif
-	free(all_t);
-	free(all_t_act_s);
-	free(all_t_act_e);
-	if (flag_req)
+/**
+ * @brief restores the overlapping phases after event \e e by replaying the deltas
+ *
+ * @param e [in] event
+ * @return std::vector<int> indices of the overlapping phases
+ */
+std::vector<int> io_overlap::Phases(size_t e) const
+{
+	std::vector<int> stack;
+	for (size_t i = 0; i <= e && i < delta.size(); i++)
 	{
-		free(all_b);
-		free(all_t_req_s);
-		free(all_t_req_e);
+		if (delta[i] >= 0)
+			stack.push_back(delta[i]);
+		else if (delta[i] != IO_OVERLAP_NONE)
+		{
+			std::vector<int>::iterator it = std::find(stack.begin(), stack.end(), -delta[i] - 1);
+			if (it != stack.end())
+			{
+				std::swap(*it, stack.back());
+				stack.pop_back();
+			}
+		}
 	}
+	return stack;
 }
 
 //! ----------------------- Statistics Core ------------------------------
@@ -146,23 +118,22 @@ void statistics::Compute(void)
 	//? (2) collective anaylsis of captured bandwidth
 	//?----------------------------------------------
 	//* find overlapping phases of different ranks
-	// iohf::Overlap(phase_overlap, phase_time, t_start, t_end, phases_of_ranks, agg_phases, procs);
-	Overlap(phase_overlap_act, phase_time_act, "t_end_act");
+	Overlap(overlap_act, FIELD_T_END_ACT);
 	if (flag_req)
-		Overlap(phase_overlap_req, phase_time_req, "t_end_req");
+		Overlap(overlap_req, FIELD_T_END_REQ);
 
 	//* find vector of overlaps (n_vec_overlap) ;
-	n_overlap_act = iohf::N_Phase(phase_overlap_act);
+	n_overlap_act = iohf::N_Phase(overlap_act.n);
 	if (flag_req)
-		n_overlap_req = iohf::N_Phase(phase_overlap_req);
+		n_overlap_req = iohf::N_Phase(overlap_req.n);
 
 	//* project bandwidthes (average and sum) on the overlap result
-	throughput_avr_phase = Phase_Bandwidth(phase_overlap_act, "T_avr");
-	throughput_sum_phase = Phase_Bandwidth(phase_overlap_act, "T_sum");
+	throughput_avr_phase = Phase_Bandwidth(overlap_act, FIELD_T_AVR);
+	throughput_sum_phase = Phase_Bandwidth(overlap_act, FIELD_T_SUM);
 	if (flag_req)
 	{
-		bandwidth_avr_phase = Phase_Bandwidth(phase_overlap_req, "B_avr");
-		bandwidth_sum_phase = Phase_Bandwidth(phase_overlap_req, "B_sum");
+		bandwidth_avr_phase = Phase_Bandwidth(overlap_req, FIELD_B_AVR);
+		bandwidth_sum_phase = Phase_Bandwidth(overlap_req, FIELD_B_SUM);
 	}
 
 	//? (3) Compute metrics (app and rank metrics)
@@ -170,7 +141,7 @@ void statistics::Compute(void)
 	Compute_Metrics();
 
 #if DFT >= 1
-	std::complex<double> *X = freq_analysis::Dft(throughput_avr_phase, &phase_time_act[0], phase_overlap_act.size(), flag_req, w_or_r, procs, dft_time, FREQ); // 200
+	std::complex<double> *X = freq_analysis::Dft(throughput_avr_phase, overlap_act.time.data(), overlap_act.Size(), flag_req, w_or_r, procs, dft_time, FREQ); // 200
 	free(X);
 #endif
 }
@@ -195,8 +166,9 @@ void statistics::Remove_Phase(int s, int e)
 	iohf::Function_Debug(__PRETTY_FUNCTION__);
 	int counter = 0;
 	// std::cout << "agg_phases is " << agg_phases << ", procs_io is " << procs_io << std::endl;
-	if (agg_phases > 1 && procs_io > 0 && ceil(agg_phases / procs_io) > 1 && (e > 0 || s > 0))
+	if (Skip_Phases(0, s, e))
 	{
+		// Skip_Phases holds for all ranks below procs_io
 
 		for (int i = 0; i < procs_io; i++)
 		{
@@ -227,210 +199,209 @@ void statistics::Remove_Phase(int s, int e)
 }
 
 //**********************************************************************
-//*                       2. Overlap
+//*                       2. Skip_Phases
+//**********************************************************************
+/**
+ * @brief true if \e Remove_Phase removes phases of a rank. Phases are only removed if the ranks have more than
+ * one phase on average, and only from the first procs_io ranks in rank order. \e Compute_Rank_Metrics uses it
+ * to skip the same phases on each rank
+ *
+ * @param rank [in] rank
+ * @param s [in] number of phases to remove from the start
+ * @param e [in] number of phases to remove from the end
+ */
+bool statistics::Skip_Phases(int rank, int s, int e) const
+{
+	return (e > 0 || s > 0) && agg_phases > 1 && procs_io > 0 && ceil(agg_phases / procs_io) > 1 && rank < procs_io;
+}
+
+//**********************************************************************
+//*                       3. Overlap
 //**********************************************************************
 /**
- * @brief   function for finding phases for the entire job
+ * @brief   function for finding phases for the entire job. The start and end events of all phases are swept in
+ * time order. For every event, only the phase that was added or removed is stored (see \e io_overlap)
  *
- * @param phase_overlap [out] vector of vectors storing overlaping phases of all ranks
- * @param phase_time [out] vector storing start and end of the overlapping regions
+ * @param overlap [out] overlapping phases of all ranks (one entry per event)
  * @param mode [in] indicates if req or act is used.
- * Supported modes are: "t_end_req" and "t_end_act"
- * default mode is "t_end_act"
+ * Supported modes are: FIELD_T_END_REQ and FIELD_T_END_ACT
  */
-void statistics::Overlap(std::vector<std::vector<int>> &phase_overlap, std::vector<double> &phase_time, std::string mode)
+void statistics::Overlap(io_overlap &overlap, collect_field mode)
 {
 	iohf::Function_Debug(__PRETTY_FUNCTION__);
-	std::vector<int> stack;
-	stack.reserve(agg_phases);
-	// #ifdef OPENMP
-	// std::cout << "max number of OpenMP threads: ";
-	// std::cout << omp_get_max_threads() << std::endl;
-	// #endif
-
-	int k_s = 0;
-	int k_e = 0;
+	overlap.delta.clear();
+	overlap.n.clear();
+	overlap.time.clear();
+	overlap.delta.reserve(2 * agg_phases);
+	overlap.n.reserve(2 * agg_phases);
+#if ALL_SAMPLES > 2
+	overlap.time.reserve(2 * agg_phases);
+#endif
 
 	// sort start and end times of the phases
-	int *id_s = iohf::Sort_With_Index(all_data, agg_phases);
-	int *id_e = iohf::Sort_With_Index(all_data, agg_phases, mode);
-
-	int n = 0;
-	// Disp(t_start, agg_phases, "t_start = ");
-	// Disp(t_end, agg_phases, "t_end = ");
-
-	while (k_s < agg_phases || k_e < agg_phases)
+	double *t_s = (double *)malloc(sizeof(double) * agg_phases);
+	double *t_e = (double *)malloc(sizeof(double) * agg_phases);
+	double collect::*end = collect::Member(mode);
+	for (int i = 0; i < agg_phases; i++)
 	{
-
-#if HDEBUG >= 2
-		std::cout << "k_e = " << k_e << ", id_e[k_e] = " << id_e[k_e] << ",    t_end[id_e[k_e]] = " << all_data[id_e[k_e]].get(mode) << std::endl;
-		if (k_s != agg_phases)
-			std::cout << "k_s = " << k_s << ", id_s[k_s] = " << id_s[k_s] << ", t_start[id_s[k_s]] = " << all_data[id_s[k_s]].t_start << std::endl;
+		t_s[i] = all_data[i].t_start;
+		t_e[i] = all_data[i].*end;
+	}
+	int *id_s, *id_e;
+#ifdef OPENMP
+#pragma omp parallel sections
+#endif
+	{
+#ifdef OPENMP
+#pragma omp section
 #endif
+		id_s = iohf::Sort_With_Index(t_s, agg_phases);
+#ifdef OPENMP
+#pragma omp section
+#endif
+		id_e = iohf::Sort_With_Index(t_e, agg_phases);
+	}
 
-		//? case 1: end happend before start -> remove the phase from the stack
+	std::vector<char> active(agg_phases, 0);
+	int n_active = 0;
+	int k_s = 0;
+	int k_e = 0;
+	while (k_s < agg_phases || k_e < agg_phases)
+	{
+		//? case 1: end happend before start -> remove the phase
 		// if it is the last phase, application I/O phase ended
-		if (k_s == agg_phases || (all_data[id_e[k_e]].get(mode) < all_data[id_s[k_s]].t_start))
+		if (k_s == agg_phases || (t_e[id_e[k_e]] < t_s[id_s[k_s]]))
 		{
-			if (stack.size() == 1)
-				stack.pop_back();
-			else
+			int id = id_e[k_e];
+			if (active[id])
 			{
-				for (unsigned int j = 0; j < stack.size(); j++)
-				{
-#if HDEBUG >= 2
-					std::cout << "\t( " << stack[j] << " == " << id_e[k_e] << " )?";
-#endif
-					if (stack[j] == id_e[k_e])
-					{
-						// old
-						// stack.erase(stack.begin() + j);
-						// std::cout << "old method: " << stack[j] << std:: endl;
-						std::swap(stack[j], stack.back());
-						stack.pop_back();
-#if HDEBUG >= 2
-						std::cout << "-> removed " << id_e[k_e] << std::endl;
-#endif
-						break;
-					}
-				}
+				active[id] = 0;
+				n_active--;
+				overlap.delta.push_back(-id - 1);
 			}
-//* debug: show current phase
-#if HDEBUG >= 1
-			std::cout << "phase " << id_e[k_e] << " -> end" << std::endl;
-			std::cout << "stack: ";
-			for (unsigned int i = 0; i < stack.size(); i++)
-				std::cout << " " << stack[i] << " ";
-			std::cout << std::endl;
-#endif
-// track phase_time if ALL_SAMPLE is set
+			else
+				overlap.delta.push_back(IO_OVERLAP_NONE);
 #if ALL_SAMPLES > 2
-			phase_time.push_back(all_data[id_e[k_e]].get(mode));
-			// std::cout << "all_data[id_e[k_e]]."<< mode<<" " << all_data[id_e[k_e]].get(mode)<<  std::endl;
+			overlap.time.push_back(t_e[id]);
+#endif
+#if HDEBUG >= 1
+			std::cout << "phase " << id << " -> end (" << n_active << " overlapping)" << std::endl;
 #endif
-
 			k_e++;
 		}
-		//? case 2: start is before end -> overlap. Add the overlaping phase to stack
+		//? case 2: start is before end -> overlap. Add the phase
 		else
 		{
-			stack.push_back(id_s[k_s]);
-#if HDEBUG >= 1
-			std::cout << "phase " << id_s[k_s] << " -> start" << std::endl;
-			std::cout << "stack: ";
-			for (unsigned int i = 0; i < stack.size(); i++)
-				std::cout << " " << stack[i] << " ";
-			std::cout << std::endl;
-#endif
+			int id = id_s[k_s];
+			active[id] = 1;
+			n_active++;
+			overlap.delta.push_back(id);
 #if ALL_SAMPLES > 2
-			phase_time.push_back(all_data[id_s[k_s]].t_start);
-			// std::cout << "all_data[id_e[k_e]].t_start "<< all_data[id_s[k_s]].t_start<<  std::endl;
+			overlap.time.push_back(t_s[id]);
+#endif
+#if HDEBUG >= 1
+			std::cout << "phase " << id << " -> start (" << n_active << " overlapping)" << std::endl;
 #endif
 			k_s++;
 		}
-
-		// snapshot current stack to phase_overlapult
-		phase_overlap.push_back(std::vector<int>());
-		phase_overlap[n++] = stack;
+		overlap.n.push_back(n_active);
 	}
 
 // plot graph if flag is set
 #if OVERLAP_GRAPH > 0
-	iohf::Overlap_Graph(phase_overlap, agg_phases);
+	iohf::Overlap_Graph(overlap.n, agg_phases);
 #endif
 
 #if HDEBUG > 0
-	if (agg_phases > 0)
+	// print all phases
+	for (size_t rowD = 0; rowD < overlap.Size(); rowD++)
 	{
-		// print sorted and unsorted start and end phase_time
-		for (int i = 0; i < agg_phases; i++)
-			std::cout << "all_data[i" << i << "].t_start = " << all_data[i].t_start << "\t"
-					  << "sorted all_data[" << i << "].t_start = " << all_data[id_s[i]].t_start << std::endl;
-		for (int i = 0; i < agg_phases; i++)
-			std::cout << "all_data[i" << i << "].t_end  = " << all_data[i].get(mode) << "\t"
-					  << "sorted all_data[" << i << "].t_end = " << all_data[id_e[i]].get(mode) << std::endl;
-
-		// print all phases
-
-		for (int rowD = 0; rowD < phase_overlap.size(); rowD++)
-		{
-			std::cout << std::endl
-					  << "Phase " << rowD << ": ";
-			for (int colD = 0; colD < phase_overlap[rowD].size(); colD++)
-				std::cout << phase_overlap[rowD][colD] << " ";
-		}
-
-		std::cout << "\n\n";
+		std::vector<int> phases = overlap.Phases(rowD);
+		std::cout << std::endl
+				  << "Phase " << rowD << ": ";
+		for (size_t colD = 0; colD < phases.size(); colD++)
+			std::cout << phases[colD] << " ";
 	}
+	std::cout << "\n\n";
 #endif
 
+	free(t_s);
+	free(t_e);
 	free(id_s);
 	free(id_e);
 }
 
 //**********************************************************************
-//*                       3. Phase_Bandwidth
+//*                       4. Phase_Bandwidth
 //**********************************************************************
 /**
  * @brief maps the bandwidths to the overlapping regions. The bandwidths of the selected \e mode
- * are aggregated according to the overlapping of the regions
+ * are aggregated according to the overlapping of the regions. The sum over the overlapping phases is
+ * updated at every event (compensated summation) and reset once no phase overlaps
  *
- * @param res
- * @param mode
- * @return double*
+ * @param overlap [in] overlapping phases (see Overlap)
+ * @param mode [in] field to aggregate (e.g., FIELD_T_AVR)
+ * @return double* sum for every event (ALL_SAMPLES > 1) or for every non-empty event
  */
-double *statistics::Phase_Bandwidth(std::vector<std::vector<int>> &res, std::string mode)
+double *statistics::Phase_Bandwidth(const io_overlap &overlap, collect_field mode)
 {
 	// ALL_SAMPLES > 1 print also zeroes bandwidth values, else skip
 	iohf::Function_Debug(__PRETTY_FUNCTION__);
 
+	double *value = (double *)malloc(sizeof(double) * agg_phases);
+	double collect::*field = collect::Member(mode);
+	for (int i = 0; i < agg_phases; i++)
+		value[i] = all_data[i].*field;
+
 #if ALL_SAMPLES > 1 // also print zero bandiwdth
-	double *out = (double *)malloc(res.size() * sizeof(double));
-	// add all bandidth in phases
-	for (unsigned int i = 0; i < res.size(); i++)
+	double *out = (double *)malloc(overlap.Size() * sizeof(double));
+#else
+	double *out = (double *)malloc(overlap.Non_Empty() * sizeof(double));
+#endif
+
+	double sum = 0;
+	double c = 0;	 // compensation (Neumaier)
+	int n_nan = 0; // overlapping phases with NaN (removed phases)
+	int n = 0;
+	for (size_t i = 0; i < overlap.Size(); i++)
 	{
-		out[i] = 0;
-		for (unsigned int j = 0; j < res[i].size(); j++)
+		int id = overlap.delta[i];
+		double x = 0;
+		if (id >= 0)
+			x = value[id];
+		else if (id != IO_OVERLAP_NONE)
+			x = -value[-id - 1];
+
+		if (isnan(x))
+			n_nan += (id >= 0) ? 1 : -1;
+		else
 		{
-
-			out[i] += all_data[res[i][j]].get(mode);
+			double t = sum + x;
+			c += (fabs(sum) >= fabs(x)) ? (sum - t) + x : (x - t) + sum;
+			sum = t;
 		}
 
-		// if (res[i].size() == 0)
-		//   std::cout << "Application phase "<< ++app_phase << " over" << std::endl;
-	}
-#else
-	// find number of non-empty overlaps (n_overla)
-	int n = iohf::Non_Empty(res);
-	double *out = (double *)malloc(n * sizeof(double));
-	n = 0;
-	// add all bandidth in phases
-	for (int i = 0; i < res.size(); i++)
-	{
-		if (!res[i].empty())
+		if (overlap.n[i] == 0)
 		{
-			out[n] = 0;
-			for (int j = 0; j < res[i].size(); j++)
-			{
-				if (!isnan(all_data[res[i][j]].get(mode)))
-				{
-					if (j == 0)
-						out[n] = all_data[res[i][j]].get(mode);
-					else
-						out[n] += all_data[res[i][j]].get(mode);
-				}
-			}
-
-			n++;
+			sum = 0;
+			c = 0;
+			n_nan = 0;
 		}
-	}
+
+#if ALL_SAMPLES > 1
+		out[n++] = (n_nan > 0) ? std::numeric_limits<double>::quiet_NaN() : sum + c;
+#else
+		if (overlap.n[i] > 0)
+			out[n++] = sum + c;
 #endif
+	}
 
+	free(value);
 	return out;
 }
 
 //**********************************************************************
-//*                       4. Phase_Detection
+//*                       5. Phase_Detection
 //**********************************************************************
 /**
  * @brief Detect phases at application level.
@@ -442,52 +413,128 @@ void statistics::Phase_Detection(void)
 }
 
 //**********************************************************************
-//*                       5. Gather_Ind_Bandwidth
+//*                       6. Gather_Ind_Bandwidth
 //**********************************************************************
 /**
  * @brief Gather bandwidth of individual operations of each rank
  *
  */
-void statistics::Gather_Ind_Bandwidth(int rank, int procs, std::vector<double> t, std::vector<double> b, std::vector<double> t_act_s, std::vector<double> t_act_e, std::vector<double> t_req_s, std::vector<double> t_req_e, MPI_Comm IO_WORLD)
+void statistics::Gather_Ind_Bandwidth(int rank, int procs, const IOsamples &act, const IOsamples &req, MPI_Comm IO_WORLD)
 {
+	// number of samples each rank holds. Can be lower than the number of operations with MEMORY_CAP
+	int n_local[2] = {(int)act.Size(), (int)req.Size()};
+	int *n_all = NULL;
+	int *n_two = NULL;
 	int *n_ind = NULL;
-	int counter = 0;
+	int *n_ind_req = NULL;
 	if (rank == 0)
 	{
+		n_all = (int *)malloc(sizeof(int) * 2 * procs);
+		n_two = (int *)malloc(sizeof(int) * procs);
 		n_ind = (int *)malloc(sizeof(int) * procs);
+		n_ind_req = (int *)malloc(sizeof(int) * procs);
+		for (int i = 0; i < procs; i++)
+			n_two[i] = 2;
+	}
+	IOgather::Get(IO_WORLD).Gatherv(n_local, 2, MPI_INT, n_all, n_two);
+
+	if (rank == 0)
+	{
+		agg_samples_act = 0;
+		agg_samples_req = 0;
 		for (int i = 0; i < procs; i++)
 		{
-			n_ind[i] = 0;
-			for (int j = 0; j < phases_of_ranks[i]; j++)
-			{
-				n_ind[i] += all_data[counter].n_op;
-				counter++;
-			}
+			n_ind[i] = n_all[2 * i];
+			n_ind_req[i] = n_all[2 * i + 1];
+			agg_samples_act += n_ind[i];
+			agg_samples_req += n_ind_req[i];
 		}
 
-		all_t = (double *)malloc(sizeof(double) * agg_ops);
-		all_t_act_s = (double *)malloc(sizeof(double) * agg_ops);
-		all_t_act_e = (double *)malloc(sizeof(double) * agg_ops);
+		all_t = (double *)malloc(sizeof(double) * agg_samples_act);
+		all_t_act_s = (double *)malloc(sizeof(double) * agg_samples_act);
+		all_t_act_e = (double *)malloc(sizeof(double) * agg_samples_act);
 	}
 
-	iohf::Gather_Summary(t.size(), procs, rank, all_t, t, n_ind, IO_WORLD);
-	iohf::Gather_Summary(t_act_s.size(), procs, rank, all_t_act_s, t_act_s, n_ind, IO_WORLD);
-	iohf::Gather_Summary(t_act_e.size(), procs, rank, all_t_act_e, t_act_e, n_ind, IO_WORLD);
+	act.Gather(SAMPLE_B, all_t, n_ind, IO_WORLD);
+	act.Gather(SAMPLE_T_S, all_t_act_s, n_ind, IO_WORLD);
+	act.Gather(SAMPLE_T_E, all_t_act_e, n_ind, IO_WORLD);
 	if (flag_req)
 	{
 		if (rank == 0)
 		{
-			all_b = (double *)malloc(sizeof(double) * agg_ops);
-			all_t_req_s = (double *)malloc(sizeof(double) * agg_ops);
-			all_t_req_e = (double *)malloc(sizeof(double) * agg_ops);
+			all_b = (double *)malloc(sizeof(double) * agg_samples_req);
+			all_t_req_s = (double *)malloc(sizeof(double) * agg_samples_req);
+			all_t_req_e = (double *)malloc(sizeof(double) * agg_samples_req);
 		}
 
-		iohf::Gather_Summary(b.size(), procs, rank, all_b, b, n_ind, IO_WORLD);
-		iohf::Gather_Summary(t_req_s.size(), procs, rank, all_t_req_s, t_req_s, n_ind, IO_WORLD);
-		iohf::Gather_Summary(t_req_e.size(), procs, rank, all_t_req_e, t_req_e, n_ind, IO_WORLD);
+		req.Gather(SAMPLE_B, all_b, n_ind_req, IO_WORLD);
+		req.Gather(SAMPLE_T_S, all_t_req_s, n_ind_req, IO_WORLD);
+		req.Gather(SAMPLE_T_E, all_t_req_e, n_ind_req, IO_WORLD);
 	}
 
+	free(n_all);
+	free(n_two);
 	free(n_ind);
+	free(n_ind_req);
+}
+
+//**********************************************************************
+//*                       7. Reduce_Phase_Info
+//**********************************************************************
+/**
+ * @brief computes the phase, operation, byte and time information from the phases of every rank and
+ * reduces it over all ranks. Collective. The result is available on every rank, so the (rank 0) array of
+ * all phases is not needed for it
+ *
+ * @param local [in] phases of the current rank
+ * @param rank [in] current rank
+ * @param IO_WORLD [in] communicator
+ */
+void statistics::Reduce_Phase_Info(const std::vector<collect> &local, int rank, MPI_Comm IO_WORLD)
+{
+	iohf::Function_Debug(__PRETTY_FUNCTION__);
+
+	//? sums: {ranks with I/O, phases, ops, bytes}, maxima: {phases, ops in phase, ops of rank, bytes of rank, bytes in phase}
+	long long sum[4] = {local.empty() ? 0 : 1, (long long)local.size(), 0, 0};
+	long long max[5] = {(long long)local.size(), 0, 0, 0, 0};
+	double time[3] = {0, 0, 0};
+	for (size_t i = 0; i < local.size(); i++)
+	{
+		sum[2] += local[i].n_op;
+		sum[3] += local[i].data;
+		max[1] = (local[i].n_op > max[1]) ? local[i].n_op : max[1];
+		max[4] = (local[i].data > max[4]) ? local[i].data : max[4];
+
+		time[0] += local[i].t_end_act - local[i].t_start;
+		time[1] += local[i].t_end_req - local[i].t_start;
+		double lost = (local[i].t_end_act - local[i].t_start) - (local[i].t_end_req - local[i].t_start);
+		time[2] += lost > 0 ? lost : 0;
+	}
+	max[2] = sum[2];
+	max[3] = sum[3];
+
+	long long sum_all[4];
+	long long max_all[5];
+	double time_all[3];
+	MPI_Allreduce(sum, sum_all, 4, MPI_LONG_LONG, MPI_SUM, IO_WORLD);
+	MPI_Allreduce(max, max_all, 5, MPI_LONG_LONG, MPI_MAX, IO_WORLD);
+	MPI_Reduce(time, time_all, 3, MPI_DOUBLE, MPI_SUM, 0, IO_WORLD);
+
+	procs_io = sum_all[0];
+	agg_phases = sum_all[1];
+	agg_ops = sum_all[2];
+	agg_bytes = sum_all[3];
+	max_phases = max_all[0];
+	max_ops = max_all[1];
+	max_ops_rank = max_all[2];
+	max_bytes = max_all[3];
+	max_bytes_phase = max_all[4];
+	if (rank == 0)
+	{
+		time_act = time_all[0];
+		time_req = time_all[1];
+		time_lost = time_all[2];
+	}
 }
 
 //! ----------------------- Metric Calculation ------------------------------
@@ -505,9 +552,29 @@ void statistics::Compute_Metrics(void)
 	//?------------------------------------
 	Compute_App_Metrics();
 
-	//? (2) Metrics over ranks (except agg_max)
-	//?------------------------------------
-	Compute_Rank_Metrics();
+	//? (2) Metrics over ranks are computed collectively (see Compute_Rank_Metrics)
+}
+
+/**
+ * @brief max and harmonic mean of an overlapping bandwidth in one pass (see iokernels.h). Same results as
+ * iohf::Max with iohf::Harmonic_Mean_Non_Zero (non_zero) or iohf::Harmonic_Mean
+ */
+static void App_Metrics(const double *b, int n, bool non_zero, core_app_metrics &out)
+{
+	if (b == NULL || n == 0)
+	{
+		out.max = 0;
+		out.hmean = non_zero ? 0 : -1;
+		return;
+	}
+
+	io_moments m;
+	iokernels::Moments(b, NULL, n, 0, m);
+	out.max = (m.max > 0) ? m.max : 0;
+	if (non_zero)
+		out.hmean = (m.n - m.n_zero) / m.inv;
+	else
+		out.hmean = (m.n_zero > 0) ? 0 : m.n / m.inv;
 }
 
 //**********************************************************************
@@ -521,192 +588,233 @@ void statistics::Compute_App_Metrics(void)
 	//! comput max/hmean of overlapping bandwidth (max for required bandwidth and hmean for bandwidth)
 	//* 1) if all samples are printed, the overlap algo in iohf::Phase_Bandwidth introduces zero must be removed for calculating the harmonic mean.
 	//* 2) if not all samples are printed, reduce the amount of throughput_sum_phase/throughput_avr_phase  by removing zero regions (n_tmp = iohf::Non_Empty)
+	//* both metrics of an array are computed in one pass (App_Metrics)
 #if ALL_SAMPLES > 1
-	throughput.app_metric.avr.max = iohf::Max(throughput_avr_phase, phase_overlap_act.size());
-	throughput.app_metric.avr.hmean = iohf::Harmonic_Mean_Non_Zero(throughput_avr_phase, phase_overlap_act.size());
+	App_Metrics(throughput_avr_phase, overlap_act.Size(), true, throughput.app_metric.avr);
 #if SHOW_SUM == 1
-	throughput.app_metric.sum.max = iohf::Max(throughput_sum_phase, phase_overlap_act.size());
-	throughput.app_metric.sum.hmean = iohf::Harmonic_Mean_Non_Zero(throughput_sum_phase, phase_overlap_act.size());
+	App_Metrics(throughput_sum_phase, overlap_act.Size(), true, throughput.app_metric.sum);
 #endif
 
 	if (flag_req)
 	{
-		bandwidth.app_metric.sum.max = iohf::Max(bandwidth_sum_phase, phase_overlap_req.size());
-		bandwidth.app_metric.sum.hmean = iohf::Harmonic_Mean_Non_Zero(bandwidth_sum_phase, phase_overlap_req.size());
+		App_Metrics(bandwidth_sum_phase, overlap_req.Size(), true, bandwidth.app_metric.sum);
 #if SHOW_AVR == 1
-		bandwidth.app_metric.avr.max = iohf::Max(bandwidth_avr_phase, phase_overlap_req.size());
-		bandwidth.app_metric.avr.hmean = iohf::Harmonic_Mean_Non_Zero(bandwidth_avr_phase, phase_overlap_req.size());
+		App_Metrics(bandwidth_avr_phase, overlap_req.Size(), true, bandwidth.app_metric.avr);
 #endif
 	}
 
 #else
-	int n_tmp = iohf::Non_Empty(phase_overlap_act);
-	throughput.app_metric.avr.max = iohf::Max(throughput_avr_phase, n_tmp);
-	throughput.app_metric.avr.hmean = iohf::Harmonic_Mean(throughput_avr_phase, n_tmp);
+	int n_tmp = overlap_act.Non_Empty();
+	App_Metrics(throughput_avr_phase, n_tmp, false, throughput.app_metric.avr);
 #if SHOW_SUM == 1
-	throughput.app_metric.sum.max = iohf::Max(throughput_sum_phase, n_tmp);
-	throughput.app_metric.sum.hmean = iohf::Harmonic_Mean(throughput_sum_phase, n_tmp);
+	App_Metrics(throughput_sum_phase, n_tmp, false, throughput.app_metric.sum);
 #endif
 	if (flag_req)
 	{
-		n_tmp = iohf::Non_Empty(phase_overlap_req);
-		bandwidth.app_metric.sum.max = iohf::Max(bandwidth_sum_phase, n_tmp);
-		bandwidth.app_metric.sum.hmean = iohf::Harmonic_Mean(bandwidth_sum_phase, n_tmp);
+		n_tmp = overlap_req.Non_Empty();
+		App_Metrics(bandwidth_sum_phase, n_tmp, false, bandwidth.app_metric.sum);
 #if SHOW_AVR == 1
-		bandwidth.app_metric.avr.max = iohf::Max(bandwidth_avr_phase, n_tmp);
-		bandwidth.app_metric.avr.hmean = iohf::Harmonic_Mean(bandwidth_avr_phase, n_tmp);
+		App_Metrics(bandwidth_avr_phase, n_tmp, false, bandwidth.app_metric.avr);
 #endif
 	}
 #endif
 
 	// maximum number of overlapping phases of the ranks inside an application phase
-	throughput.n_max = (n_overlap_act == NULL) ? 0 : iohf::Max(n_overlap_act, phase_overlap_act.size());
+	throughput.n_max = (n_overlap_act == NULL) ? 0 : iohf::Max(n_overlap_act.get(), overlap_act.Size());
 	if (flag_req)
-		bandwidth.n_max = (n_overlap_req == NULL) ? 0 : iohf::Max(n_overlap_req, phase_overlap_req.size());
+		bandwidth.n_max = (n_overlap_req == NULL) ? 0 : iohf::Max(n_overlap_req.get(), overlap_req.Size());
 }
 
 //**********************************************************************
 //*                       3. Compute_Rank_Metrics
 //**********************************************************************
 /**
- * @brief computes the metrics from the overlaping phases as well as from the individual phases of the ranks
+ * @brief computes the metrics from the individual phases of the ranks. Collective: every rank summarizes its
+ * own phases (\e rank_partial) and the partials are combined with a single MPI_Allreduce. The median is found
+ * with a distributed selection (see ioreduce). The result is assigned on rank 0
  *
+ * @param local [in] phases of the current rank
+ * @param rank [in] current rank
+ * @param IO_WORLD [in] communicator
  */
-void statistics::Compute_Rank_Metrics(void)
+void statistics::Compute_Rank_Metrics(const std::vector<collect> &local, int rank, MPI_Comm IO_WORLD)
 {
-	Compute_Rank_Metrics_Core(true, true);
+	iohf::Function_Debug(__PRETTY_FUNCTION__);
+
+	//* fields: {throughput or bandwidth, avr or sum}
+	bool t_or_b[4];
+	bool avr_or_sum[4];
+	int n = 0;
+	t_or_b[n] = true;
+	avr_or_sum[n++] = true;
 #if SHOW_SUM == 1
-	Compute_Rank_Metrics_Core(true, false);
+	t_or_b[n] = true;
+	avr_or_sum[n++] = false;
 #endif
-
 	if (flag_req)
 	{
-		Compute_Rank_Metrics_Core(false, false);
+		t_or_b[n] = false;
+		avr_or_sum[n++] = false;
 #if SHOW_AVR == 1
-		Compute_Rank_Metrics_Core(false, true);
+		t_or_b[n] = false;
+		avr_or_sum[n++] = true;
+#endif
+	}
+
+	//* phases removed from the calculation (Remove_Phase on rank 0 marks them as NaN)
+	int skip_s = 0;
+	int skip_e = 0;
+#if DO_CALC > 0
+	if (Skip_Phases(rank, w_or_r ? SKIP_FIRST_WRITE : SKIP_FIRST_READ, w_or_r ? SKIP_LAST_WRITE : SKIP_LAST_READ))
+	{
+		skip_s = w_or_r ? SKIP_FIRST_WRITE : SKIP_FIRST_READ;
+		skip_e = w_or_r ? SKIP_LAST_WRITE : SKIP_LAST_READ;
+	}
+#endif
+
+	//? (1) partials of the current rank: the field is copied into a buffer, then a single pass of the fused
+	//? kernel (see iokernels.h) gives all sums and extrema
+	int first = skip_s;
+	int n_phases = ((int)local.size() - skip_e > first) ? (int)local.size() - skip_e - first : 0;
+	std::vector<double> x(n_phases);
+	std::vector<double> bytes(n_phases);
+	for (int i = 0; i < n_phases; i++)
+		bytes[i] = local[first + i].data;
+
+	rank_partial partial[4];
+	rank_partial all[4];
+	std::vector<double> values[4];
+	double rank_max[4];
+	double prev_max[4];
+	double collect::*field[4];
+	for (int f = 0; f < n; f++)
+	{
+		field[f] = collect::Member(t_or_b[f] ? (avr_or_sum[f] ? FIELD_T_AVR : FIELD_T_SUM) : (avr_or_sum[f] ? FIELD_B_AVR : FIELD_B_SUM));
+		values[f].reserve(n_phases);
+		for (int i = 0; i < n_phases; i++)
+		{
+			x[i] = local[first + i].*field[f];
+			if (!isnan(x[i]))
+				values[f].push_back(x[i]);
+		}
+
+		io_moments m;
+		iokernels::Moments(x.data(), bytes.data(), n_phases, 0, m);
+		ioreduce::Init(partial[f]);
+		partial[f].inv = m.inv;
+		partial[f].w_inv = m.w_inv;
+		partial[f].sum = m.sum;
+		partial[f].min = (m.min < partial[f].min) ? m.min : partial[f].min;
+		partial[f].max = (m.max > partial[f].max) ? m.max : partial[f].max;
+		partial[f].bytes = (long long)m.w;
+		partial[f].n = m.n;
+		std::sort(values[f].begin(), values[f].end());
+		rank_max[f] = partial[f].max;
+	}
+
+	//* agg_max sums the running maximum over the phases in rank order: start from the maximum of the lower ranks
+	MPI_Exscan(rank_max, prev_max, n, MPI_DOUBLE, MPI_MAX, IO_WORLD);
+	for (int f = 0; f < n; f++)
+	{
+		double max = (rank == 0) ? 0 : prev_max[f];
+		for (int i = 0; i < (int)local.size(); i++)
+		{
+			double tmp = local[i].*field[f];
+			if (!isnan(tmp) && i >= skip_s && i < (int)local.size() - skip_e)
+				max = (tmp > max) ? tmp : max;
+			partial[f].agg_max += max;
+		}
+	}
+
+	//? (2) combine
+	ioreduce::Allreduce(partial, all, n, IO_WORLD);
+
+	//? (3) median and percentiles: linear interpolation between the values floor(p*(N-1)) and the next one
+#if PERCENTILES == 1
+	const int n_p = 3;
+	const double p[n_p] = {0.5, 0.9, 0.99};
+#else
+	const int n_p = 1;
+	const double p[n_p] = {0.5};
 #endif
+	int of[4 * 2 * n_p];
+	long long k[4 * 2 * n_p];
+	double kth[4 * 2 * n_p];
+	int q = 0;
+	for (int f = 0; f < n; f++)
+	{
+		long long N = (all[f].n > 0) ? all[f].n : 1;
+		for (int j = 0; j < n_p; j++)
+		{
+			long long lo = (long long)(p[j] * (N - 1));
+			of[q] = f;
+			k[q++] = lo;
+			of[q] = f;
+			k[q++] = (lo + 1 < N) ? lo + 1 : lo;
+		}
 	}
+	ioreduce::Select(values, of, k, kth, q, IO_WORLD);
+
+	if (rank == 0 && agg_phases != 0)
+		for (int f = 0; f < n; f++)
+		{
+			double percentile[3] = {0, 0, 0};
+			long long N = all[f].n;
+			for (int j = 0; j < n_p && N > 0; j++)
+			{
+				double pos = p[j] * (N - 1);
+				double lo = kth[2 * (f * n_p + j)];
+				double hi = kth[2 * (f * n_p + j) + 1];
+				percentile[j] = lo + (pos - (long long)pos) * (hi - lo);
+			}
+			Set_Rank_Metrics(t_or_b[f], avr_or_sum[f], all[f], percentile);
+		}
 }
 
 //**********************************************************************
-//*                       4. Compute_Rank_Metrics
+//*                       4. Set_Rank_Metrics
 //**********************************************************************
 /**
- * @brief computes the metrics from the overlaping phases as well as from the individual phases of the ranks
+ * @brief assigns the metrics of a field from the combined partial
  *
  * @param t_or_b true: use throughout/namdwidth for calculation (throughout | false: bandwidth).
  * @param avr_or_sum   use sum/avr during for the calculation (true: avr | false: sum).
+ * @param p [in] partial combined over all ranks
+ * @param percentile [in] median, 90th and 99th percentile of the field
  */
-void statistics::Compute_Rank_Metrics_Core(bool t_or_b, bool avr_or_sum)
+void statistics::Set_Rank_Metrics(bool t_or_b, bool avr_or_sum, const rank_partial &p, const double *percentile)
 {
+	iometrics *ptr0;
+	core_rank_metrics *ptr_rank_metric;
+	core_app_metrics *ptr_app_metric;
 
-	//* rank metrics: ittertate over all phases of all ranks
-	std::string field;
+	//*assign:
 	if (t_or_b)
-		field = "T";
+		ptr0 = &throughput;
 	else
-		field = "B";
+		ptr0 = &bandwidth;
 
 	if (avr_or_sum)
-		field = field + "_avr";
+	{
+		ptr_rank_metric = &ptr0->rank_metric.avr;
+		ptr_app_metric = &ptr0->app_metric.avr;
+	}
 	else
-		field = field + "_sum";
-
-	double hmean = 0;
-	double amean = 0;
-	double whmean = 0;
-	double median = 0;
-	double max = 0;
-	double min = 0;
-	double agg_max = 0;
-	long long bytes = 0;
-	double tmp = 0;
-
-	if (agg_phases != 0)
 	{
-		int N = 0;
-		min = std::numeric_limits<double>::max();
-
-		int i = 0;
-		for (int p = 0; p < procs; p++)
-		{
-			for (int j = 0; j < phases_of_ranks[p]; j++)
-			{
-				// for(int i = 0; i < agg_phases; i++){
-				tmp = all_data[i].get(field);
-				if (!isnan(tmp))
-				{
-					N++;
-					if (tmp != 0)
-					{
-						//? harmonic mean
-						hmean += 1 / tmp;
-						//? wighted harmonic mean
-						whmean += all_data[i].data / tmp;
-					}
-					//? arithmetic mean
-					amean += tmp;
-					//? bytes transferred
-					bytes += all_data[i].data;
-					//? min
-					min = (min > tmp) ? tmp : min;
-					//? max
-					max = (tmp > max) ? tmp : max;
-				}
-				i++;
-				agg_max += max;
-			}
-		}
-
-		hmean = (hmean == 0) ? 0 : N / hmean;
-		amean = (N == 0) ? 0 : amean / N;
-		whmean = (whmean == 0) ? 0 : bytes / whmean; // don't use agg_bytes as phases can be removed (see ioflags.h)
-
-//? median
-#if SKIP_LAST_WRITE > 0 || SKIP_FIRST_READ > 0 || SKIP_LAST_READ > 0 || SKIP_FIRST_WRITE > 0
-		double arr[N];
-		int counter = 0;
-		for (int i = 0; i < N; i++)
-			if (!isnan(all_data[i].get(field)))
-				arr[counter++] = all_data[i].get(field);
-		std::sort(arr, arr + counter);
-		median = (counter % 2 == 0) ? (arr[counter / 2 - 1] + arr[counter / 2]) / 2 : arr[counter / 2];
-#else
-		int *id = iohf::Sort_With_Index(all_data, N, field);
-		median = (N % 2 == 0) ? (all_data[id[N / 2 - 1]].get(field) + all_data[id[N / 2]].get(field)) / 2 : all_data[id[N / 2]].get(field);
-		free(id);
-#endif
-
-		iometrics *ptr0;
-		core_rank_metrics *ptr_rank_metric;
-		core_app_metrics *ptr_app_metric;
-
-		//*assign:
-		if (t_or_b)
-			ptr0 = &throughput;
-		else
-			ptr0 = &bandwidth;
-
-		if (avr_or_sum)
-		{
-			ptr_rank_metric = &ptr0->rank_metric.avr;
-			ptr_app_metric = &ptr0->app_metric.avr;
-		}
-		else
-		{
-			ptr_rank_metric = &ptr0->rank_metric.sum;
-			ptr_app_metric = &ptr0->app_metric.sum;
-		}
-
-		//? assign
-		ptr_rank_metric->hmean = hmean;
-		ptr_rank_metric->amean = amean;
-		ptr_rank_metric->whmean = whmean;
-		ptr_rank_metric->median = median;
-		ptr_rank_metric->max = max;
-		ptr_rank_metric->min = min;
-		ptr_app_metric->agg_max = agg_max;
+		ptr_rank_metric = &ptr0->rank_metric.sum;
+		ptr_app_metric = &ptr0->app_metric.sum;
 	}
+
+	//? assign
+	ptr_rank_metric->hmean = (p.inv == 0) ? 0 : p.n / p.inv;
+	ptr_rank_metric->amean = (p.n == 0) ? 0 : p.sum / p.n;
+	ptr_rank_metric->whmean = (p.w_inv == 0) ? 0 : p.bytes / p.w_inv; // don't use agg_bytes as phases can be removed (see ioflags.h)
+	ptr_rank_metric->median = percentile[0];
+	ptr_rank_metric->p90 = percentile[1];
+	ptr_rank_metric->p99 = percentile[2];
+	ptr_rank_metric->max = p.max;
+	ptr_rank_metric->min = p.min;
+	ptr_app_metric->agg_max = p.agg_max;
 }
 
 //! ----------------------- Time Information ------------------------------
@@ -715,42 +823,29 @@ void statistics::Compute_Rank_Metrics_Core(bool t_or_b, bool avr_or_sum)
 //*                       1. Lost_Time
 //**********************************************************************
 /**
- * @brief Calculates the real lost time by (1) finding for each I/O operation the
- * waiting time (throughtput_time - Bandwidth_time) (2) followed by aggregating the results.
+ * @brief Returns the real lost time, found by (1) finding for each I/O operation the
+ * waiting time (throughtput_time - Bandwidth_time) (2) followed by aggregating the results
+ * over all ranks (see Reduce_Phase_Info).
  *
  * @return lost time (type: double)
  */
-double statistics::Lost_Time()
+double statistics::Lost_Time() const
 {
-	double t = 0;
-	double tmp = 0;
-
-	for (int i = 0; i < agg_phases; i++)
-	{
-		tmp = (all_data[i].t_end_act - all_data[i].t_start) - (all_data[i].t_end_req - all_data[i].t_start);
-		tmp = tmp > 0 ? tmp : 0;
-		t += tmp;
-	}
-
-	return t;
+	return time_lost;
 }
 
 //**********************************************************************
 //*                       2. Total_Time
 //**********************************************************************
 /**
- * @brief Computes the aggregated time over all ranks. No input needed
+ * @brief Returns the aggregated time over all ranks (see Reduce_Phase_Info)
  *
+ * @param mode [in] "t_end_act" (default) or "t_end_req"
  * @return double
  */
-double statistics::Total_Time(std::string mode)
+double statistics::Total_Time(std::string mode) const
 {
-	double t = 0;
-
-	for (int i = 0; i < agg_phases; i++)
-		t += all_data[i].get(mode) - all_data[i].t_start;
-
-	return t;
+	return (mode == "t_end_req") ? time_req : time_act;
 }
 
 
@@ -778,7 +873,8 @@ void statistics::msgpack_pack(msgpack::packer<msgpack::sbuffer> &pk) const
 		s += "sync";
 
 	// pack the next following together in an array
-	int n = 14;
+	const io_config &cfg = ioconfig::Get();
+	int n = 14 + cfg.sketch + cfg.histogram;
 	pk.pack_array(n);
 	pk.pack(s);
 	pk.pack(flag_req);
@@ -800,6 +896,47 @@ void statistics::msgpack_pack(msgpack::packer<msgpack::sbuffer> &pk) const
 		all_data[i].msgpack_pack(pk);
     }
 
+	if (cfg.sketch)
+	{
+		// percentile tables of the individual I/O operations: {name: [count, min, max, percentiles...]}
+		const IOsketch *sketch[3] = {&sketch_b, &sketch_t, &sketch_l};
+		const char *sketch_name[3] = {"b_ind_percentiles", "t_ind_percentiles", "latency_ind_percentiles"};
+		pk.pack_map(3);
+		for (int k = 0; k < 3; k++)
+		{
+			pk.pack(std::string(sketch_name[k]));
+			pk.pack_array(3 + SKETCH_N_PERCENTILES);
+			pk.pack(sketch[k]->Count());
+			pk.pack(sketch[k]->Min());
+			pk.pack(sketch[k]->Max());
+			for (int i = 0; i < SKETCH_N_PERCENTILES; i++)
+				pk.pack(sketch[k]->Quantile(sketch_percentiles[i]));
+		}
+	}
+
+	if (cfg.histogram)
+	{
+		// request size (B) and latency (ns) histograms: {name: [[lower bound, count], ...]} of the non-empty buckets
+		const long long *count[2] = {hist.size, hist.latency};
+		const char *hist_name[2] = {"size_histogram", "latency_histogram"};
+		pk.pack_map(2);
+		for (int k = 0; k < 2; k++)
+		{
+			int buckets = 0;
+			for (int i = 0; i < IOHISTOGRAM_BINS; i++)
+				buckets += (count[k][i] != 0);
+			pk.pack(std::string(hist_name[k]));
+			pk.pack_array(buckets);
+			for (int i = 0; i < IOHISTOGRAM_BINS; i++)
+				if (count[k][i] != 0)
+				{
+					pk.pack_array(2);
+					pk.pack(IOhistogram::Lower(i));
+					pk.pack(count[k][i]);
+				}
+		}
+	}
+
 // #if ALL_SAMPLES > 4
 // 	if (flag_req){
 // 		pk.pack_array(6);
@@ -3,6 +3,8 @@
 double *computation(double *, int, int, MPI_Request &, MPI_Status &, int, MPI_File &, int, int, double);
 void write_to_file_async(int, std::string, int, int, int, int &, double *, double *, MPI_Status &, MPI_Request &, MPI_File &, int, int, MPI_Comm, double &);
 void read_from_file(std::string, int, int, int, int, int, MPI_Comm);
+void threaded_io(std::string, int, int, int);
+void clock_monotonic(int);
 
 int main(int argc, char *argv[])
 {
@@ -15,7 +17,12 @@ int main(int argc, char *argv[])
     double t_io = 0;
     std::string filename = "file";
     //! each process does these things
+#ifdef OPENMP
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided); //? several threads do I/O (see threaded_io)
+#else
     MPI_Init(&argc, &argv); //? after this, each process sees everything here private
+#endif
     int hours, minutes;
     double seconds = MPI_Wtime();
     MPI_Comm_rank(MPI_COMM_WORLD, &rank); //? each process gets its id
@@ -145,6 +152,14 @@ int main(int argc, char *argv[])
     //! read file
     read_from_file(filename, rank, mode, size, N, counter, COMM);
 
+    //! trace clock across calibrations
+    clock_monotonic(rank);
+
+#ifdef OPENMP
+    //! I/O from several threads
+    threaded_io(filename, rank, N, loops);
+#endif
+
     if (rank == 0)
     {
         seconds = MPI_Wtime() - seconds;
@@ -190,6 +205,132 @@ MPI_Finalize();
     return 0;
 }
 
+//! **************************************************************
+//! Threaded I/O function
+//! **************************************************************
+void threaded_io(std::string filename, int rank, int N, int loops)
+{
+    int provided;
+    MPI_Query_thread(&provided);
+    if (provided < MPI_THREAD_MULTIPLE)
+    {
+        if (rank == 0)
+            printf("MPI_THREAD_MULTIPLE not provided, skipping threaded I/O\n");
+        return;
+    }
+
+#ifdef OPENMP
+    int threads = 1;
+#if TMIO == 1
+    // phases and operations recorded before (index 0) and after (index 1) the threaded I/O
+    long long sw_phases[2], sw_ops[2], aw_phases[2], aw_ops[2];
+    iotrace.Count("sw", sw_phases[0], sw_ops[0]);
+    iotrace.Count("aw", aw_phases[0], aw_ops[0]);
+#endif
+#pragma omp parallel
+    {
+        int thread = omp_get_thread_num();
+#pragma omp master
+        threads = omp_get_num_threads();
+        std::vector<double> buffer(N, rank + thread);
+        std::string name = filename + "_" + std::to_string(rank) + "_" + std::to_string(thread);
+        MPI_File fh;
+        MPI_Status status;
+        MPI_Request request;
+
+        //? each thread alternates sync and async writes on its own file
+        MPI_File_open(MPI_COMM_SELF, name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY | MPI_MODE_DELETE_ON_CLOSE, MPI_INFO_NULL, &fh);
+        for (int i = 0; i < loops; i++)
+        {
+            MPI_File_write_at(fh, (MPI_Offset)(2 * i) * N * sizeof(double), buffer.data(), N, MPI_DOUBLE, &status);
+            MPI_File_iwrite_at(fh, (MPI_Offset)(2 * i + 1) * N * sizeof(double), buffer.data(), N, MPI_DOUBLE, &request);
+            MPI_Wait(&request, &status);
+        }
+        MPI_File_close(&fh);
+    }
+    if (rank == 0)
+        printf("threaded I/O done with %i threads\n", threads);
+
+#if TMIO == 1
+    //? all records of the threads must be replayed: each thread did loops sync and loops async writes
+    iotrace.Count("sw", sw_phases[1], sw_ops[1]);
+    iotrace.Count("aw", aw_phases[1], aw_ops[1]);
+    long long n = (long long)threads * loops;
+    long long n_sw = sw_ops[1] - sw_ops[0];
+    long long n_aw = aw_ops[1] - aw_ops[0];
+    long long p_sw = sw_phases[1] - sw_phases[0];
+    long long p_aw = aw_phases[1] - aw_phases[0];
+    bool ok = (n_sw == n) && (n_aw == n) && (p_aw >= 1) && (p_aw <= n);
+    if (ioconfig::Get().sync_mode == 0)
+        ok = ok && (p_sw == n);
+    else
+        ok = ok && (p_sw >= 1) && (p_sw <= n);
+    if (!ok)
+    {
+        printf("Error: rank %i replayed %lli/%lli sync ops in %lli phases and %lli/%lli async ops in %lli phases\n", rank, n_sw, n, p_sw, n_aw, n, p_aw);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    if (rank == 0)
+        printf("threaded I/O replayed: %lli sync ops in %lli phases, %lli async ops in %lli phases\n", n_sw, p_sw, n_aw, p_aw);
+
+    //? the records of the threads are replayed in time order: an async phase only starts once all requests of the
+    //? previous one ended, and the sync phases start in time order
+    std::vector<collect> aw, sw;
+    iotrace.Phases("aw", aw);
+    iotrace.Phases("sw", sw);
+    for (size_t i = aw_phases[0] + 1; i < aw.size(); i++)
+        if (aw[i].t_start < aw[i - 1].t_end_req || aw[i].t_start < aw[i - 1].t_end_act)
+        {
+            printf("Error: rank %i async phase %zu starts at %.9f s before phase %zu ended (req %.9f s, act %.9f s)\n", rank, i, aw[i].t_start, i - 1, aw[i - 1].t_end_req, aw[i - 1].t_end_act);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    for (size_t i = sw_phases[0] + 1; i < sw.size(); i++)
+        if (sw[i].t_start < sw[i - 1].t_start)
+        {
+            printf("Error: rank %i sync phase %zu starts at %.9f s before phase %zu (%.9f s)\n", rank, i, sw[i].t_start, i - 1, sw[i - 1].t_start);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    if (rank == 0)
+        printf("threaded I/O phases in time order\n");
+#endif
+#endif
+}
+
+//! **************************************************************
+//! Trace clock
+//! **************************************************************
+void clock_monotonic(int rank)
+{
+#if TMIO == 1
+    //? the trace clock is recalibrated at every summary: it may change its rate, but never go back or step away
+    IOclock clock;
+    clock.Calibrate();
+    double last = clock.Now();
+    double t_calibrate = MPI_Wtime() + 0.02;
+    double t_end = MPI_Wtime() + 0.2;
+    while (MPI_Wtime() < t_end)
+    {
+        if (MPI_Wtime() > t_calibrate)
+        {
+            clock.Calibrate();
+            t_calibrate += 0.02;
+        }
+        // bracketed by MPI_Wtime, as the rank may be descheduled in between
+        double w_1 = MPI_Wtime();
+        double t = clock.Now();
+        double w_2 = MPI_Wtime();
+        if (t < last || t < w_1 - 1e-3 || t > w_2 + 1e-3)
+        {
+            printf("Error: rank %i trace clock went from %.9f to %.9f s (MPI_Wtime %.9f to %.9f s)\n", rank, last, t, w_1, w_2);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        last = t;
+    }
+    if (rank == 0)
+        printf("trace clock monotonic across calibrations (drift %e s)\n", clock.Drift());
+#endif
+}
+
 //! **************************************************************
 //! Read function
 //! **************************************************************
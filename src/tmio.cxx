@@ -20,7 +20,13 @@ IOtrace iotrace;
 int MPI_Init(int *argc, char ***argv)
 {	
 	Function_Debug(__PRETTY_FUNCTION__);
+#if ASYNC_FLUSH == 1
+	// the flush thread calls MPI concurrently to the application
+	int provided;
+	int result = PMPI_Init_thread(argc, argv, MPI_THREAD_MULTIPLE, &provided);
+#else
 	int result = PMPI_Init(argc, argv);
+#endif
 	iotrace.Init();
 	return result;
 }
@@ -31,8 +37,14 @@ int MPI_Init(int *argc, char ***argv)
 int MPI_Init_thread(int *argc, char ***argv, int required, int *provided)
 {
 	Function_Debug(__PRETTY_FUNCTION__);
+#if ASYNC_FLUSH == 1
+	// the flush thread calls MPI concurrently to the application. Only threads of the application record per thread
+	int result = PMPI_Init_thread(argc, argv, MPI_THREAD_MULTIPLE, provided);
+	iotrace.Init(required == MPI_THREAD_MULTIPLE && *provided == MPI_THREAD_MULTIPLE);
+#else
 	int result = PMPI_Init_thread(argc, argv, required, provided);
-	iotrace.Init();
+	iotrace.Init(*provided == MPI_THREAD_MULTIPLE);
+#endif
 	return result;
 }
 //**********************************************************************
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <cstdlib>
+#include <mpi.h>
+#include "iodata.h"
+
+/**
+ * Benchmark: cost of recording an async I/O operation (Phase_Start, Phase_End_Req and Phase_End_Act) in an IOdata
+ * object, in phases of 64 operations. Run it with different TMIO_* variables (see ioconfig.h) to compare the
+ * recorders selected at runtime, e.g. the defaults against TMIO_ALL_SAMPLES=2 TMIO_SKETCH=0 TMIO_HISTOGRAM=0.
+ *
+ * usage: ./bench_config [N] [repetitions]
+ */
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+	long long n = (argc > 1) ? atoll(argv[1]) : 1'000'000;
+	int repetitions = (argc > 2) ? atoi(argv[2]) : 5;
+	const int ops_per_phase = 64;
+
+	IOdata d;
+	d.Mode(0, 1);
+	double best = 1e30;
+	for (int r = 0; r < repetitions; r++)
+	{
+		d.Clear_IO();
+		double t = 0;
+		double t0 = MPI_Wtime();
+		for (long long i = 0; i < n; i++)
+		{
+			bool first = (i % ops_per_phase == 0);
+			bool last = (i % ops_per_phase == ops_per_phase - 1);
+			d.Phase_Start(first, t, 4096 + (i & 1023), 0);
+			d.Phase_End_Req(4096, t, t + 1e-6);
+			d.Phase_End_Act(4096, t, t + 2e-6 + (i & 15) * 1e-7, last);
+			t += 3e-6;
+		}
+		best = std::min(best, MPI_Wtime() - t0);
+	}
+
+	const io_config &c = ioconfig::Get();
+	printf("samples %i (kept: %i) \t sketch %i \t histogram %i \t telemetry %i \t %.1f ns per operation (best of %i x %lli)\n",
+		   c.all_samples, (int)ioconfig::Samples(), c.sketch, c.histogram, c.telemetry, 1e9 * best / n, repetitions, n);
+
+	MPI_Finalize();
+	return 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <unistd.h>
+#include <mpi.h>
+#include "tmio_c.h"
+
+/**
+ * Benchmark: online mode. Every rank issues N async and N sync writes per round, computes for T ms and calls
+ * iotrace_summary() at the end of the round. Rank 0 reports the time the ranks were blocked in iotrace_summary()
+ * (mean and max over the rounds and ranks) and the total runtime. Compare the library built with ASYNC_FLUSH=0
+ * (summary on the application thread) and ASYNC_FLUSH=1 (swap and background flush). The jsonl output reports the
+ * same difference as overhead_post_runtime of io_time.
+ *
+ * usage: mpirun -np P ./bench_flush [N] [rounds] [T]
+ */
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+
+	int rank = 0;
+	int processes = 0;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &processes);
+	int n = (argc > 1) ? atoi(argv[1]) : 10'000;
+	int rounds = (argc > 2) ? atoi(argv[2]) : 10;
+	int t_compute = (argc > 3) ? atoi(argv[3]) : 200;
+	const int batch = 64;
+
+	MPI_File fh;
+	std::string name = "bench_flush_" + std::to_string(rank);
+	MPI_File_open(MPI_COMM_SELF, name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY | MPI_MODE_DELETE_ON_CLOSE, MPI_INFO_NULL, &fh);
+
+	std::vector<MPI_Request> requests(batch);
+	std::vector<double> buff(batch, rank);
+	double blocked[2] = {0, 0}; // sum and max
+	double t_run = MPI_Wtime();
+	for (int r = 0; r < rounds; r++)
+	{
+		for (int i = 0; i < n; i += batch)
+		{
+			int m = (n - i < batch) ? n - i : batch;
+			for (int j = 0; j < m; j++)
+				MPI_File_iwrite_at(fh, (MPI_Offset)(i + j) * sizeof(double), &buff[j], 1, MPI_DOUBLE, &requests[j]);
+			MPI_Waitall(m, requests.data(), MPI_STATUSES_IGNORE);
+			for (int j = 0; j < m; j++)
+				MPI_File_write_at(fh, (MPI_Offset)(n + i + j) * sizeof(double), &buff[j], 1, MPI_DOUBLE, MPI_STATUS_IGNORE);
+		}
+
+		// compute phase (the background flush runs meanwhile)
+		usleep(t_compute * 1000);
+
+		double t = MPI_Wtime();
+		iotrace_summary();
+		t = MPI_Wtime() - t;
+		blocked[0] += t;
+		blocked[1] = std::max(blocked[1], t);
+	}
+	t_run = MPI_Wtime() - t_run;
+	MPI_File_close(&fh);
+
+	double all[2];
+	MPI_Reduce(&blocked[0], &all[0], 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&blocked[1], &all[1], 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+	if (rank == 0)
+		printf("processes: %i \t ops per round: %i \t rounds: %i \t blocked in iotrace_summary: mean %.4f s, max %.4f s \t runtime: %.3f s\n",
+			   processes, 2 * n, rounds, all[0] / (processes * rounds), all[1], t_run);
+
+	MPI_Finalize();
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <cstdlib>
+#include <mpi.h>
+#include "ioprint.h"
+
+/**
+ * Benchmark: json output of a series of N values (default 10^7, like b_ind with ALL_SAMPLES=5). "string" is the
+ * former Print_Series, which appends std::to_string pieces to a growing std::string. "writer" is the current
+ * Print_Series, which formats with std::to_chars into the buffer of an IOwriter and writes the file in blocks.
+ * Both write the file N.json. The values of both files are read back and compared with the original values.
+ *
+ * usage: ./bench_json [N]
+ */
+static std::string Print_Series_String(double *ptr, int loops, double unit_scale, int n, std::string start, std::string end, bool jsonl)
+{
+	std::string s;
+	std::string out;
+	out.append(",");
+	if (jsonl == false)
+		out.append("\n\t\t");
+	out.append(start);
+	for (int i = 0; i < loops; i++)
+	{
+		if (i % n == 0 && jsonl == false)
+			out.append("\n\t\t\t");
+
+		s = isnan(*(ptr + i)) ? "NaN" : std::to_string(*(ptr + i) * unit_scale);
+
+		if (i == loops - 1)
+			out.append(" " + s);
+		else
+			out.append(" " + s + ",");
+	}
+	out.append(end);
+	return out;
+}
+
+// reads the values back and returns the largest relative difference (-1 if the number of values differs)
+static double Read_Back(const char *name, const double *v, int n)
+{
+	FILE *f = fopen(name, "r");
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	char *text = (char *)malloc(size + 1);
+	size = fread(text, 1, size, f);
+	text[size] = '\0';
+	fclose(f);
+
+	double d = 0;
+	int i = 0;
+	char *p = strchr(text, '[') + 1;
+	while (i < n)
+	{
+		char *e;
+		double x = strtod(p, &e);
+		if (e == p)
+			break;
+		if (x != v[i])
+			d = std::max(d, fabs(x - v[i]) / fabs(v[i]));
+		i++;
+		p = e + 1;
+	}
+	free(text);
+	return (i == n) ? d : -1;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+	int n = (argc > 1) ? atoi(argv[1]) : 10'000'000;
+
+	srand(0);
+	double *v = (double *)malloc(sizeof(double) * n);
+	for (int i = 0; i < n; i++)
+		v[i] = 1e9 * rand() / RAND_MAX;
+
+	double t_string = MPI_Wtime();
+	{
+		std::ofstream file("string.json");
+		std::string print = Print_Series_String(v, n, 1, 5, "\"b_ind\": [", "]", false);
+		file << print;
+		file.close();
+	}
+	t_string = MPI_Wtime() - t_string;
+
+	double t_writer = MPI_Wtime();
+	{
+		IOwriter file("writer.json");
+		ioprint::Print_Series(file, v, n, 1, 5, "\"b_ind\": [", "]", false);
+	}
+	t_writer = MPI_Wtime() - t_writer;
+
+	printf("values: %i \t string: %.4f s \t writer: %.4f s \t speedup: %.2f\n", n, t_string, t_writer, t_string / t_writer);
+	printf("max rel. diff after reading back \t string: %.1e \t writer: %.1e\n", Read_Back("string.json", v, n), Read_Back("writer.json", v, n));
+
+	free(v);
+	MPI_Finalize();
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <cstdlib>
+#include <sys/resource.h>
+#include <mpi.h>
+#include "statistics.h"
+
+/**
+ * Benchmark: overlap calculation of rank 0 (statistics::Compute, i.e. Overlap and Phase_Bandwidth for
+ * throughput and bandwidth) on synthetic phases. Every rank has 10 phases. All ranks write during the same
+ * phase with a small jitter, so every rank overlaps with all other ranks. The number of phases (agg_phases)
+ * is scaled from 10^3 to N. Reports the time and the growth of the peak resident memory.
+ *
+ * usage: ./bench_overlap [N]
+ */
+static long Peak_Kb(void)
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+	long long n_max = (argc > 1) ? atoll(argv[1]) : 10'000'000;
+	const int phases = 10;
+
+	srand(0);
+	for (long long n = 1000; n <= n_max; n *= 10)
+	{
+		int ranks = n / phases;
+		collect *data = (collect *)malloc(sizeof(collect) * n);
+		int *phases_of_ranks = (int *)malloc(sizeof(int) * ranks);
+		for (int r = 0; r < ranks; r++)
+		{
+			phases_of_ranks[r] = phases;
+			for (int j = 0; j < phases; j++)
+			{
+				collect &c = data[r * phases + j];
+				c.data = 1'000'000;
+				c.n_op = 10;
+				c.t_start = 10.0 * j + 0.1 * rand() / RAND_MAX;
+				c.t_end_req = c.t_start + 4 + 0.1 * rand() / RAND_MAX;
+				c.t_end_act = c.t_end_req + 0.1 * rand() / RAND_MAX;
+				c.B_sum = c.data / (c.t_end_req - c.t_start);
+				c.B_avr = c.B_sum;
+				c.T_sum = c.data / (c.t_end_act - c.t_start);
+				c.T_avr = c.T_sum;
+			}
+		}
+
+		long peak_before = Peak_Kb();
+		double t = MPI_Wtime();
+		{
+			// owns data and phases_of_ranks
+			statistics s(data, phases_of_ranks, 0, ranks, true, true);
+			s.agg_phases = n;
+			s.procs_io = ranks;
+			s.Compute();
+		}
+		t = MPI_Wtime() - t;
+		printf("agg_phases: %lli \t ranks: %i \t overlap: %.4f s \t peak memory: %li KB (+%li KB during overlap)\n", n, ranks, t, Peak_Kb(), Peak_Kb() - peak_before);
+	}
+
+	MPI_Finalize();
+	return 0;
+}
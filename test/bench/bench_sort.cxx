@@ -0,0 +1,79 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <mpi.h>
+#include "hfunctions.h"
+
+/**
+ * Benchmark: iohf::Sort_With_Index over N collects (default 10^6). "string" is the former comparator, which
+ * selects the field by name (collect::get(std::string)) at every comparison. "field" is the current
+ * Sort_With_Index, which selects the field once (collect_field) and radix sorts the extracted keys. The
+ * second line compares the radix sort of a double array (Overlap) with std::stable_sort. All results are compared.
+ * Build the library with "make openmp_library" to sort in parallel (OMP_NUM_THREADS).
+ *
+ * usage: ./bench_sort [N]
+ */
+static int *Sort_With_Index_String(collect *all_data, int N, std::string mode)
+{
+	int *id = (int *)malloc(N * sizeof(int));
+	for (int i = 0; i < N; i++)
+		id[i] = i;
+
+	std::stable_sort(id, id + N, [all_data, mode](int i, int j)
+					 { return all_data[i].get(mode) < all_data[j].get(mode); });
+
+	return id;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+	int n = (argc > 1) ? atoi(argv[1]) : 1'000'000;
+
+	srand(0);
+	collect *data = new collect[n];
+	for (int i = 0; i < n; i++)
+	{
+		data[i].t_start = 100.0 * rand() / RAND_MAX;
+		data[i].t_end_act = data[i].t_start + 1.0 * rand() / RAND_MAX;
+	}
+
+	double t_string = MPI_Wtime();
+	int *id_string = Sort_With_Index_String(data, n, "t_end_act");
+	t_string = MPI_Wtime() - t_string;
+
+	double t_field = MPI_Wtime();
+	int *id_field = iohf::Sort_With_Index(data, n, FIELD_T_END_ACT);
+	t_field = MPI_Wtime() - t_field;
+
+	bool same = std::equal(id_string, id_string + n, id_field);
+	printf("collects: %i \t string: %.4f s \t field: %.4f s \t speedup: %.2f \t same order: %s\n", n, t_string, t_field, t_string / t_field, same ? "yes" : "no");
+
+	double *v = (double *)malloc(n * sizeof(double));
+	for (int i = 0; i < n; i++)
+		v[i] = data[i].t_end_act;
+
+	double t_stable = MPI_Wtime();
+	int *id_stable = (int *)malloc(n * sizeof(int));
+	for (int i = 0; i < n; i++)
+		id_stable[i] = i;
+	std::stable_sort(id_stable, id_stable + n, [v](int i, int j)
+					 { return v[i] < v[j]; });
+	t_stable = MPI_Wtime() - t_stable;
+
+	double t_radix = MPI_Wtime();
+	int *id_radix = iohf::Sort_With_Index(v, n);
+	t_radix = MPI_Wtime() - t_radix;
+
+	same = std::equal(id_stable, id_stable + n, id_radix) && std::equal(id_stable, id_stable + n, id_field);
+	printf("doubles : %i \t stable: %.4f s \t radix: %.4f s \t speedup: %.2f \t same order: %s\n", n, t_stable, t_radix, t_stable / t_radix, same ? "yes" : "no");
+
+	free(v);
+	free(id_stable);
+	free(id_radix);
+	free(id_string);
+	free(id_field);
+	delete[] data;
+	MPI_Finalize();
+	return 0;
+}
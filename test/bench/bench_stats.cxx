@@ -0,0 +1,130 @@
+#include <iostream>
+#include <cstdlib>
+#include <mpi.h>
+#include "hfunctions.h"
+
+/**
+ * Benchmark: statistics of a buffer of N values (default 10^6, 1% NaN and 1% zeros). "passes" are the former
+ * scalar iohf functions (one pass with per-element branches each for the arithmetic mean, harmonic mean, harmonic
+ * mean of non-zero values, min, max and variance). "fused" computes all of them in one pass with the kernels of
+ * iokernels.h, for every instruction set supported by the CPU. The largest relative difference is reported.
+ *
+ * usage: ./bench_stats [N] [repetitions]
+ */
+struct stats
+{
+	double amean, hmean, hmean_nz, min, max, var;
+};
+
+static void Passes(double *v, int n, stats &s)
+{
+	int N = 0;
+	s.amean = 0;
+	for (int i = 0; i < n; i++)
+		if (!isnan(v[i]))
+		{
+			s.amean += v[i];
+			N++;
+		}
+	s.amean /= N;
+
+	N = 0;
+	s.hmean = 0;
+	for (int i = 0; i < n; i++)
+		if (!isnan(v[i]))
+		{
+			s.hmean += 1 / v[i];
+			N++;
+		}
+	s.hmean = N / s.hmean;
+
+	N = 0;
+	s.hmean_nz = 0;
+	for (int i = 0; i < n; i++)
+		if (!isnan(v[i]) && v[i] != 0)
+		{
+			s.hmean_nz += 1 / v[i];
+			N++;
+		}
+	s.hmean_nz = N / s.hmean_nz;
+
+	s.min = std::numeric_limits<double>::max();
+	for (int i = 0; i < n; i++)
+		if (!isnan(v[i]) && s.min > v[i])
+			s.min = v[i];
+
+	s.max = 0;
+	for (int i = 0; i < n; i++)
+		if (!isnan(v[i]) && s.max < v[i])
+			s.max = v[i];
+
+	s.var = 0;
+	for (int i = 0; i < n; i++)
+		if (!isnan(v[i]))
+			s.var += pow(v[i] - s.amean, 2);
+	s.var /= n;
+}
+
+static void Fused(const io_kernels &k, double *v, int n, stats &s)
+{
+	io_moments m;
+	k.moments(v, NULL, n, v[0], m);
+	s.amean = m.sum / m.n;
+	s.hmean = (m.n_zero > 0) ? 0 : m.n / m.inv;
+	s.hmean_nz = (m.n - m.n_zero) / m.inv;
+	s.min = m.min;
+	s.max = m.max;
+	s.var = (m.dev2 - m.dev * m.dev / m.n) / n;
+}
+
+static double Diff(const stats &a, const stats &b)
+{
+	double x[6] = {a.amean, a.hmean, a.hmean_nz, a.min, a.max, a.var};
+	double y[6] = {b.amean, b.hmean, b.hmean_nz, b.min, b.max, b.var};
+	double d = 0;
+	for (int i = 0; i < 6; i++)
+		if (x[i] != y[i])
+			d = std::max(d, fabs(x[i] - y[i]) / fabs(x[i]));
+	return d;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+	int n = (argc > 1) ? atoi(argv[1]) : 1'000'000;
+	int r = (argc > 2) ? atoi(argv[2]) : 100;
+
+	srand(0);
+	double *v = (double *)malloc(sizeof(double) * n);
+	for (int i = 0; i < n; i++)
+	{
+		int c = rand() % 100;
+		v[i] = (c == 0) ? NAN : (c == 1) ? 0 : 1e9 * rand() / RAND_MAX;
+	}
+	v[0] = 1e8;
+
+	stats ref;
+	double t_passes = MPI_Wtime();
+	for (int i = 0; i < r; i++)
+		Passes(v, n, ref);
+	t_passes = MPI_Wtime() - t_passes;
+	printf("values: %i \t repetitions: %i \t passes: %.4f s\n", n, r, t_passes);
+
+	iokernels::level levels[3] = {iokernels::SCALAR, iokernels::AVX2, iokernels::AVX512};
+	for (int l = 0; l < 3; l++)
+	{
+		const io_kernels *k = iokernels::Get(levels[l]);
+		if (k == NULL)
+			continue;
+		stats s;
+		double t = MPI_Wtime();
+		for (int i = 0; i < r; i++)
+			Fused(*k, v, n, s);
+		t = MPI_Wtime() - t;
+		printf("fused %-7s: %.4f s \t speedup: %5.2f \t max rel. diff: %.1e%s\n", k->name, t, t_passes / t, Diff(ref, s), (k == &iokernels::Get()) ? " \t (selected)" : "");
+	}
+
+	free(v);
+	MPI_Finalize();
+	return 0;
+}
@@ -0,0 +1,61 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <sys/resource.h>
+#include <mpi.h>
+
+/**
+ * Benchmark: every rank issues N async writes (waited in batches of 64) and N sync writes, then calls
+ * MPI_Finalize, which runs IOtrace::Summary. Rank 0 reports the time spent in MPI_Finalize and the growth
+ * of its peak resident memory during it. Run with increasing process counts and compare the library built
+ * with GATHER_MODE=0 (flat gather) and GATHER_MODE=1 (node leaders).
+ *
+ * usage: mpirun -np P ./bench_summary [N]
+ */
+static long Peak_Kb(void)
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+
+	int rank = 0;
+	int processes = 0;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &processes);
+	int n = (argc > 1) ? atoi(argv[1]) : 10'000;
+	const int batch = 64;
+
+	MPI_File fh;
+	std::string name = "bench_summary_" + std::to_string(rank);
+	MPI_File_open(MPI_COMM_SELF, name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY | MPI_MODE_DELETE_ON_CLOSE, MPI_INFO_NULL, &fh);
+
+	std::vector<MPI_Request> requests(batch);
+	std::vector<double> buff(batch, rank);
+	for (int i = 0; i < n; i += batch)
+	{
+		int m = (n - i < batch) ? n - i : batch;
+		for (int j = 0; j < m; j++)
+			MPI_File_iwrite_at(fh, (MPI_Offset)(i + j) * sizeof(double), &buff[j], 1, MPI_DOUBLE, &requests[j]);
+		MPI_Waitall(m, requests.data(), MPI_STATUSES_IGNORE);
+		for (int j = 0; j < m; j++)
+			MPI_File_write_at(fh, (MPI_Offset)(n + i + j) * sizeof(double), &buff[j], 1, MPI_DOUBLE, MPI_STATUS_IGNORE);
+	}
+	MPI_File_close(&fh);
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	long peak_before = Peak_Kb();
+	double t_summary = MPI_Wtime();
+	MPI_Finalize();
+	t_summary = MPI_Wtime() - t_summary;
+
+	if (rank == 0)
+		printf("processes: %i \t ops per rank: %i \t summary: %.4f s \t rank 0 peak memory: %li KB (+%li KB during summary)\n", processes, 2 * n, t_summary, Peak_Kb(), Peak_Kb() - peak_before);
+
+	return 0;
+}
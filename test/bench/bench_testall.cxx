@@ -0,0 +1,50 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <mpi.h>
+
+/**
+ * Benchmark: drains N outstanding async writes through a single MPI_Testall.
+ * Every completed request runs Check_Request_Write and Act_Done in TMIO, so the
+ * drain time shows the cost of request lookup and phase end detection.
+ *
+ * usage: mpirun -np 1 ./bench_testall [N]
+ */
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+
+	int rank = 0;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	int n = (argc > 1) ? atoi(argv[1]) : 100'000;
+
+	MPI_File fh;
+	std::string name = "bench_testall_" + std::to_string(rank);
+	MPI_File_open(MPI_COMM_SELF, name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY | MPI_MODE_DELETE_ON_CLOSE, MPI_INFO_NULL, &fh);
+
+	std::vector<MPI_Request> requests(n);
+	std::vector<double> buff(n, rank);
+
+	double t_issue = MPI_Wtime();
+	for (int i = 0; i < n; i++)
+		MPI_File_iwrite_at(fh, (MPI_Offset)i * sizeof(double), &buff[i], 1, MPI_DOUBLE, &requests[i]);
+	t_issue = MPI_Wtime() - t_issue;
+
+	int flag = 0;
+	long polls = 0;
+	double t_drain = MPI_Wtime();
+	while (!flag)
+	{
+		MPI_Testall(n, requests.data(), &flag, MPI_STATUSES_IGNORE);
+		polls++;
+	}
+	t_drain = MPI_Wtime() - t_drain;
+
+	MPI_File_close(&fh);
+
+	if (rank == 0)
+		printf("requests: %i \t issue: %.4f s \t drain: %.4f s (%li polls) \t per request: %.3e s\n", n, t_issue, t_drain, polls, t_drain / n);
+
+	MPI_Finalize();
+	return 0;
+}
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <cstdlib>
+#include <mpi.h>
+#include "ioprint.h"
+
+/**
+ * Round-trip test of the columnar binary format (FILE_FORMAT 1): the statistics of synthetic phases are written
+ * with ioprint::Format_Columns and IOcolumns::Write, mapped with IOcolumns_reader and compared value by value.
+ * Also checks empty and padded columns, more columns than IOV_MAX and that a truncated file is rejected.
+ * With several MPI ranks, the rank columns written collectively with IOcolumns::Write_All (PARALLEL_OUTPUT) are
+ * checked as well.
+ *
+ * usage: mpirun -np <n> ./test_columns [ranks]
+ */
+static int failed = 0;
+
+static void Check(bool ok, const char *what)
+{
+	if (!ok)
+	{
+		printf("failed: %s\n", what);
+		failed++;
+	}
+}
+
+// compares a column with the expected values (bitwise, so NaN == NaN)
+template <class T>
+static void Check_Column(const IOcolumns_reader &r, const std::string &name, const T *expected, uint64_t n)
+{
+	uint64_t count = 0;
+	const T *v = r.Column<T>(name.c_str(), &count);
+	Check(v != NULL || n == 0, name.c_str());
+	if (v == NULL)
+		return;
+	Check(count == n && (n == 0 || memcmp(v, expected, n * sizeof(T)) == 0), name.c_str());
+}
+
+// rank r contributes r values (rank 0 none) to "rank/t" and 2 values to "rank/id"
+static void Check_Write_All(const char *file)
+{
+	int rank, procs;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &procs);
+	{
+		IOcolumns columns;
+		if (rank == 0)
+			columns.Add(std::string("global/procs"), procs);
+		double *t = columns.Rank_Column<double>("rank/t", rank);
+		for (int i = 0; i < rank; i++)
+			t[i] = rank + 0.001 * i;
+		int *id = columns.Rank_Column<int>("rank/id", 2);
+		id[0] = id[1] = rank;
+		Check(columns.Write_All(file, MPI_COMM_WORLD), "write_all");
+	}
+	if (rank == 0)
+	{
+		IOcolumns_reader r(file);
+		Check(r.Is_Open(), "open shared file");
+		std::vector<double> t;
+		std::vector<long long> t_per_rank, id_per_rank;
+		std::vector<int> id;
+		for (int p = 0; p < procs; p++)
+		{
+			for (int i = 0; i < p; i++)
+				t.push_back(p + 0.001 * i);
+			id.push_back(p);
+			id.push_back(p);
+			t_per_rank.push_back(p);
+			id_per_rank.push_back(2);
+		}
+		Check_Column(r, "global/procs", &procs, 1);
+		Check_Column(r, "rank/t", t.data(), t.size());
+		Check_Column(r, "rank/id", id.data(), id.size());
+		Check_Column(r, "rank/t_per_rank", t_per_rank.data(), procs);
+		Check_Column(r, "rank/id_per_rank", id_per_rank.data(), procs);
+		remove(file);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	MPI_Init(&argc, &argv);
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	Check_Write_All("test_columns_all.bin");
+	if (rank != 0)
+	{
+		MPI_Finalize();
+		return 0;
+	}
+	int ranks = (argc > 1) ? atoi(argv[1]) : 100;
+	const int phases = 10;
+	const char *file = "test_columns.bin";
+
+	srand(0);
+	int n = ranks * phases;
+	collect *data = (collect *)malloc(sizeof(collect) * n);
+	int *phases_of_ranks = (int *)malloc(sizeof(int) * ranks);
+	for (int r = 0; r < ranks; r++)
+	{
+		phases_of_ranks[r] = phases;
+		for (int j = 0; j < phases; j++)
+		{
+			collect &c = data[r * phases + j];
+			c.data = 1000 + rand();
+			c.n_op = 1 + rand() % 10;
+			c.t_start = 10.0 * j + 0.1 * rand() / RAND_MAX;
+			c.t_end_req = c.t_start + 4 + 0.1 * rand() / RAND_MAX;
+			c.t_end_act = c.t_end_req + 0.1 * rand() / RAND_MAX;
+			c.B_sum = c.data / (c.t_end_req - c.t_start);
+			c.B_avr = c.B_sum / c.n_op;
+			c.T_sum = c.data / (c.t_end_act - c.t_start);
+			c.T_avr = c.T_sum / c.n_op;
+		}
+	}
+	data[3].T_avr = NAN;
+
+	statistics s(data, phases_of_ranks, 0, ranks, true, true);
+	s.agg_phases = n;
+	s.procs_io = ranks;
+	s.max_phases = phases;
+	s.agg_bytes = 123456789012345LL;
+	s.Compute();
+	for (int i = 0; i < 1000; i++)
+		s.hist.Add(i * 4096, i * 1e-6);
+
+	{
+		IOcolumns columns;
+		ioprint::Format_Columns(columns, s, "write_async_t", false);
+		ioprint::Format_Columns(columns, s, "write_async_b", true);
+
+		// edge cases: empty column, int column with odd count (padding), more columns than IOV_MAX
+		int odd[3] = {1, 2, 3};
+		columns.Add(std::string("test/empty"), (double *)NULL, 0);
+		columns.Add(std::string("test/odd"), odd, 3);
+		for (int i = 0; i < 1500; i++)
+			columns.Add("test/scalar_" + std::to_string(i), (long long)i);
+		Check(columns.Write(file), "write");
+	}
+
+	{
+		IOcolumns_reader r(file);
+		Check(r.Is_Open(), "open");
+
+		for (int f = 0; f < FIELD_NONE; f++)
+		{
+			double collect::*member = collect::Member((collect_field)f);
+			std::vector<double> expected(n);
+			for (int i = 0; i < n; i++)
+				expected[i] = data[i].*member;
+			Check_Column(r, std::string("write_async_t/phase/") + collect::Name((collect_field)f), expected.data(), n);
+		}
+		std::vector<long long> bytes(n);
+		std::vector<int> ops(n);
+		for (int i = 0; i < n; i++)
+		{
+			bytes[i] = data[i].data;
+			ops[i] = data[i].n_op;
+		}
+		Check_Column(r, "write_async_t/phase/data", bytes.data(), n);
+		Check_Column(r, "write_async_t/phase/n_op", ops.data(), n);
+		Check_Column(r, "write_async_t/phase/phases_of_ranks", phases_of_ranks, ranks);
+		Check(r.Find("write_async_b/phase/data") == NULL, "phases only for the actual mode");
+
+		Check_Column(r, "write_async_t/total_bytes", &s.agg_bytes, 1);
+		Check_Column(r, "write_async_t/total_io_phases", &s.agg_phases, 1);
+		Check_Column(r, "write_async_t/bandwidth/median", &s.throughput.rank_metric.avr.median, 1);
+		Check_Column(r, "write_async_b/bandwidth/median", &s.bandwidth.rank_metric.sum.median, 1);
+		Check(r.Column<long long>("write_async_t/bandwidth/median") == NULL, "type check");
+#if HISTOGRAM == 1
+		Check_Column(r, "write_async_t/bandwidth/size_histogram", s.hist.size, IOHISTOGRAM_BINS);
+#endif
+#if ALL_SAMPLES > 0 && DO_CALC > 0
+		Check_Column(r, "write_async_t/bandwidth/b_overlap_sum", s.throughput_sum_phase.get(), s.overlap_act.Size());
+		Check_Column(r, "write_async_b/bandwidth/n_overlap", s.n_overlap_req.get(), s.overlap_req.Size());
+#endif
+
+		int odd[3] = {1, 2, 3};
+		Check_Column(r, "test/empty", (double *)NULL, 0);
+		Check_Column(r, "test/odd", odd, 3);
+		for (int i = 0; i < 1500; i += 100)
+		{
+			long long v = i;
+			Check_Column(r, "test/scalar_" + std::to_string(i), &v, 1);
+		}
+		for (uint32_t i = 0; i < r.Size(); i++)
+			Check(r.Entry(i).offset % 8 == 0, "alignment");
+		printf("columns: %u \t size: %lu B\n", r.Size(), (unsigned long)r.Header().size);
+	}
+
+	// a truncated file is rejected
+	Check(truncate(file, 1000) == 0, "truncate");
+	{
+		IOcolumns_reader r(file);
+		Check(!r.Is_Open(), "truncated file rejected");
+	}
+	remove(file);
+
+	printf("%s\n", failed ? "test_columns: FAILED" : "test_columns: passed");
+	MPI_Finalize();
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "iotelemetry_reader.h"
+#include "ioflags.h"
+
+/**
+ * Node-local monitor: samples the telemetry segment of a traced run (TMIO_TELEMETRY=1 or TELEMETRY=1) and prints,
+ * for every local rank and mode, the bytes, operations and phases so far, the state of the current phase and the
+ * last throughput. Only uses the header-only reader (no MPI, no TMIO library).
+ *
+ * usage: ./monitor [name] [Hz] [seconds]   (default: TELEMETRY_NAME 10 30)
+ * %u and %j of the name are expanded as in the traced run, so the default only finds the segment if the monitor runs
+ * in the same job. Otherwise, pass the expanded name, e.g. /tmio_telemetry.1000.4711
+ */
+int main(int argc, char *argv[])
+{
+	std::string name = io_telemetry_name((argc > 1) ? argv[1] : TELEMETRY_NAME);
+	double hz = (argc > 2) ? atof(argv[2]) : 10;
+	double seconds = (argc > 3) ? atof(argv[3]) : 30;
+
+	IOtelemetry_reader r;
+	struct timespec pause = {0, (long)(1e9 / hz)};
+	if (pause.tv_nsec >= 1'000'000'000)
+	{
+		pause.tv_sec = pause.tv_nsec / 1'000'000'000;
+		pause.tv_nsec %= 1'000'000'000;
+	}
+
+	long long rounds = (long long)(hz * seconds);
+	for (long long k = 0; k < rounds; k++, nanosleep(&pause, NULL))
+	{
+		// the segment appears once the traced run called MPI_Init and disappears at MPI_Finalize
+		if (!r.Is_Open() && !r.Open(name.c_str()))
+			continue;
+
+		for (int i = 0; i < r.Slots(); i++)
+		{
+			io_telemetry_state s;
+			if (!r.Read(i, s) || s.rank < 0)
+				continue;
+			for (int m = 0; m < IO_TELEMETRY_MODES; m++)
+			{
+				const io_telemetry_mode &d = s.mode[m];
+				if (d.ops == 0)
+					continue;
+				printf("%8.3f s  rank %4i  %-11s  %.3e B  %8lli ops  %6lli phases  %s  phase: %.3e B in %5lli ops  T: %.3e B/s\n",
+					   s.t_update, s.rank, io_telemetry_modes[m], (double)d.bytes, d.ops, d.phases, d.in_phase ? "active" : "idle  ",
+					   (double)d.phase.data, d.phase.n_op, d.t_last);
+			}
+		}
+		fflush(stdout);
+	}
+	return 0;
+}
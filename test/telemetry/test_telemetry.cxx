@@ -0,0 +1,129 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include "iotelemetry.h"
+
+/**
+ * Test of the telemetry segment: a writer thread publishes operations and phases with IOtelemetry while a reader
+ * thread samples the slots with IOtelemetry_reader as fast as it can. Every published state satisfies
+ * data = 100 * n_op and bytes = 100 * ops, so a torn copy is detected. The completed phases fetched with
+ * \e Phases have to be consecutive (apart from phases overwritten in the ring). Reports the cost of an update
+ * with and without a concurrent reader and the sampling rate of the reader.
+ *
+ * usage: ./test_telemetry [updates]
+ */
+static int failed = 0;
+
+static void Check(bool ok, const char *what)
+{
+	if (!ok)
+	{
+		printf("failed: %s\n", what);
+		failed++;
+	}
+}
+
+static const char *name = "/tmio_test_telemetry";
+static const int ops_per_phase = 10;
+
+// n operations in phases of ops_per_phase operations, starting at time t. Returns the time per update in ns
+static double Write(IOtelemetry &w, long long n, double t)
+{
+	io_telemetry_phase p = {};
+	auto t0 = std::chrono::steady_clock::now();
+	for (long long i = 0; i < n; i++)
+	{
+		bool first = (i % ops_per_phase == 0);
+		if (first)
+		{
+			p = {};
+			p.t_start = t + i;
+		}
+		p.data += 100;
+		p.n_op++;
+		w.Start(0, p, 100, first, t + i);
+		p.T_sum += 1;
+		w.Sample(0, p, NAN, 1, t + i);
+		if (i % ops_per_phase == ops_per_phase - 1)
+		{
+			p.t_end_act = t + i;
+			w.Complete(0, p, t + i);
+		}
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(t1 - t0).count() / (3 * n);
+}
+
+int main(int argc, char *argv[])
+{
+	long long n = (argc > 1) ? atoll(argv[1]) : 1'000'000;
+
+	IOtelemetry w;
+	Check(w.Create(name, 2), "create");
+	Check(w.Attach(name, 1, 7, 0), "attach");
+	IOtelemetry other;
+	Check(!other.Create(name, 2), "existing segment is kept");
+	setenv("SLURM_JOB_ID", "4711", 1);
+	Check(io_telemetry_name("/a.%u.%j/b") == "/a." + std::to_string(getuid()) + ".4711_b", "name expansion");
+
+	IOtelemetry_reader r;
+	Check(r.Open(name), "open");
+	Check(r.Slots() == 2, "slots");
+	io_telemetry_state s;
+	Check(r.Read(0, s) && s.rank == -1, "unused slot");
+	Check(r.Read(1, s) && s.rank == 7 && s.pid == getpid(), "claimed slot");
+
+	double alone = Write(w, n, 0);
+
+	// concurrent reader
+	std::atomic<bool> done(false);
+	long long samples = 0, torn = 0, gaps = 0, phases = 0;
+	double rate = 0;
+	std::thread reader([&]()
+					   {
+		io_telemetry_entry ring[IO_TELEMETRY_RING];
+		uint64_t next = 0;
+		double last = -1;
+		auto t0 = std::chrono::steady_clock::now();
+		while (!done.load())
+		{
+			io_telemetry_state st;
+			if (!r.Read(1, st))
+				continue;
+			samples++;
+			const io_telemetry_mode &m = st.mode[0];
+			if (m.phase.data != 100 * m.phase.n_op || m.bytes != 100 * m.ops || m.phase.T_sum > m.phase.n_op)
+				torn++;
+
+			uint64_t before = next;
+			int k = r.Phases(1, next, ring);
+			if (k > 0 && next - k != before)
+				gaps++;
+			for (int j = 0; j < k; j++)
+			{
+				if (ring[j].phase.n_op != ops_per_phase || ring[j].phase.t_start <= last)
+					torn++;
+				last = ring[j].phase.t_start;
+				phases++;
+			}
+		}
+		rate = samples / std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count(); });
+	double shared = Write(w, n, n);
+	done = true;
+	reader.join();
+
+	Check(r.Read(1, s) && s.mode[0].ops == 2 * n && s.mode[0].phases == 2 * n / ops_per_phase, "totals");
+	Check(s.head == (uint64_t)(2 * n / ops_per_phase), "ring head");
+	Check(torn == 0, "consistent snapshots");
+	printf("update: %.1f ns (%.1f ns with reader) \t reader: %lli samples (%.2e per s), %lli phases, %lli ring overruns\n",
+		   alone, shared, samples, rate, phases, gaps);
+
+	w.Close();
+	IOtelemetry_reader gone;
+	Check(!gone.Open(name), "removed on close");
+
+	printf("%s\n", failed ? "test_telemetry: FAILED" : "test_telemetry: passed");
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <vector>
+#include <zmq.hpp>
+#include <msgpack.hpp>
+#include "iopublisher.h"
+
+/**
+ * Test of IOpublisher with a local receiver: a PULL socket binds to the endpoint, the publisher sends packed
+ * summaries and the receiver unpacks and checks them. Checks that the buffers are handed over (not copied) and that
+ * sends without receiver are dropped once PUBLISHER_HWM messages are queued, instead of blocking.
+ * Build the library with FILE_FORMAT 3 first:
+ * > cd ../../build && make zmq_library
+ *
+ * usage: ./test_publisher [endpoint] (default: inproc://tmio_test)
+ */
+static int failed = 0;
+
+static void Check(bool ok, const char *what)
+{
+	if (!ok)
+	{
+		printf("failed: %s\n", what);
+		failed++;
+	}
+}
+
+// a summary like the one of ioprint::Binary: chunk number and a series of values
+static void Pack(msgpack::sbuffer &buffer, int chunk, int n)
+{
+	msgpack::packer<msgpack::sbuffer> pk(&buffer);
+	pk.pack_map(2);
+	pk.pack("chunk");
+	pk.pack(chunk);
+	pk.pack("b_ind");
+	pk.pack_array(n);
+	for (int i = 0; i < n; i++)
+		pk.pack(chunk + 0.5 * i);
+}
+
+int main(int argc, char *argv[])
+{
+	std::string endpoint = (argc > 1) ? argv[1] : "inproc://tmio_test";
+	const int messages = 50;
+	const int n = 1000;
+
+	{
+		IOpublisher publisher;
+		// an inproc receiver needs the context of the publisher and has to bind first
+		zmq::socket_t receiver(publisher.Context(), zmq::socket_type::pull);
+		receiver.bind(endpoint);
+		Check(publisher.Connect(endpoint), "connect");
+
+		for (int i = 0; i < messages; i++)
+		{
+			msgpack::sbuffer buffer;
+			Pack(buffer, i, n);
+			Check(publisher.Send(buffer), "send");
+			Check(buffer.data() == NULL && buffer.size() == 0, "buffer handed over");
+		}
+
+		for (int i = 0; i < messages; i++)
+		{
+			zmq::message_t message;
+			if (!receiver.recv(message, zmq::recv_flags::none))
+			{
+				Check(false, "receive");
+				break;
+			}
+			msgpack::object_handle oh = msgpack::unpack((const char *)message.data(), message.size());
+			std::map<std::string, msgpack::object> summary = oh.get().as<std::map<std::string, msgpack::object>>();
+			std::vector<double> b = summary["b_ind"].as<std::vector<double>>();
+			Check(summary["chunk"].as<int>() == i, "order");
+			Check((int)b.size() == n && b[n - 1] == i + 0.5 * (n - 1), "values");
+		}
+		Check(publisher.Sent() == messages && publisher.Dropped() == 0, "sent");
+	}
+
+	// no receiver: the queue fills up to the high water mark, further sends are dropped without blocking
+	{
+		IOpublisher publisher;
+		const int hwm = 10;
+		Check(publisher.Connect("ipc:///tmp/tmio_test_no_receiver", hwm), "connect without receiver");
+		for (int i = 0; i < 10 * hwm; i++)
+		{
+			msgpack::sbuffer buffer;
+			Pack(buffer, i, 10);
+			publisher.Send(buffer);
+		}
+		Check(publisher.Dropped() > 0, "dropped");
+		Check(publisher.Sent() + publisher.Dropped() == 10 * hwm, "sent + dropped");
+		printf("without receiver: %lli sent, %lli dropped\n", publisher.Sent(), publisher.Dropped());
+	}
+
+	printf("%s\n", failed ? "test_publisher: FAILED" : "test_publisher: passed");
+	return failed ? 1 : 0;
+}